@@ -0,0 +1,203 @@
+/// @file Batch.cpp
+/// @brief worker pool for batch mode
+
+#include "Batch.h"
+#include "ClockTimer.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+ILOSTLBEGIN
+
+/// shared by the workers and the thread that prints the results
+struct BatchState {
+  const CmdLine * command_line;
+  InstanceSolver solve_instance;
+  const vector<BatchEntry> * entries;
+  unsigned threads_per_instance;
+  atomic<size_t> next_entry;
+  mutex result_mutex;
+  condition_variable result_ready;
+  vector<string> outputs;
+  vector<int> statuses;
+  vector<bool> done;
+};
+
+bool readBatchList( const string & list_file_name,
+                    vector<BatchEntry> & entries )
+{
+  ifstream list_stream( list_file_name.c_str() );
+  if ( ! list_stream ) return false;
+  string line;
+  while ( getline( list_stream, line ) ) {
+    istringstream line_stream( line );
+    BatchEntry entry;
+    if ( ! (line_stream >> entry.file_name) ) continue;
+    if ( entry.file_name[0] == '#' ) continue;
+    line_stream >> entry.upper_bound;
+    entries.push_back( entry );
+  }
+  return true;
+}
+
+string outputTagValue( const string & output, const string & tag )
+{
+  istringstream output_stream( output );
+  string line;
+  while ( getline( output_stream, line ) ) {
+    if ( line.compare( 0, tag.size(), tag ) != 0 ) continue;
+    if ( line.size() > tag.size() && line[ tag.size() ] != ' '
+         && line[ tag.size() ] != '\t' ) continue;
+    string::size_type start = line.find_first_not_of( " \t", tag.size() );
+    if ( start == string::npos ) return "";
+    string::size_type end = line.find_last_not_of( " \t\r" );
+    return line.substr( start, end - start + 1 );
+  }
+  return "";
+}
+
+bool collectBatchEntries( const CmdLine & command_line,
+                          vector<BatchEntry> & entries )
+{
+  string_list files = command_line.getFiles();
+  for ( size_t i = 1; i < files.size(); ++i ) { // files[0] is the command
+    BatchEntry entry;
+    entry.file_name = files[i];
+    entries.push_back( entry );
+  }
+  if ( ! command_line.flagPresent( "batch" ) ) return true;
+  string list_file_name = command_line.stringFlag( "batch" );
+  if ( list_file_name != "0" ) { // -batch=LISTFILE rather than just -batch
+    if ( ! readBatchList( list_file_name, entries ) ) {
+      cerr << "Unable to open batch list " << list_file_name << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void batchResources( const CmdLine & command_line, unsigned batch_size,
+                     unsigned & workers, unsigned & threads_per_instance )
+{
+  unsigned cores = thread::hardware_concurrency();
+  if ( cores == 0 ) cores = 1;
+  workers = 0;
+  threads_per_instance = 0;
+  if ( command_line.flagPresent( "workers" ) ) {
+    int requested = command_line.intFlag( "workers" );
+    if ( requested > 0 ) workers = requested;
+  }
+  if ( command_line.flagPresent( "threads" ) ) {
+    int requested = command_line.intFlag( "threads" );
+    if ( requested > 0 ) threads_per_instance = requested;
+  }
+  if ( workers == 0 ) {
+    workers = threads_per_instance > 0 ? cores / threads_per_instance : cores;
+  }
+  if ( workers > batch_size ) workers = batch_size;
+  if ( workers == 0 ) workers = 1;
+  if ( threads_per_instance == 0 ) threads_per_instance = cores / workers;
+  if ( threads_per_instance == 0 ) threads_per_instance = 1;
+}
+
+static void batch_worker( BatchState * state )
+{
+  // one environment per worker, reused for all of its instances
+  IloEnv env;
+  const vector<BatchEntry> & entries = *state->entries;
+  while ( true ) {
+    size_t index = state->next_entry++;
+    if ( index >= entries.size() ) break;
+    CmdLine options( *state->command_line );
+    ostringstream threads_value;
+    threads_value << state->threads_per_instance;
+    options.setFlag( "threads", threads_value.str() );
+    if ( ! entries[index].upper_bound.empty()
+         && atof( entries[index].upper_bound.c_str() ) > 0 ) {
+      options.setFlag( "UB", entries[index].upper_bound );
+    }
+    ostringstream output;
+    int status = EXIT_FAILURE;
+    try {
+      status = state->solve_instance( env, options, entries[index].file_name,
+                                      0, 0, output );
+    }
+    catch ( IloException & e ) {
+      output << "ERROR\t" << e.getMessage() << endl;
+      e.end();
+    }
+    catch ( ... ) {
+      output << "ERROR\tunexpected exception" << endl;
+    }
+    lock_guard<mutex> lock( state->result_mutex );
+    state->outputs[index] = output.str();
+    state->statuses[index] = status;
+    state->done[index] = true;
+    state->result_ready.notify_all();
+  }
+  env.end();
+}
+
+int runBatch( const CmdLine & command_line, InstanceSolver solve_instance,
+              ostream & out )
+{
+  vector<BatchEntry> entries;
+  if ( ! collectBatchEntries( command_line, entries ) ) return EXIT_FAILURE;
+  if ( entries.empty() ) {
+    cerr << "Batch mode: no instances given." << endl;
+    return EXIT_FAILURE;
+  }
+
+  BatchState state;
+  unsigned workers = 1;
+  batchResources( command_line, entries.size(), workers,
+                  state.threads_per_instance );
+  state.command_line = &command_line;
+  state.solve_instance = solve_instance;
+  state.entries = &entries;
+  state.next_entry = 0;
+  state.outputs.resize( entries.size() );
+  state.statuses.resize( entries.size(), EXIT_FAILURE );
+  state.done.resize( entries.size(), false );
+
+  ClockTimer batch_timer = ClockTimer();
+  batch_timer.start();
+  vector<thread> threads;
+  for ( unsigned w = 0; w < workers; ++w ) {
+    threads.push_back( thread( batch_worker, &state ) );
+  }
+
+  // print results in the original order as soon as they are available
+  unsigned failures = 0;
+  for ( size_t index = 0; index < entries.size(); ++index ) {
+    string output;
+    {
+      unique_lock<mutex> lock( state.result_mutex );
+      while ( ! state.done[index] ) state.result_ready.wait( lock );
+      output.swap( state.outputs[index] );
+    }
+    if ( state.statuses[index] != 0 ) ++failures;
+    out << "===== cplex_ilp " << entries[index].file_name << " =====" << endl;
+    out << output;
+    out << "====================================================" << endl;
+    out << endl << flush;
+  }
+  for ( size_t w = 0; w < threads.size(); ++w ) threads[w].join();
+  batch_timer.stop();
+
+  double wall_time = batch_timer.getTotalTime();
+  out << "BatchInstances\t" << entries.size() << endl;
+  out << "BatchFailures\t" << failures << endl;
+  out << "BatchWorkers\t" << workers << endl;
+  out << "BatchThreadsPerInstance\t" << state.threads_per_instance << endl;
+  out << "BatchWallTime\t" << wall_time << endl;
+  out << "BatchInstancesPerHour\t"
+      << (wall_time > 0 ? 3600 * entries.size() / wall_time : 0) << endl;
+  return failures == 0 ? 0 : EXIT_FAILURE;
+}
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -0,0 +1,77 @@
+/**
+ * @file Batch.h
+ * @brief Batch mode: solves many instances in one process, several at a
+ * time, instead of one cplex_ilp process per instance
+ *
+ * Each worker thread has its own IloEnv (Concert environments must not be
+ * shared between threads) and reuses it for every instance it solves.
+ * The output of each instance is collected separately and printed in the
+ * order in which the instances were given, so the result is the same
+ * regardless of which instances finish first.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <ilcplex/ilocplex.h>
+#include "CmdLine.h"
+#include "LpModel.h"
+
+struct PortfolioRacer;
+
+/// solves one instance with the given options, writing tag/value output to
+/// the stream; the model is read from the file unless an already parsed
+/// one is given; racer is 0 unless the solve is part of a portfolio race
+/// (see Portfolio.h); returns an exit status (0 = success)
+typedef int (*InstanceSolver)( IloEnv env, const CmdLine & options,
+                               const std::string file_name,
+                               const LpModel * parsed_model,
+                               PortfolioRacer * racer,
+                               std::ostream & out );
+
+/// one line of a batch list: a file and, optionally, a known upper bound
+/// (the BENCHMARK_LIST format of scripts/cplexLBFromFile)
+struct BatchEntry {
+  std::string file_name;
+  std::string upper_bound;      // empty if none was given
+};
+
+/// reads a batch list; blank lines and lines starting with # are ignored
+/// @return true if the file could be read
+bool readBatchList( const std::string & list_file_name,
+                    std::vector<BatchEntry> & entries );
+
+/// @return the value on the first line of the tag/value output of a run
+/// whose first word is tag, empty if there is none
+std::string outputTagValue( const std::string & output,
+                            const std::string & tag );
+
+/// appends the files on the command line and, with -batch=LISTFILE, the
+/// entries of LISTFILE to entries
+/// @return false if the list could not be read (after reporting it)
+bool collectBatchEntries( const CmdLine & command_line,
+                          std::vector<BatchEntry> & entries );
+
+/// computes the number of workers and the number of CPLEX threads per
+/// instance for a batch of the given size, based on -workers and -threads
+/// if present and on the number of cores otherwise
+void batchResources( const CmdLine & command_line, unsigned batch_size,
+                     unsigned & workers, unsigned & threads_per_instance );
+
+/// Solves every file on the command line and every file in the list given
+/// by -batch=LISTFILE, using -workers concurrent workers with -threads
+/// CPLEX threads each; a positive upper bound in the list is passed on as
+/// -UB. Prints each instance's output between the separators used by
+/// scripts/cplexClassScript, followed by aggregate Batch* tags.
+/// @return 0 if all instances were solved without error
+int runBatch( const CmdLine & command_line, InstanceSolver solve_instance,
+              std::ostream & out );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -0,0 +1,121 @@
+/// @file Checkpoint.cpp
+/// @brief reading, writing and updating of checkpoints
+
+#include"Checkpoint.h"
+#include<fstream>
+#include<sstream>
+#include<cstdlib>
+
+Checkpoint::Checkpoint( const std::string & instance, bool minimize ):
+  my_instance( instance ),
+  my_minimize( minimize ),
+  my_jobs( 0 ),
+  my_elapsed( 0 ),
+  my_nodes( 0 ),
+  my_has_bound( false ),
+  my_best_bound( 0 ),
+  my_proved_optimal( false )
+{
+}
+
+bool
+Checkpoint::read( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ifstream in( file_name.c_str() );
+  if ( ! in ) return fail( "unable to open " + file_name );
+  // the header ends where the first solution begins
+  bool has_version = false;
+  std::string line;
+  while ( getline( in, line ) ) {
+    std::istringstream fields( line );
+    std::string tag, value;
+    fields >> tag >> value;
+    if ( tag == "BeginSolution" ) break;
+    if ( tag == "CheckpointVersion" ) {
+      if ( strtoul( value.c_str(), 0, 10 ) != FORMAT_VERSION ) {
+        return fail( file_name + ": unsupported checkpoint version " + value );
+      }
+      has_version = true;
+    }
+    else if ( tag == "Instance" ) my_instance = value;
+    else if ( tag == "Sense" ) my_minimize = value != "max";
+    else if ( tag == "Jobs" ) my_jobs = atoi( value.c_str() );
+    else if ( tag == "Elapsed" ) my_elapsed = strtod( value.c_str(), 0 );
+    else if ( tag == "Nodes" ) my_nodes = strtoll( value.c_str(), 0, 10 );
+    else if ( tag == "BestBound" ) {
+      my_has_bound = true;
+      my_best_bound = strtod( value.c_str(), 0 );
+    }
+    else if ( tag == "ProvedOptimal" ) my_proved_optimal = value == "1";
+  }
+  if ( ! has_version ) return fail( file_name + ": not a checkpoint" );
+  my_solutions.clear();
+  // a checkpoint of a run that found no solution has no blocks, which
+  // SolutionFile would read as a bare list
+  if ( in && ! my_solutions.read( file_name ) ) {
+    return fail( my_solutions.errorMessage() );
+  }
+  return true;
+}
+
+bool
+Checkpoint::write( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ostringstream header;
+  header.precision( 17 );
+  header << "CheckpointVersion\t" << FORMAT_VERSION << "\n";
+  header << "Instance\t" << my_instance << "\n";
+  header << "Sense\t" << (my_minimize ? "min" : "max") << "\n";
+  header << "Jobs\t" << my_jobs << "\n";
+  header << "Elapsed\t" << my_elapsed << "\n";
+  header << "Nodes\t" << my_nodes << "\n";
+  if ( my_has_bound ) header << "BestBound\t" << my_best_bound << "\n";
+  header << "ProvedOptimal\t" << (my_proved_optimal ? 1 : 0) << "\n";
+  my_solutions.setHeader( header.str() );
+  if ( ! my_solutions.write( file_name ) ) {
+    return fail( my_solutions.errorMessage() );
+  }
+  return true;
+}
+
+Checkpoint
+Checkpoint::advance( double elapsed, int64_t nodes, bool has_bound,
+                     double bound, bool proved_optimal,
+                     const SolutionFile & solutions,
+                     size_t max_solutions ) const
+{
+  Checkpoint next( *this );
+  next.my_jobs = my_jobs + 1;
+  next.my_elapsed = my_elapsed + elapsed;
+  next.my_nodes = my_nodes + nodes;
+  // every bound proved by some run holds, so the tightest one is kept
+  if ( has_bound ) {
+    if ( ! my_has_bound
+         || (my_minimize ? bound > my_best_bound : bound < my_best_bound) ) {
+      next.my_best_bound = bound;
+    }
+    next.my_has_bound = true;
+  }
+  next.my_proved_optimal = my_proved_optimal || proved_optimal;
+  next.my_solutions.clear();
+  for ( size_t i = 0; i < solutions.numberOfSolutions()
+          && next.my_solutions.numberOfSolutions() < max_solutions; ++i ) {
+    next.my_solutions.add( solutions.solution( i ) );
+  }
+  for ( size_t i = 0; i < my_solutions.numberOfSolutions()
+          && next.my_solutions.numberOfSolutions() < max_solutions; ++i ) {
+    next.my_solutions.add( my_solutions.solution( i ) );
+  }
+  return next;
+}
+
+bool
+Checkpoint::fail( const std::string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+//  [Last modified: 2026 10 17 at 20:31:40 GMT]
@@ -0,0 +1,87 @@
+/**
+ * @file Checkpoint.h
+ * @brief State of a solve that is carried across several bounded-length
+ * runs (-checkpoint=PATH, -resume=PATH): the best solutions found, the
+ * best bound proved and the work done so far
+ *
+ * A checkpoint file is a solution file (see SolutionFile.h) with a header
+ * of tag/value lines:
+ *     CheckpointVersion  1
+ *     Instance           NAME
+ *     Sense              min | max
+ *     Jobs               number of runs that contributed
+ *     Elapsed            solve time in seconds, summed over the runs
+ *     Nodes              nodes processed, summed over the runs
+ *     BestBound          best bound of any run (absent if none)
+ *     ProvedOptimal      1 if a run finished the search
+ * so it can also be given to -mipstart.
+ *
+ * The search tree itself is not part of a checkpoint: Concert has no way
+ * to save the open nodes, so a resumed run starts a new tree, with the
+ * solutions as MIP starts (they give it a cutoff right away).
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include<string>
+#include<stdint.h>
+#include"SolutionFile.h"
+
+/// Usage:
+///   Checkpoint previous;
+///   if ( ! previous.read(file_name) ) ... start from scratch
+///   Checkpoint next = previous.advance(elapsed, nodes, ...);
+///   next.write(file_name);
+class Checkpoint {
+public:
+  static const unsigned FORMAT_VERSION = 1;
+
+  /// an empty checkpoint: no runs, no solutions, no bound
+  Checkpoint( const std::string & instance = "", bool minimize = true );
+
+  /// @return true if successful, otherwise see errorMessage()
+  bool read( const std::string & file_name );
+  /// replaces file_name atomically
+  bool write( const std::string & file_name );
+  const std::string & errorMessage() const { return my_error_message; }
+
+  /// @return the checkpoint after one more run that took elapsed seconds
+  /// and nodes nodes, proved bound (if has_bound) and found solutions
+  /// (best first); these come before the solutions of this checkpoint,
+  /// and at most max_solutions are kept
+  Checkpoint advance( double elapsed, int64_t nodes, bool has_bound,
+                      double bound, bool proved_optimal,
+                      const SolutionFile & solutions,
+                      size_t max_solutions ) const;
+
+  const std::string & instance() const { return my_instance; }
+  bool minimize() const { return my_minimize; }
+  int jobs() const { return my_jobs; }
+  double elapsed() const { return my_elapsed; }
+  int64_t nodes() const { return my_nodes; }
+  bool hasBound() const { return my_has_bound; }
+  double bestBound() const { return my_best_bound; }
+  bool provedOptimal() const { return my_proved_optimal; }
+  const SolutionFile & solutions() const { return my_solutions; }
+
+private:
+  bool fail( const std::string & message );
+
+  std::string my_instance;
+  bool my_minimize;
+  int my_jobs;
+  double my_elapsed;
+  int64_t my_nodes;
+  bool my_has_bound;
+  double my_best_bound;
+  bool my_proved_optimal;
+  SolutionFile my_solutions;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 20:31:40 GMT]
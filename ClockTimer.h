@@ -3,8 +3,11 @@
  * @brief Class for computing elapsed time, starting and stopping a virtual
  * stopwatch, and checking whether a time limit has been reached
  *
- * This version uses gettimeofday(), so it's "wall clock" time, which is okay
- * unless there's heavy I/O or other processes running
+ * This version uses clock_gettime() with a monotonic clock, so it's "wall
+ * clock" time that doesn't jump when the system time is adjusted, which is
+ * okay unless there's heavy I/O or other processes running; the processor
+ * time of the whole process is measured alongside, so it includes the
+ * work of everything else the process runs in the meantime
  *
  * @author Matt Stallmann
  * @date 2019/05/17
@@ -14,9 +17,10 @@
 #define CLOCKTIMER_H
 
 #include<iostream>
-#include<sys/time.h>
+#include<time.h>
 
 const double MILLION = 1e6;
+const double BILLION = 1e9;
 
 /// Usage:
 ///   ClockTimer my_timer = ClockTimer()
@@ -28,22 +32,26 @@ const double MILLION = 1e6;
 ///   ... run third thing
 ///   my_timer.stop()
 ///   ... at this point getTotalTime() returns the total time for running
-///   first and third thing   
+///   first and third thing and getCpuTime() the processor time (of all
+///   threads of the process, not only those doing the things timed) used
+///   meanwhile
 class ClockTimer {
 public:
     ClockTimer() { reset(); }
-    void reset() { elapsed_time.tv_sec = 0; elapsed_time.tv_usec = 0; }
+    void reset() { elapsed_time = 0; elapsed_cpu_time = 0; }
     void start() {
-        gettimeofday(&current_time, NULL);
-        time_at_last_start = current_time;
+        time_at_last_start = wallClock();
+        cpu_time_at_last_start = cpuClock();
     }
     void stop() {
-        gettimeofday(&current_time, NULL);
-        elapsed_time.tv_sec += current_time.tv_sec - time_at_last_start.tv_sec;
-        elapsed_time.tv_usec += current_time.tv_usec - time_at_last_start.tv_usec;
+        elapsed_time += wallClock() - time_at_last_start;
+        elapsed_cpu_time += cpuClock() - cpu_time_at_last_start;
     }
     double getTotalTime() const {
-        return elapsed_time.tv_sec + elapsed_time.tv_usec / MILLION;
+        return elapsed_time;
+    }
+    double getCpuTime() const {
+        return elapsed_cpu_time;
     }
     void setTimeLimit(double seconds) {
         time_limit = seconds;
@@ -52,11 +60,27 @@ public:
         if ( getTotalTime() >= time_limit ) return true;
         return false;
     }
+    /// seconds on a monotonic clock (not affected by changes to the
+    /// system time), from an arbitrary origin
+    static double wallClock() {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec / BILLION;
+    }
+    /// processor seconds used by all threads of this process so far; a
+    /// solver runs its own threads, so the time of one of them
+    /// (CLOCK_THREAD_CPUTIME_ID) would leave most of a solve out
+    static double cpuClock() {
+        struct timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return now.tv_sec + now.tv_nsec / BILLION;
+    }
 private:
     double time_limit;
-    struct timeval elapsed_time;
-    struct timeval current_time;
-    struct timeval time_at_last_start;
+    double elapsed_time;
+    double elapsed_cpu_time;
+    double time_at_last_start;
+    double cpu_time_at_last_start;
 };
 
 #endif
@@ -65,4 +89,4 @@ private:
 //  mode:c++ ***
 // End: ***
 
-//  [Last modified: 2019 05 17 at 20:21:26 GMT]
+//  [Last modified: 2026 10 18 at 09:26:40 GMT]
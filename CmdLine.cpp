@@ -166,5 +166,22 @@ CmdLine::boolFlag( const std::string flag ) const
   return retval;
 }
 
+string_table
+CmdLine::getFlags() const
+{
+  return my_flags;
+}
+
+void
+CmdLine::setFlag( const std::string flag, const std::string value )
+{
+  my_flags[ flag ] = value;
+}
+
+void
+CmdLine::removeFlag( const std::string flag )
+{
+  my_flags.erase( flag );
+}
 
-//  [Last modified: 2019 05 02 at 17:06:15 GMT]
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -80,6 +80,17 @@ public:
   // PRE: the value of flag is 0 or 1
   // POST: retval == value of flag interpreted as a Boolean
 
+  string_table getFlags() const;
+  // POST: retval == a copy of the table of flags and their values
+
+  void setFlag( const std::string flag, const std::string value );
+  // POST: flag is present with the given value, replacing any earlier
+  //       value (used to derive the options for one run of many from a
+  //       copy of the original command line)
+
+  void removeFlag( const std::string flag );
+  // POST: flag is not present
+
 private:
   string_list my_files;
   string_table my_flags;
@@ -87,4 +98,4 @@ private:
 
 #endif
 
-//  [Last modified: 2019 05 02 at 16:47:13 GMT]
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -0,0 +1,184 @@
+/// @file CnfParser.cpp
+/// @brief implementation of the memory-mapped DIMACS CNF reader
+
+#include"CnfParser.h"
+#include"MappedFile.h"
+#include<algorithm>
+#include<climits>
+#include<cstdlib>
+#include<sstream>
+#include<string>
+#include<vector>
+
+static bool is_digit( char c ) { return c >= '0' && c <= '9'; }
+
+static bool is_space( char c )
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+CnfParser::CnfParser():
+  my_bytes_read( 0 ), my_clauses( 0 ), my_tautologies( 0 )
+{
+}
+
+bool
+CnfParser::isCnfFile( const std::string & file_name )
+{
+  std::string::size_type start_of_extension = file_name.find_last_of( "." );
+  if ( start_of_extension == std::string::npos ) return false;
+  std::string extension = file_name.substr( start_of_extension + 1 );
+  return extension == "cnf" || extension == "CNF";
+}
+
+bool
+CnfParser::parse( const std::string & file_name, LpModel & model )
+{
+  model.clear();
+  my_error_message = "";
+  my_clauses = 0;
+  my_tautologies = 0;
+  MappedFile input;
+  if ( ! input.open( file_name ) ) {
+    my_error_message = input.errorMessage();
+    return false;
+  }
+  my_bytes_read = input.size();
+  const char * position = input.begin();
+  const char * const end = input.end();
+  int line = 1;
+  int variables = -1;
+  int declared_clauses = 0;
+  std::vector<int> clause;
+  std::vector<int> terms;
+  // per variable, the last clause it appeared in, and as which literal
+  std::vector<int> last_clause;
+  std::vector<int> last_literal;
+
+  while ( position != end ) {
+    char c = *position;
+    if ( c == '\n' ) {
+      ++line;
+      ++position;
+      continue;
+    }
+    if ( is_space( c ) ) {
+      ++position;
+      continue;
+    }
+    if ( c == 'c' || c == '%' || c == 'p' ) {
+      const char * line_end = std::find( position, end, '\n' );
+      if ( c == 'c' ) {
+        position = line_end;
+        continue;
+      }
+      if ( c == '%' ) break;
+      if ( variables >= 0 ) {
+        return syntaxError( line, "second problem line" );
+      }
+      std::istringstream problem( std::string( position + 1, line_end ) );
+      std::string format;
+      problem >> format >> variables >> declared_clauses;
+      if ( ! problem || format != "cnf" || variables < 0
+           || declared_clauses < 0 ) {
+        return syntaxError( line, "expected p cnf VARIABLES CLAUSES" );
+      }
+      // the columns come first, in order, so that xk is column k - 1
+      model.setMinimize( true );
+      for ( int k = 1; k <= variables; ++k ) {
+        std::ostringstream name;
+        name << "x" << k;
+        int j = model.findOrAddColumn( name.str().c_str(), name.str().size() );
+        model.setColumnType( j, LpModel::BINARY );
+        model.setObjectiveCoefficient( j, 1 );
+      }
+      last_clause.assign( variables + 1, 0 );
+      last_literal.assign( variables + 1, 0 );
+      position = line_end;
+      continue;
+    }
+    if ( ! is_digit( c ) && c != '-' ) {
+      return syntaxError( line, std::string( "unexpected character '" )
+                          + c + "'" );
+    }
+    if ( variables < 0 ) {
+      return syntaxError( line, "clause before the problem line" );
+    }
+    bool negative = c == '-';
+    if ( negative ) ++position;
+    if ( position == end || ! is_digit( *position ) ) {
+      return syntaxError( line, "expected a literal" );
+    }
+    long literal = 0;
+    while ( position != end && is_digit( *position ) ) {
+      literal = 10 * literal + ( *position - '0' );
+      if ( literal > INT_MAX ) return syntaxError( line, "literal too large" );
+      ++position;
+    }
+    if ( literal > variables ) {
+      std::ostringstream message;
+      message << "variable " << literal << " out of range 1.." << variables;
+      return syntaxError( line, message.str() );
+    }
+    if ( literal != 0 ) {
+      clause.push_back( negative ? -literal : literal );
+      continue;
+    }
+
+    // the end of a clause: the literals are kept in their order, those
+    // seen before in the clause are skipped
+    ++my_clauses;
+    terms.clear();
+    bool tautology = false;
+    for ( size_t t = 0; t < clause.size() && ! tautology; ++t ) {
+      int variable = std::abs( clause[t] );
+      if ( last_clause[variable] == my_clauses ) {
+        tautology = last_literal[variable] != clause[t];
+        continue;
+      }
+      last_clause[variable] = my_clauses;
+      last_literal[variable] = clause[t];
+      terms.push_back( clause[t] );
+    }
+    clause.clear();
+    if ( tautology ) {
+      ++my_tautologies;
+      continue;
+    }
+    // named after its number in the file, so that the names don't shift
+    // when a tautology is left out
+    model.beginRow( "c" + std::to_string( my_clauses ) );
+    int negated = 0;
+    for ( size_t t = 0; t < terms.size(); ++t ) {
+      if ( terms[t] > 0 ) model.addTerm( terms[t] - 1, 1 );
+      else {
+        model.addTerm( -terms[t] - 1, -1 );
+        ++negated;
+      }
+    }
+    model.endRow( LpModel::GREATER_EQUAL, 1 - negated );
+  }
+
+  if ( ! clause.empty() ) {
+    return syntaxError( line, "last clause is not ended by 0" );
+  }
+  if ( variables < 0 ) return syntaxError( line, "no problem line" );
+  if ( my_clauses != declared_clauses ) {
+    std::ostringstream message;
+    message << my_clauses << " clauses, the problem line says "
+            << declared_clauses;
+    return syntaxError( line, message.str() );
+  }
+  return true;
+}
+
+bool
+CnfParser::syntaxError( int line, const std::string & message )
+{
+  std::ostringstream error_stream;
+  error_stream << "line " << line << ": " << message;
+  my_error_message = error_stream.str();
+  return false;
+}
+
+//  [Last modified: 2026 10 18 at 09:36:21 GMT]
@@ -0,0 +1,65 @@
+/**
+ * @file CnfParser.h
+ * @brief Streaming reader for DIMACS CNF files, building the covering model
+ * of a SAT instance directly, without an intermediate LP file
+ *
+ * Variable k of the formula becomes binary column xk with cost 1 (the
+ * objective is to minimize the number of true variables), and clause N of
+ * the file a row cN: with P its positive and N its negative literals, sum_{k in P}
+ * xk + sum_{k in N} (1 - xk) >= 1, i.e., sum_P xk - sum_N xk >= 1 - |N|.
+ * This is the model our converter wrote to .lpx files (e.g.,
+ * Examples/e64.b.lpx), with the same names. A clause that repeats a
+ * literal has it once; a clause with both xk and its complement is always
+ * satisfied and is left out (the rows after it keep their names).
+ *
+ * The file is memory mapped and read in one pass. Lines starting with c
+ * are comments; the problem line p cnf VARIABLES CLAUSES is required
+ * before the first clause; clauses are lists of nonzero integers, each
+ * ended by a 0, and may span lines; a line starting with % ends the input
+ * (as in the SATLIB files).
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef CNFPARSER_H
+#define CNFPARSER_H
+
+#include<string>
+#include<cstddef>
+#include"LpModel.h"
+
+/// Usage:
+///   CnfParser parser;
+///   LpModel model;
+///   if ( ! parser.parse(file_name, model) ) ... report parser.errorMessage()
+class CnfParser {
+public:
+  CnfParser();
+
+  /// @return true if the file name has the extension of a DIMACS CNF file
+  /// (.cnf)
+  static bool isCnfFile( const std::string & file_name );
+
+  /// @return true if the whole file was read into model (which is cleared
+  /// first); on failure errorMessage() says why and where
+  bool parse( const std::string & file_name, LpModel & model );
+
+  const std::string & errorMessage() const { return my_error_message; }
+  /// number of bytes in the most recently parsed file
+  size_t bytesRead() const { return my_bytes_read; }
+  /// clauses in the file, and those left out because they are tautologies
+  int clauses() const { return my_clauses; }
+  int tautologies() const { return my_tautologies; }
+
+private:
+  bool syntaxError( int line, const std::string & message );
+
+  std::string my_error_message;
+  size_t my_bytes_read;
+  int my_clauses;
+  int my_tautologies;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 09:36:21 GMT]
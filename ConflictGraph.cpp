@@ -0,0 +1,165 @@
+/// @file ConflictGraph.cpp
+/// @brief conflicts of binary literals, from the rows of a model
+
+#include"ConflictGraph.h"
+#include<algorithm>
+#include<functional>
+#include<set>
+#include<utility>
+
+/// weights that sum to more than the bound by at most this much don't
+/// count as a conflict
+static const double CONFLICT_TOLERANCE = 1e-9;
+
+/// conflicts of a row outside its big clique that are added as cliques of
+/// two, at most
+static const int MAX_PAIRS_PER_ROW = 1000;
+
+static bool is_binary( const LpModel & model, int j )
+{
+  return model.isInteger( j ) && model.lowerBound( j ) >= 0
+    && model.upperBound( j ) <= 1;
+}
+
+ConflictGraph::ConflictGraph( const LpModel & model ):
+  my_model( model ),
+  my_conflicting_literals( 0 ),
+  my_edges( 0 )
+{
+  my_clique_starts.push_back( 0 );
+  my_literal_starts.assign( 2 * model.numberOfColumns() + 1, 0 );
+}
+
+bool
+ConflictGraph::build()
+{
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  const std::vector<double> & row_values = my_model.rowValues();
+  my_clique_starts.assign( 1, 0 );
+  my_clique_members.clear();
+  my_edges = 0;
+
+  std::set< std::vector<int> > seen;
+  std::vector< std::pair<double, int> > terms;
+  std::vector<int> members;
+  for ( int i = 0; i < my_model.numberOfRows(); ++i ) {
+    char sense = my_model.rowSense( i );
+    // an equation is both a <= row and a >= row
+    for ( int side = 0; side < 2; ++side ) {
+      double sign;
+      if ( side == 0 && sense != LpModel::GREATER_EQUAL ) sign = 1;
+      else if ( side == 1 && sense != LpModel::LESS_EQUAL ) sign = -1;
+      else continue;
+      double bound = sign * my_model.rightHandSide( i );
+      bool bounded = true;
+      terms.clear();
+      for ( int k = my_model.rowBegin( i ); k < my_model.rowEnd( i ); ++k ) {
+        int j = row_columns[k];
+        double a = sign * row_values[k];
+        if ( a == 0 ) continue;
+        if ( is_binary( my_model, j ) ) {
+          // a x = a + (-a) (1 - x)
+          if ( a > 0 ) {
+            terms.push_back( std::make_pair( a, literal( j, false ) ) );
+          }
+          else {
+            terms.push_back( std::make_pair( -a, literal( j, true ) ) );
+            bound -= a;
+          }
+        }
+        else {
+          double least = a > 0 ? a * my_model.lowerBound( j )
+            : a * my_model.upperBound( j );
+          if ( least <= -LP_INFINITY || least >= LP_INFINITY ) {
+            bounded = false;
+            break;
+          }
+          bound -= least;
+        }
+      }
+      if ( ! bounded || terms.size() < 2 || bound < 0 ) continue;
+      std::sort( terms.begin(), terms.end(),
+                 std::greater< std::pair<double, int> >() );
+      // the heaviest literals, as long as the two lightest conflict
+      size_t clique_size = 1;
+      while ( clique_size < terms.size()
+              && terms[clique_size - 1].first + terms[clique_size].first
+              > bound + CONFLICT_TOLERANCE ) {
+        ++clique_size;
+      }
+      if ( clique_size < 2 ) continue;
+      members.clear();
+      for ( size_t p = 0; p < clique_size; ++p ) {
+        members.push_back( terms[p].second );
+      }
+      std::sort( members.begin(), members.end() );
+      if ( seen.insert( members ).second ) addClique( members );
+      // a lighter literal conflicts with those of the clique heavy enough
+      int pairs = 0;
+      for ( size_t q = clique_size;
+            q < terms.size() && pairs < MAX_PAIRS_PER_ROW; ++q ) {
+        for ( size_t p = 0;
+              p < clique_size && pairs < MAX_PAIRS_PER_ROW; ++p ) {
+          if ( terms[p].first + terms[q].first
+               <= bound + CONFLICT_TOLERANCE ) {
+            break;
+          }
+          members.clear();
+          members.push_back( std::min( terms[p].second, terms[q].second ) );
+          members.push_back( std::max( terms[p].second, terms[q].second ) );
+          if ( seen.insert( members ).second ) addClique( members );
+          ++pairs;
+        }
+      }
+    }
+  }
+
+  // cliques of each literal; clique numbers increase, so each list is sorted
+  const int number_of_literals = 2 * my_model.numberOfColumns();
+  my_literal_starts.assign( number_of_literals + 1, 0 );
+  for ( size_t k = 0; k < my_clique_members.size(); ++k ) {
+    ++my_literal_starts[ my_clique_members[k] + 1 ];
+  }
+  my_conflicting_literals = 0;
+  for ( int u = 0; u < number_of_literals; ++u ) {
+    if ( my_literal_starts[u + 1] > 0 ) ++my_conflicting_literals;
+    my_literal_starts[u + 1] += my_literal_starts[u];
+  }
+  my_literal_cliques.resize( my_clique_members.size() );
+  std::vector<int> next( my_literal_starts.begin(),
+                         my_literal_starts.end() - 1 );
+  for ( int c = 0; c < numberOfCliques(); ++c ) {
+    for ( const int * u = cliqueBegin( c ); u != cliqueEnd( c ); ++u ) {
+      my_literal_cliques[ next[*u]++ ] = c;
+    }
+  }
+  return numberOfCliques() > 0;
+}
+
+void
+ConflictGraph::addClique( const std::vector<int> & members )
+{
+  my_clique_members.insert( my_clique_members.end(), members.begin(),
+                            members.end() );
+  my_clique_starts.push_back( my_clique_members.size() );
+  long size = members.size();
+  my_edges += size * (size - 1) / 2;
+}
+
+bool
+ConflictGraph::adjacent( int u, int v ) const
+{
+  if ( u == v ) return false;
+  const int * a = cliquesOfBegin( u );
+  const int * a_end = cliquesOfEnd( u );
+  const int * b = cliquesOfBegin( v );
+  const int * b_end = cliquesOfEnd( v );
+  while ( a != a_end && b != b_end ) {
+    if ( *a == *b ) return true;
+    if ( *a < *b ) ++a;
+    else ++b;
+  }
+  return false;
+}
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
@@ -0,0 +1,91 @@
+/**
+ * @file ConflictGraph.h
+ * @brief Conflict graph of the binary columns of a model, on literals: two
+ * literals conflict if no solution has both at 1 (-packing_cuts)
+ *
+ * The literals of a binary column x_j are x_j itself and its complement
+ * 1 - x_j, so that covering rows give conflicts as well as packing rows:
+ * x_1 + x_2 >= 1 says that the complements of x_1 and x_2 conflict. Each
+ * row is written as sum of w_p l_p <= b with weights w_p > 0 on literals
+ * l_p -- a negative coefficient a_j of x_j is the weight -a_j of its
+ * complement, and other columns contribute the least value of their term
+ * to b. Literals p and q of the row conflict if w_p + w_q > b.
+ *
+ * The conflicts are kept as cliques, not edges: the heaviest literals of a
+ * row, as long as the two lightest of them conflict, are one clique -- a
+ * packing row is a single clique however long it is -- and the other
+ * conflicts of the row are cliques of two. Two literals are adjacent if
+ * they have a clique in common.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef CONFLICTGRAPH_H
+#define CONFLICTGRAPH_H
+
+#include<vector>
+#include"LpModel.h"
+
+/// Usage:
+///   ConflictGraph graph( model );
+///   if ( graph.build() ) ... graph.adjacent( ConflictGraph::literal( j,
+///     false ), ConflictGraph::literal( k, true ) )
+class ConflictGraph {
+public:
+  explicit ConflictGraph( const LpModel & model );
+
+  /// the literal of column j, or of its complement
+  static int literal( int column, bool complemented ) {
+    return 2 * column + ( complemented ? 1 : 0 );
+  }
+  static int column( int literal ) { return literal / 2; }
+  static bool complemented( int literal ) { return literal % 2 == 1; }
+  static int complement( int literal ) { return literal ^ 1; }
+
+  /// finds the conflicts of the rows
+  /// @return true if there is at least one
+  bool build();
+
+  int numberOfLiterals() const { return my_literal_starts.size() - 1; }
+  int numberOfCliques() const { return my_clique_starts.size() - 1; }
+  /// literals with a conflict
+  int conflictingLiterals() const { return my_conflicting_literals; }
+  /// pairs of conflicting literals, counting those of each clique
+  long edges() const { return my_edges; }
+
+  /// members of clique c, in increasing order
+  const int * cliqueBegin( int c ) const {
+    return my_clique_members.data() + my_clique_starts[c];
+  }
+  const int * cliqueEnd( int c ) const {
+    return my_clique_members.data() + my_clique_starts[c + 1];
+  }
+  /// cliques of literal u, in increasing order
+  const int * cliquesOfBegin( int u ) const {
+    return my_literal_cliques.data() + my_literal_starts[u];
+  }
+  const int * cliquesOfEnd( int u ) const {
+    return my_literal_cliques.data() + my_literal_starts[u + 1];
+  }
+  bool hasConflicts( int u ) const {
+    return my_literal_starts[u + 1] > my_literal_starts[u];
+  }
+  /// @return true if literals u and v conflict
+  bool adjacent( int u, int v ) const;
+
+private:
+  /// members in increasing order
+  void addClique( const std::vector<int> & members );
+
+  const LpModel & my_model;
+  std::vector<int> my_clique_starts;      // cliques, CSR
+  std::vector<int> my_clique_members;
+  std::vector<int> my_literal_starts;     // cliques of each literal, CSR
+  std::vector<int> my_literal_cliques;
+  int my_conflicting_literals;
+  long my_edges;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
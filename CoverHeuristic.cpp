@@ -0,0 +1,391 @@
+/// @file CoverHeuristic.cpp
+/// @brief greedy and local search for set covering
+
+#include"CoverHeuristic.h"
+#include"ClockTimer.h"
+#include"ThreadTeam.h"
+#include<algorithm>
+#include<atomic>
+#include<cmath>
+#include<utility>
+
+/// relative width of a bucket of the greedy queue
+static const double BUCKET_WIDTH = 1e-3;
+
+/// the bucket width grows if the ratios span more buckets than this
+static const double MAX_BUCKETS = 1 << 22;
+
+/// columns evaluated between checks of the clock
+static const int CLOCK_CHECK_INTERVAL = 64;
+
+/// in a 2-swap, pairs are formed from this many of the most expensive
+/// droppable columns
+static const size_t MAX_PAIR_CANDIDATES = 16;
+
+/// smallest gain that counts as an improvement
+static const double MIN_GAIN = 1e-9;
+
+CoverHeuristic::CoverHeuristic( const LpModel & model ):
+  my_model( model ),
+  my_found( false ),
+  my_value( 0 ),
+  my_greedy_value( 0 ),
+  my_time( 0 ),
+  my_greedy_time( 0 ),
+  my_one_swaps( 0 ),
+  my_two_swaps( 0 ),
+  my_rounds( 0 )
+{
+  int number_of_columns = model.numberOfColumns();
+  const std::vector<int> & row_columns = model.rowColumns();
+  my_column_starts.assign( number_of_columns + 1, 0 );
+  for ( size_t k = 0; k < row_columns.size(); ++k ) {
+    ++my_column_starts[ row_columns[k] + 1 ];
+  }
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    my_column_starts[j + 1] += my_column_starts[j];
+  }
+  my_column_rows.resize( row_columns.size() );
+  std::vector<int> next( my_column_starts.begin(), my_column_starts.end() - 1 );
+  for ( int i = 0; i < model.numberOfRows(); ++i ) {
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      my_column_rows[ next[ row_columns[k] ]++ ] = i;
+    }
+  }
+  my_cost = model.objective();
+  my_count.assign( model.numberOfRows(), 0 );
+  my_in_cover.assign( number_of_columns, 0 );
+}
+
+void
+CoverHeuristic::addColumn( int j )
+{
+  my_in_cover[j] = 1;
+  for ( int k = my_column_starts[j]; k < my_column_starts[j + 1]; ++k ) {
+    ++my_count[ my_column_rows[k] ];
+  }
+}
+
+void
+CoverHeuristic::dropColumn( int j )
+{
+  my_in_cover[j] = 0;
+  for ( int k = my_column_starts[j]; k < my_column_starts[j + 1]; ++k ) {
+    --my_count[ my_column_rows[k] ];
+  }
+}
+
+double
+CoverHeuristic::objective() const
+{
+  double value = my_model.objectiveOffset();
+  for ( size_t j = 0; j < my_in_cover.size(); ++j ) {
+    if ( my_in_cover[j] ) value += my_cost[j];
+  }
+  return value;
+}
+
+void
+CoverHeuristic::greedy()
+{
+  int number_of_columns = my_model.numberOfColumns();
+  const std::vector<int> & row_starts = my_model.rowStarts();
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  int uncovered = my_model.numberOfRows();
+  std::vector<int> new_rows( number_of_columns );
+
+  // columns that cost nothing are always worth taking
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    new_rows[j] = my_column_starts[j + 1] - my_column_starts[j];
+    if ( my_cost[j] <= 0 ) addColumn( j );
+  }
+  for ( int i = 0; i < my_model.numberOfRows(); ++i ) {
+    if ( my_count[i] == 0 ) continue;
+    --uncovered;
+    for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+      --new_rows[ row_columns[k] ];
+    }
+  }
+
+  // bucket b holds columns whose log ratio is about lowest + b * width
+  double lowest = HUGE_VAL, highest = -HUGE_VAL;
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    if ( my_in_cover[j] || new_rows[j] == 0 ) continue;
+    lowest = std::min( lowest, std::log( my_cost[j] / new_rows[j] ) );
+    highest = std::max( highest, std::log( my_cost[j] ) );
+  }
+  double width = std::log1p( BUCKET_WIDTH );
+  if ( (highest - lowest) / width > MAX_BUCKETS ) {
+    width = (highest - lowest) / MAX_BUCKETS;
+  }
+  size_t number_of_buckets = highest >= lowest
+    ? static_cast<size_t>( (highest - lowest) / width ) + 1 : 0;
+  std::vector< std::vector<int> > buckets( number_of_buckets );
+  for ( int j = number_of_columns - 1; j >= 0; --j ) {
+    if ( my_in_cover[j] || new_rows[j] == 0 ) continue;
+    size_t b = static_cast<size_t>( (std::log( my_cost[j] / new_rows[j] )
+                                     - lowest) / width );
+    buckets[ std::min( b, number_of_buckets - 1 ) ].push_back( j );
+  }
+
+  size_t current = 0;
+  while ( uncovered > 0 && current < number_of_buckets ) {
+    if ( buckets[current].empty() ) {
+      ++current;
+      continue;
+    }
+    int j = buckets[current].back();
+    buckets[current].pop_back();
+    if ( new_rows[j] == 0 ) continue;
+    size_t b = static_cast<size_t>( (std::log( my_cost[j] / new_rows[j] )
+                                     - lowest) / width );
+    b = std::min( b, number_of_buckets - 1 );
+    if ( b > current ) {
+      // covered rows made the column worse; look at it again later
+      buckets[b].push_back( j );
+      continue;
+    }
+    addColumn( j );
+    for ( int k = my_column_starts[j]; k < my_column_starts[j + 1]; ++k ) {
+      int i = my_column_rows[k];
+      if ( my_count[i] != 1 ) continue;
+      --uncovered;
+      for ( int m = row_starts[i]; m < row_starts[i + 1]; ++m ) {
+        --new_rows[ row_columns[m] ];
+      }
+    }
+  }
+  my_found = uncovered == 0;
+}
+
+void
+CoverHeuristic::makeMinimal()
+{
+  std::vector< std::pair<double, int> > by_cost;
+  for ( size_t j = 0; j < my_in_cover.size(); ++j ) {
+    if ( my_in_cover[j] && my_cost[j] > 0 ) {
+      by_cost.push_back( std::make_pair( -my_cost[j], static_cast<int>( j ) ) );
+    }
+  }
+  std::sort( by_cost.begin(), by_cost.end() );
+  for ( size_t m = 0; m < by_cost.size(); ++m ) {
+    int j = by_cost[m].second;
+    bool redundant = true;
+    for ( int k = my_column_starts[j];
+          k < my_column_starts[j + 1] && redundant; ++k ) {
+      redundant = my_count[ my_column_rows[k] ] >= 2;
+    }
+    if ( redundant ) dropColumn( j );
+  }
+}
+
+void
+CoverHeuristic::evaluate( int column, Scratch & scratch, Move & best ) const
+{
+  if ( my_in_cover[column] ) return;
+  const std::vector<int> & row_starts = my_model.rowStarts();
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  double added_cost = my_cost[column];
+
+  if ( ++scratch.stamp == 0 ) {
+    std::fill( scratch.seen.begin(), scratch.seen.end(), 0 );
+    scratch.stamp = 1;
+  }
+  for ( int k = my_column_starts[column]; k < my_column_starts[column + 1];
+        ++k ) {
+    scratch.in_added[ my_column_rows[k] ] = 1;
+  }
+
+  // cover columns that share a row with the added one and have no row
+  // that only they cover, once it is in
+  scratch.removable.clear();
+  for ( int k = my_column_starts[column]; k < my_column_starts[column + 1];
+        ++k ) {
+    int i = my_column_rows[k];
+    for ( int m = row_starts[i]; m < row_starts[i + 1]; ++m ) {
+      int j = row_columns[m];
+      if ( ! my_in_cover[j] || scratch.seen[j] == scratch.stamp
+           || my_cost[j] <= 0 ) {
+        continue;
+      }
+      scratch.seen[j] = scratch.stamp;
+      bool removable = true;
+      for ( int n = my_column_starts[j];
+            n < my_column_starts[j + 1] && removable; ++n ) {
+        int r = my_column_rows[n];
+        removable = my_count[r] >= 2 || scratch.in_added[r];
+      }
+      if ( removable ) scratch.removable.push_back( j );
+    }
+  }
+
+  std::vector<int> & removable = scratch.removable;
+  size_t candidates = std::min( removable.size(), MAX_PAIR_CANDIDATES );
+  std::partial_sort( removable.begin(), removable.begin() + candidates,
+                     removable.end(),
+                     [this]( int a, int b ) { return my_cost[a] > my_cost[b]; } );
+  if ( ! removable.empty()
+       && my_cost[ removable[0] ] - added_cost > best.gain + MIN_GAIN ) {
+    best.gain = my_cost[ removable[0] ] - added_cost;
+    best.add = column;
+    best.drop[0] = removable[0];
+    best.drop[1] = -1;
+  }
+  for ( size_t a = 0; a < candidates; ++a ) {
+    for ( size_t b = a + 1; b < candidates; ++b ) {
+      int first = removable[a], second = removable[b];
+      double gain = my_cost[first] + my_cost[second] - added_cost;
+      if ( gain <= best.gain + MIN_GAIN ) break;
+      // rows of both must stay covered without either
+      bool both = true;
+      int p = my_column_starts[first], p_end = my_column_starts[first + 1];
+      int q = my_column_starts[second], q_end = my_column_starts[second + 1];
+      while ( p < p_end && q < q_end && both ) {
+        if ( my_column_rows[p] < my_column_rows[q] ) ++p;
+        else if ( my_column_rows[q] < my_column_rows[p] ) ++q;
+        else {
+          int r = my_column_rows[p];
+          both = my_count[r] + scratch.in_added[r] >= 3;
+          ++p;
+          ++q;
+        }
+      }
+      if ( ! both ) continue;
+      best.gain = gain;
+      best.add = column;
+      best.drop[0] = first;
+      best.drop[1] = second;
+    }
+  }
+
+  for ( int k = my_column_starts[column]; k < my_column_starts[column + 1];
+        ++k ) {
+    scratch.in_added[ my_column_rows[k] ] = 0;
+  }
+}
+
+bool
+CoverHeuristic::covers( int column, int row ) const
+{
+  // the rows of a column are in increasing order
+  return std::binary_search( my_column_rows.begin() + my_column_starts[column],
+                             my_column_rows.begin()
+                             + my_column_starts[column + 1], row );
+}
+
+bool
+CoverHeuristic::applicable( const Move & move ) const
+{
+  if ( my_in_cover[move.add] ) return false;
+  for ( int d = 0; d < 2 && move.drop[d] >= 0; ++d ) {
+    if ( ! my_in_cover[ move.drop[d] ] ) return false;
+  }
+  // every row of a dropped column stays covered
+  for ( int d = 0; d < 2 && move.drop[d] >= 0; ++d ) {
+    int column = move.drop[d];
+    for ( int k = my_column_starts[column]; k < my_column_starts[column + 1];
+          ++k ) {
+      int r = my_column_rows[k];
+      int count = my_count[r] - 1 + ( covers( move.add, r ) ? 1 : 0 );
+      if ( move.drop[1] >= 0 && covers( move.drop[1 - d], r ) ) --count;
+      if ( count < 1 ) return false;
+    }
+  }
+  return true;
+}
+
+static bool larger_gain_first( const std::pair<double, int> & a,
+                               const std::pair<double, int> & b )
+{
+  return a.first > b.first;
+}
+
+void
+CoverHeuristic::apply( const Move & move )
+{
+  addColumn( move.add );
+  dropColumn( move.drop[0] );
+  if ( move.drop[1] >= 0 ) {
+    dropColumn( move.drop[1] );
+    ++my_two_swaps;
+  }
+  else {
+    ++my_one_swaps;
+  }
+}
+
+bool
+CoverHeuristic::localSearch( double deadline, unsigned threads )
+{
+  int number_of_columns = my_model.numberOfColumns();
+  if ( threads == 0 ) threads = 1;
+  std::vector<Scratch> scratch( threads );
+  for ( unsigned w = 0; w < threads; ++w ) {
+    scratch[w].in_added.assign( my_model.numberOfRows(), 0 );
+    scratch[w].seen.assign( number_of_columns, 0 );
+    scratch[w].stamp = 0;
+  }
+  // several chunks per worker, so that stealing evens out the load
+  size_t chunk = std::max<size_t>( CLOCK_CHECK_INTERVAL,
+                                   number_of_columns / (8 * threads) + 1 );
+  size_t number_of_chunks = (number_of_columns + chunk - 1) / chunk;
+
+  ThreadTeam team( threads );
+  std::vector<Move> best( threads );
+  std::vector< std::pair<double, int> > order;
+  for ( ;; ) {
+    if ( ClockTimer::wallClock() >= deadline ) return false;
+    ++my_rounds;
+    std::fill( best.begin(), best.end(), Move() );
+    std::atomic<bool> out_of_time( false );
+    // chunks are handed out in order to whichever thread is free
+    std::atomic<size_t> next_chunk( 0 );
+    team.run( [&]( unsigned worker ) {
+        for ( size_t task = next_chunk++; task < number_of_chunks
+                && ! out_of_time; task = next_chunk++ ) {
+          size_t end = std::min<size_t>( (task + 1) * chunk,
+                                         number_of_columns );
+          for ( size_t j = task * chunk; j < end; ++j ) {
+            if ( (j - task * chunk) % CLOCK_CHECK_INTERVAL == 0
+                 && ClockTimer::wallClock() >= deadline ) {
+              out_of_time = true;
+              return;
+            }
+            evaluate( j, scratch[worker], best[worker] );
+          }
+        }
+      } );
+    order.clear();
+    for ( unsigned w = 0; w < threads; ++w ) {
+      if ( best[w].add >= 0 ) order.push_back( std::make_pair( best[w].gain,
+                                                               w ) );
+    }
+    // a move found before time ran out is still valid
+    if ( order.empty() ) return ! out_of_time;
+    std::sort( order.begin(), order.end(), larger_gain_first );
+    // the gain of a move depends only on its columns, so one that can
+    // still be applied still improves
+    apply( best[ order[0].second ] );
+    for ( size_t m = 1; m < order.size(); ++m ) {
+      const Move & move = best[ order[m].second ];
+      if ( applicable( move ) ) apply( move );
+    }
+  }
+}
+
+void
+CoverHeuristic::run( double time_limit, unsigned threads )
+{
+  double start = ClockTimer::wallClock();
+  greedy();
+  if ( my_found ) {
+    makeMinimal();
+    my_greedy_value = objective();
+    my_greedy_time = ClockTimer::wallClock() - start;
+    localSearch( start + time_limit, threads );
+    my_value = objective();
+  }
+  my_time = ClockTimer::wallClock() - start;
+}
+
+//  [Last modified: 2026 10 18 at 07:40:05 GMT]
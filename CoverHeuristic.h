@@ -0,0 +1,108 @@
+/**
+ * @file CoverHeuristic.h
+ * @brief Native primal heuristic for set covering models (-cover_heur):
+ * greedy construction followed by local search, run on the parsed model
+ * before the solve so that CPLEX starts with an incumbent and a cutoff
+ *
+ * The greedy repeatedly takes the column with the least cost per newly
+ * covered row. Ratios only grow as rows get covered, so the columns sit
+ * in a monotone bucket queue keyed by the logarithm of the ratio (buckets
+ * are 0.1% wide): a column taken from the current bucket is either chosen
+ * or, if its ratio has grown, moved to a later bucket. The greedy cover
+ * is then made minimal.
+ *
+ * The local search applies improving moves that add a column outside the
+ * cover and drop one (1-swap) or two (2-swap) cover columns that are
+ * redundant once it is in. Each round evaluates all candidate columns in
+ * parallel against the current cover, which is read-only during a round,
+ * on one ThreadTeam kept for the whole search. The best move of each
+ * thread is applied, best first, as long as it still improves the cover
+ * the earlier ones changed; the search stops at a local optimum or when
+ * the time budget runs out.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef COVERHEURISTIC_H
+#define COVERHEURISTIC_H
+
+#include<vector>
+#include"LpModel.h"
+
+/// Usage:
+///   if ( CoverReduction::classify(model) == CoverReduction::COVERING
+///        && model.minimize() ) {
+///     CoverHeuristic heuristic(model);
+///     heuristic.run(time_limit, threads);
+///     if ( heuristic.solutionFound() ) ... heuristic.solution()
+///   }
+class CoverHeuristic {
+public:
+  /// model must be a set covering model (see CoverReduction::classify())
+  explicit CoverHeuristic( const LpModel & model );
+
+  /// greedy, then local search until time_limit seconds (counted from the
+  /// start) have passed
+  void run( double time_limit, unsigned threads );
+
+  /// false if some row cannot be covered
+  bool solutionFound() const { return my_found; }
+  /// 0/1 value of each column of the model
+  const std::vector<char> & solution() const { return my_in_cover; }
+  /// objective value of solution(), offset included
+  double value() const { return my_value; }
+  double greedyValue() const { return my_greedy_value; }
+  double time() const { return my_time; }
+  double greedyTime() const { return my_greedy_time; }
+  int oneSwaps() const { return my_one_swaps; }
+  int twoSwaps() const { return my_two_swaps; }
+  int rounds() const { return my_rounds; }
+
+private:
+  /// an improving move: add column add, drop columns drop[0] and, if not
+  /// -1, drop[1]
+  struct Move {
+    Move(): gain( 0 ), add( -1 ) { drop[0] = drop[1] = -1; }
+    double gain;
+    int add;
+    int drop[2];
+  };
+  /// marks used while evaluating moves, one set per thread
+  struct Scratch {
+    std::vector<char> in_added;        // per row
+    std::vector<unsigned> seen;        // per column: stamp of last visit
+    unsigned stamp;
+    std::vector<int> removable;
+  };
+
+  void greedy();
+  void makeMinimal();
+  bool localSearch( double deadline, unsigned threads );
+  void evaluate( int column, Scratch & scratch, Move & best ) const;
+  /// true if move can still be applied to the current cover
+  bool applicable( const Move & move ) const;
+  bool covers( int column, int row ) const;
+  void apply( const Move & move );
+  void addColumn( int j );
+  void dropColumn( int j );
+  double objective() const;
+
+  const LpModel & my_model;
+  std::vector<int> my_column_starts;    // transpose of the rows
+  std::vector<int> my_column_rows;
+  std::vector<double> my_cost;
+  std::vector<int> my_count;            // cover columns in each row
+  std::vector<char> my_in_cover;
+  bool my_found;
+  double my_value;
+  double my_greedy_value;
+  double my_time;
+  double my_greedy_time;
+  int my_one_swaps;
+  int my_two_swaps;
+  int my_rounds;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:40:05 GMT]
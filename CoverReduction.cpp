@@ -0,0 +1,438 @@
+/// @file CoverReduction.cpp
+/// @brief reductions for set covering and packing models
+
+#include"CoverReduction.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<utility>
+
+/// no model needs more; each pass that changes something removes at least
+/// one row or column, but later passes find little
+static const int MAX_PASSES = 20;
+
+/// subset tests (elements compared) allowed per domination search, per
+/// nonzero of the model
+static const double WORK_PER_NONZERO = 50;
+
+/// @return a well mixed 64-bit hash of x (splitmix64 finalizer)
+static uint64_t mix( uint64_t x )
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+CoverReduction::Kind
+CoverReduction::classify( const LpModel & model )
+{
+  if ( model.numberOfRows() == 0 ) return NONE;
+  for ( int j = 0; j < model.numberOfColumns(); ++j ) {
+    if ( ! model.isInteger( j ) || model.lowerBound( j ) != 0
+         || model.upperBound( j ) != 1 ) {
+      return NONE;
+    }
+  }
+  const std::vector<double> & values = model.rowValues();
+  for ( size_t k = 0; k < values.size(); ++k ) {
+    if ( values[k] != 1 ) return NONE;
+  }
+  char sense = model.rowSense( 0 );
+  if ( sense == LpModel::EQUAL ) return NONE;
+  for ( int i = 0; i < model.numberOfRows(); ++i ) {
+    if ( model.rowSense( i ) != sense || model.rightHandSide( i ) != 1 ) {
+      return NONE;
+    }
+  }
+  return sense == LpModel::GREATER_EQUAL ? COVERING : PACKING;
+}
+
+CoverReduction::CoverReduction():
+  my_kind( NONE ),
+  my_infeasible( false ),
+  my_rows_removed( 0 ),
+  my_columns_removed( 0 ),
+  my_nonzeros_removed( 0 ),
+  my_fixed_to_one( 0 ),
+  my_singleton_rows( 0 ),
+  my_duplicate_rows( 0 ),
+  my_dominated_rows( 0 ),
+  my_duplicate_columns( 0 ),
+  my_dominated_columns( 0 ),
+  my_passes( 0 ),
+  my_budget_exhausted( false ),
+  my_time( 0 )
+{
+}
+
+void
+CoverReduction::build( const LpModel & original )
+{
+  int number_of_rows = original.numberOfRows();
+  int number_of_columns = original.numberOfColumns();
+
+  my_rows.starts = original.rowStarts();
+  my_rows.elements = original.rowColumns();
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    std::sort( my_rows.elements.begin() + my_rows.starts[i],
+               my_rows.elements.begin() + my_rows.starts[i + 1] );
+  }
+  my_rows.active.assign( number_of_rows, 1 );
+  my_rows.size.resize( number_of_rows );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    my_rows.size[i] = my_rows.starts[i + 1] - my_rows.starts[i];
+  }
+
+  // transpose; scanning the rows in order leaves each column sorted
+  my_columns.starts.assign( number_of_columns + 1, 0 );
+  for ( size_t k = 0; k < my_rows.elements.size(); ++k ) {
+    ++my_columns.starts[ my_rows.elements[k] + 1 ];
+  }
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    my_columns.starts[j + 1] += my_columns.starts[j];
+  }
+  my_columns.elements.resize( my_rows.elements.size() );
+  std::vector<int> next( my_columns.starts.begin(), my_columns.starts.end() - 1 );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    for ( int k = my_rows.starts[i]; k < my_rows.starts[i + 1]; ++k ) {
+      my_columns.elements[ next[ my_rows.elements[k] ]++ ] = i;
+    }
+  }
+  my_columns.active.assign( number_of_columns, 1 );
+  my_columns.size.resize( number_of_columns );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    my_columns.size[j] = my_columns.starts[j + 1] - my_columns.starts[j];
+  }
+
+  my_cost.resize( number_of_columns );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    double cost = original.objectiveCoefficient( j );
+    my_cost[j] = original.minimize() ? cost : -cost;
+  }
+  my_value.assign( number_of_columns, -1 );
+}
+
+void
+CoverReduction::removeRow( int i )
+{
+  if ( ! my_rows.active[i] ) return;
+  my_rows.active[i] = 0;
+  for ( int k = my_rows.starts[i]; k < my_rows.starts[i + 1]; ++k ) {
+    int j = my_rows.elements[k];
+    if ( my_columns.active[j] ) --my_columns.size[j];
+  }
+}
+
+bool
+CoverReduction::fixColumn( int j, int value )
+{
+  if ( ! my_columns.active[j] ) return true;
+  my_columns.active[j] = 0;
+  my_value[j] = value;
+  if ( value == 1 ) ++my_fixed_to_one;
+  for ( int k = my_columns.starts[j]; k < my_columns.starts[j + 1]; ++k ) {
+    int i = my_columns.elements[k];
+    if ( ! my_rows.active[i] ) continue;
+    if ( value == 1 ) {
+      // a covering row is now satisfied (packing columns are fixed to 1
+      // only when they are in no row)
+      removeRow( i );
+      continue;
+    }
+    if ( --my_rows.size[i] == 0 ) {
+      if ( my_kind == COVERING ) {
+        my_infeasible = true;
+        return false;
+      }
+      my_rows.active[i] = 0;
+    }
+  }
+  return true;
+}
+
+bool
+CoverReduction::removeTrivial()
+{
+  bool changed = false;
+  for ( size_t j = 0; j < my_columns.active.size(); ++j ) {
+    if ( ! my_columns.active[j] ) continue;
+    if ( my_columns.size[j] == 0 ) {
+      fixColumn( j, my_cost[j] < 0 ? 1 : 0 );
+      changed = true;
+    }
+    else if ( my_kind == COVERING && my_cost[j] <= 0 ) {
+      fixColumn( j, 1 );
+      changed = true;
+    }
+    else if ( my_kind == PACKING && my_cost[j] >= 0 ) {
+      if ( ! fixColumn( j, 0 ) ) return changed;
+      changed = true;
+    }
+  }
+  for ( size_t i = 0; i < my_rows.active.size(); ++i ) {
+    if ( ! my_rows.active[i] || my_rows.size[i] > 1 ) continue;
+    if ( my_rows.size[i] == 0 ) {
+      if ( my_kind == COVERING ) {
+        my_infeasible = true;
+        return changed;
+      }
+      my_rows.active[i] = 0;
+      changed = true;
+      continue;
+    }
+    ++my_singleton_rows;
+    changed = true;
+    if ( my_kind == PACKING ) {
+      removeRow( i );
+      continue;
+    }
+    for ( int k = my_rows.starts[i]; k < my_rows.starts[i + 1]; ++k ) {
+      if ( my_columns.active[ my_rows.elements[k] ] ) {
+        fixColumn( my_rows.elements[k], 1 );
+        break;
+      }
+    }
+  }
+  return changed;
+}
+
+/// @return true if the active elements of sets a and b are the same
+static bool same_set( const std::vector<int> & starts,
+                      const std::vector<int> & elements,
+                      const std::vector<char> & element_active, int a, int b )
+{
+  int p = starts[a], p_end = starts[a + 1];
+  int q = starts[b], q_end = starts[b + 1];
+  for ( ;; ) {
+    while ( p < p_end && ! element_active[ elements[p] ] ) ++p;
+    while ( q < q_end && ! element_active[ elements[q] ] ) ++q;
+    if ( p == p_end || q == q_end ) return p == p_end && q == q_end;
+    if ( elements[p] != elements[q] ) return false;
+    ++p;
+    ++q;
+  }
+}
+
+bool
+CoverReduction::removeDuplicates( bool rows )
+{
+  Family & sets = rows ? my_rows : my_columns;
+  const Family & elements = rows ? my_columns : my_rows;
+  std::vector< std::pair<uint64_t, int> > keys;
+  for ( size_t a = 0; a < sets.active.size(); ++a ) {
+    if ( ! sets.active[a] || sets.size[a] == 0 ) continue;
+    uint64_t hash = sets.size[a];
+    for ( int k = sets.starts[a]; k < sets.starts[a + 1]; ++k ) {
+      if ( elements.active[ sets.elements[k] ] ) {
+        hash = mix( hash ^ sets.elements[k] );
+      }
+    }
+    keys.push_back( std::make_pair( hash, static_cast<int>( a ) ) );
+  }
+  std::sort( keys.begin(), keys.end() );
+
+  bool changed = false;
+  for ( size_t first = 0; first < keys.size(); ) {
+    size_t last = first + 1;
+    while ( last < keys.size() && keys[last].first == keys[first].first ) {
+      ++last;
+    }
+    // within a group of equal hashes (nearly always identical sets), each
+    // set is compared with the earlier ones still active
+    for ( size_t m = first + 1; m < last; ++m ) {
+      int b = keys[m].second;
+      for ( size_t n = first; n < m && sets.active[b]; ++n ) {
+        int a = keys[n].second;
+        if ( ! sets.active[a]
+             || ! same_set( sets.starts, sets.elements, elements.active,
+                            a, b ) ) {
+          continue;
+        }
+        changed = true;
+        if ( rows ) {
+          removeRow( b );
+          ++my_duplicate_rows;
+        }
+        else {
+          // the cheaper of two identical columns is kept
+          int loser = my_cost[b] < my_cost[a] ? a : b;
+          fixColumn( loser, 0 );
+          ++my_duplicate_columns;
+        }
+      }
+    }
+    first = last;
+  }
+  return changed;
+}
+
+void
+CoverReduction::computeSignatures( Family & sets, const Family & elements )
+{
+  sets.signature.assign( sets.active.size(), 0 );
+  for ( size_t a = 0; a < sets.active.size(); ++a ) {
+    if ( ! sets.active[a] ) continue;
+    uint64_t signature = 0;
+    for ( int k = sets.starts[a]; k < sets.starts[a + 1]; ++k ) {
+      if ( elements.active[ sets.elements[k] ] ) {
+        signature |= uint64_t( 1 ) << (mix( sets.elements[k] ) & 63);
+      }
+    }
+    sets.signature[a] = signature;
+  }
+}
+
+bool
+CoverReduction::isSubset( const Family & sets, const Family & elements,
+                          int a, int b ) const
+{
+  int q = sets.starts[b], q_end = sets.starts[b + 1];
+  for ( int p = sets.starts[a]; p < sets.starts[a + 1]; ++p ) {
+    int e = sets.elements[p];
+    if ( ! elements.active[e] ) continue;
+    while ( q < q_end && sets.elements[q] < e ) ++q;
+    if ( q == q_end || sets.elements[q] != e ) return false;
+  }
+  return true;
+}
+
+bool
+CoverReduction::removeDominated( bool rows )
+{
+  Family & sets = rows ? my_rows : my_columns;
+  Family & elements = rows ? my_columns : my_rows;
+  computeSignatures( sets, elements );
+  double budget = WORK_PER_NONZERO * my_rows.elements.size();
+  double work = 0;
+  bool changed = false;
+  for ( size_t a = 0; a < sets.active.size(); ++a ) {
+    if ( ! sets.active[a] || sets.size[a] == 0 ) continue;
+    // every superset of a contains its rarest element
+    int rarest = -1;
+    for ( int k = sets.starts[a]; k < sets.starts[a + 1]; ++k ) {
+      int e = sets.elements[k];
+      if ( elements.active[e]
+           && (rarest < 0 || elements.size[e] < elements.size[rarest]) ) {
+        rarest = e;
+      }
+    }
+    work += sets.starts[a + 1] - sets.starts[a];
+    for ( int k = elements.starts[rarest];
+          k < elements.starts[rarest + 1] && sets.active[a]; ++k ) {
+      int b = elements.elements[k];
+      ++work;
+      if ( ! sets.active[b] || sets.size[b] <= sets.size[a]
+           || (sets.signature[a] & ~sets.signature[b]) != 0 ) {
+        continue;
+      }
+      work += sets.starts[b + 1] - sets.starts[b];
+      if ( ! isSubset( sets, elements, a, b ) ) continue;
+      // set a is a proper subset of set b
+      if ( rows ) {
+        removeRow( my_kind == COVERING ? b : a );
+        ++my_dominated_rows;
+        changed = true;
+      }
+      else if ( my_kind == COVERING && my_cost[b] <= my_cost[a] ) {
+        fixColumn( a, 0 );
+        ++my_dominated_columns;
+        changed = true;
+      }
+      else if ( my_kind == PACKING && my_cost[a] <= my_cost[b] ) {
+        fixColumn( b, 0 );
+        ++my_dominated_columns;
+        changed = true;
+      }
+    }
+    if ( work > budget ) {
+      my_budget_exhausted = true;
+      break;
+    }
+  }
+  return changed;
+}
+
+bool
+CoverReduction::reduce( const LpModel & original, LpModel & reduced )
+{
+  my_error_message = "";
+  my_kind = classify( original );
+  if ( my_kind == NONE ) {
+    my_error_message = "not a pure set covering or set packing model";
+    return false;
+  }
+  ClockTimer timer = ClockTimer();
+  timer.start();
+  build( original );
+
+  bool changed = true;
+  while ( changed && ! my_infeasible && my_passes < MAX_PASSES ) {
+    ++my_passes;
+    changed = removeTrivial();
+    if ( ! my_infeasible && removeDuplicates( true ) ) changed = true;
+    if ( ! my_infeasible && removeDuplicates( false ) ) changed = true;
+    if ( ! my_infeasible && removeDominated( true ) ) changed = true;
+    if ( ! my_infeasible && removeDominated( false ) ) changed = true;
+  }
+  if ( my_infeasible ) {
+    timer.stop();
+    my_time = timer.getTotalTime();
+    my_error_message = "the model is infeasible (a row has no columns left)";
+    return false;
+  }
+
+  // the remaining columns and rows, in their original order
+  LpModel result;
+  result.setMinimize( original.minimize() );
+  result.setObjectiveName( original.objectiveName() );
+  double offset = original.objectiveOffset();
+  std::vector<int> new_index( original.numberOfColumns(), -1 );
+  my_reduced_to_original.clear();
+  for ( int j = 0; j < original.numberOfColumns(); ++j ) {
+    if ( my_value[j] == 1 ) offset += original.objectiveCoefficient( j );
+    if ( ! my_columns.active[j] ) continue;
+    const std::string & name = original.columnName( j );
+    int k = result.findOrAddColumn( name.data(), name.size() );
+    result.setColumnType( k, LpModel::BINARY );
+    result.setObjectiveCoefficient( k, original.objectiveCoefficient( j ) );
+    new_index[j] = k;
+    my_reduced_to_original.push_back( j );
+  }
+  result.setObjectiveOffset( offset );
+  LpModel::RowSense sense = my_kind == COVERING ? LpModel::GREATER_EQUAL
+    : LpModel::LESS_EQUAL;
+  for ( int i = 0; i < original.numberOfRows(); ++i ) {
+    if ( ! my_rows.active[i] ) continue;
+    result.beginRow( original.rowName( i ) );
+    for ( int k = my_rows.starts[i]; k < my_rows.starts[i + 1]; ++k ) {
+      int j = my_rows.elements[k];
+      if ( my_columns.active[j] ) result.addTerm( new_index[j], 1 );
+    }
+    result.endRow( sense, 1 );
+  }
+
+  my_rows_removed = original.numberOfRows() - result.numberOfRows();
+  my_columns_removed = original.numberOfColumns() - result.numberOfColumns();
+  my_nonzeros_removed = original.numberOfNonZeros() - result.numberOfNonZeros();
+  reduced = result;
+  timer.stop();
+  my_time = timer.getTotalTime();
+  return true;
+}
+
+std::vector<double>
+CoverReduction::postsolve( const std::vector<double> & reduced_values ) const
+{
+  std::vector<double> values( my_value.size() );
+  for ( size_t j = 0; j < my_value.size(); ++j ) {
+    values[j] = my_value[j];
+  }
+  for ( size_t k = 0; k < my_reduced_to_original.size(); ++k ) {
+    values[ my_reduced_to_original[k] ] = reduced_values[k];
+  }
+  return values;
+}
+
+//  [Last modified: 2026 10 17 at 21:05:12 GMT]
@@ -0,0 +1,131 @@
+/**
+ * @file CoverReduction.h
+ * @brief Reductions for pure set covering and set packing models
+ * (-prereduce), done on an LpModel before it goes to the solver, with the
+ * map needed to turn a solution of the reduced model back into one of
+ * the original
+ *
+ * A model qualifies if all columns are binary and all rows are
+ * sum x_j >= 1 (covering) or all rows are sum x_j <= 1 (packing); the
+ * objective may have any sign and sense. The reductions, repeated until
+ * nothing changes, are
+ *  - columns whose cost makes a value obvious (in covering, a column that
+ *    doesn't cost anything is set to 1; in packing, one that doesn't gain
+ *    anything is set to 0) and columns in no row
+ *  - singleton rows: in covering, they force their column to 1 (and all
+ *    rows containing it are then satisfied); in packing, they are void
+ *  - duplicate rows and columns, found by hashing the sorted index lists
+ *  - dominated rows: in covering, a row whose columns include all of
+ *    those of another row; in packing, one whose columns are all in
+ *    another row
+ *  - dominated columns, set to 0: in covering, a column whose rows are
+ *    all covered by a column that costs no more; in packing, one whose
+ *    rows include all of those of a column that gains no less
+ * Subset tests start from the rarest element of the smaller set and use
+ * 64-bit signatures to skip most candidates; a budget on the work per pass
+ * keeps huge instances from taking quadratic time (some dominations are
+ * then missed).
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef COVERREDUCTION_H
+#define COVERREDUCTION_H
+
+#include<string>
+#include<vector>
+#include<stdint.h>
+#include"LpModel.h"
+
+/// Usage:
+///   CoverReduction reduction;
+///   LpModel reduced;
+///   if ( reduction.reduce(model, reduced) ) {
+///     ... solve reduced, giving values of its columns
+///     std::vector<double> original_values = reduction.postsolve(values);
+///   }
+class CoverReduction {
+public:
+  enum Kind { NONE, COVERING, PACKING };
+
+  /// @return the kind of model, NONE if the reductions do not apply
+  static Kind classify( const LpModel & model );
+
+  CoverReduction();
+
+  /// fills reduced with the reduced form of original; reduced has the same
+  /// objective sense and value (fixed columns go into the offset), and
+  /// keeps the names of the remaining columns and rows
+  /// @return false if the model doesn't qualify or is found to be
+  /// infeasible (see errorMessage()); reduced is not changed then
+  bool reduce( const LpModel & original, LpModel & reduced );
+
+  /// @return the values of all columns of the original model, given the
+  /// values of the columns of the reduced one
+  std::vector<double> postsolve( const std::vector<double> & reduced_values ) const;
+
+  Kind kind() const { return my_kind; }
+  bool infeasible() const { return my_infeasible; }
+  const std::string & errorMessage() const { return my_error_message; }
+
+  int rowsRemoved() const { return my_rows_removed; }
+  int columnsRemoved() const { return my_columns_removed; }
+  int nonZerosRemoved() const { return my_nonzeros_removed; }
+  int columnsFixedToOne() const { return my_fixed_to_one; }
+  int singletonRows() const { return my_singleton_rows; }
+  int duplicateRows() const { return my_duplicate_rows; }
+  int dominatedRows() const { return my_dominated_rows; }
+  int duplicateColumns() const { return my_duplicate_columns; }
+  int dominatedColumns() const { return my_dominated_columns; }
+  int passes() const { return my_passes; }
+  /// true if some domination search ran out of budget
+  bool budgetExhausted() const { return my_budget_exhausted; }
+  double reductionTime() const { return my_time; }
+
+private:
+  /// sets stored in CSR form (the rows, or the columns), with the state
+  /// of each set
+  struct Family {
+    std::vector<int> starts;
+    std::vector<int> elements;  // sorted within each set
+    std::vector<char> active;
+    std::vector<int> size;      // number of active elements
+    std::vector<uint64_t> signature;
+  };
+
+  void build( const LpModel & original );
+  bool fixColumn( int j, int value );
+  void removeRow( int i );
+  bool removeTrivial();
+  bool removeDuplicates( bool rows );
+  bool removeDominated( bool rows );
+  bool isSubset( const Family & sets, const Family & elements,
+                 int a, int b ) const;
+  void computeSignatures( Family & sets, const Family & elements );
+
+  Kind my_kind;
+  Family my_rows;               // elements are columns
+  Family my_columns;            // elements are rows
+  std::vector<double> my_cost;  // objective, as if minimizing
+  std::vector<int> my_value;    // -1 = free, else fixed value (original index)
+  std::vector<int> my_reduced_to_original;
+  bool my_infeasible;
+  std::string my_error_message;
+
+  int my_rows_removed;
+  int my_columns_removed;
+  int my_nonzeros_removed;
+  int my_fixed_to_one;
+  int my_singleton_rows;
+  int my_duplicate_rows;
+  int my_dominated_rows;
+  int my_duplicate_columns;
+  int my_dominated_columns;
+  int my_passes;
+  bool my_budget_exhausted;
+  double my_time;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 21:05:12 GMT]
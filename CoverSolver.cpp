@@ -0,0 +1,629 @@
+/// @file CoverSolver.cpp
+/// @brief branch and bound for set covering with a work-stealing node pool
+
+#include"CoverSolver.h"
+#include"CoverReduction.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<memory>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<atomic>
+#include<stdint.h>
+
+/// nodes a worker processes depth first before it takes the node with the
+/// least bound from its deque
+static const long BEST_BOUND_INTERVAL = 64;
+
+static inline bool test_bit( const std::vector<uint64_t> & bits, int i )
+{
+  return (bits[ i >> 6 ] >> (i & 63)) & 1;
+}
+
+static inline void set_bit( std::vector<uint64_t> & bits, int i )
+{
+  bits[ i >> 6 ] |= uint64_t( 1 ) << (i & 63);
+}
+
+/// the search itself: the node pool, the incumbent and the workers
+class CoverSolver::Search {
+public:
+  explicit Search( CoverSolver & solver );
+  void run( unsigned threads, double deadline );
+
+private:
+  struct Node {
+    std::vector<uint64_t> covered;    // rows
+    std::vector<uint64_t> excluded;   // columns set to 0
+    std::vector<int> chosen;          // columns set to 1
+    double cost;
+    double bound;
+    /// dual values of the parent, feasible for this node too
+    std::shared_ptr< const std::vector<double> > duals;
+  };
+  struct Pool {
+    std::mutex lock;
+    std::deque<Node> nodes;
+  };
+  /// per worker
+  struct Scratch {
+    std::vector<double> reduced;      // per column
+    std::vector<int> free_count;      // per row
+    std::vector<int> uncovered;       // rows
+    std::vector<int> cover_count;     // per row, for leaves
+    long since_best;
+  };
+
+  void work( unsigned worker );
+  bool take( unsigned worker, Scratch & scratch, Node & node );
+  void push( unsigned worker, Node & node );
+  void dive( unsigned worker, Scratch & scratch, Node & node );
+  /// computes the bound of node and fixes columns by reduced cost
+  /// @return false if the node can be pruned
+  bool evaluate( Node & node, Scratch & scratch,
+                 std::shared_ptr< std::vector<double> > & duals );
+  /// counts the free columns of the uncovered rows
+  /// @return false if some row has none
+  bool countFree( const Node & node, Scratch & scratch );
+  void leaf( Node & node, Scratch & scratch );
+  bool prunable( double bound ) const;
+
+  CoverSolver & my_solver;
+  int my_rows;
+  int my_columns;
+  int my_row_words;
+  int my_column_words;
+  double my_deadline;
+  std::vector< std::unique_ptr<Pool> > my_pools;
+  std::atomic<long> my_open;        // nodes in pools or being processed
+  std::atomic<long> my_nodes;
+  std::atomic<long> my_stolen;
+  std::atomic<bool> my_stop;
+  std::atomic<bool> my_root_done;
+  std::mutex my_incumbent_lock;
+  std::atomic<double> my_best;      // incumbent cost, infinity if none
+  friend class CoverSolver;
+};
+
+CoverSolver::Search::Search( CoverSolver & solver ):
+  my_solver( solver ),
+  my_rows( solver.my_row_starts.size() - 1 ),
+  my_columns( solver.my_costs.size() ),
+  my_row_words( (my_rows + 63) / 64 ),
+  my_column_words( (my_columns + 63) / 64 ),
+  my_deadline( 0 ), my_open( 0 ), my_nodes( 0 ), my_stolen( 0 ),
+  my_stop( false ), my_root_done( false ),
+  my_best( solver.my_has_incumbent ? solver.my_incumbent_cost
+           : std::numeric_limits<double>::infinity() )
+{
+}
+
+void
+CoverSolver::Search::run( unsigned threads, double deadline )
+{
+  my_deadline = deadline;
+  for ( unsigned w = 0; w < threads; ++w ) {
+    my_pools.push_back( std::unique_ptr<Pool>( new Pool ) );
+  }
+  Node root;
+  root.covered.assign( my_row_words, 0 );
+  root.excluded.assign( my_column_words, 0 );
+  root.cost = 0;
+  root.bound = 0;
+  my_open = 1;
+  my_pools[0]->nodes.push_back( root );
+
+  std::vector<std::thread> workers;
+  for ( unsigned w = 0; w < threads; ++w ) {
+    workers.push_back( std::thread( &Search::work, this, w ) );
+  }
+  for ( unsigned w = 0; w < threads; ++w ) workers[w].join();
+}
+
+void
+CoverSolver::Search::work( unsigned worker )
+{
+  Scratch scratch;
+  scratch.reduced.resize( my_columns );
+  scratch.free_count.resize( my_rows );
+  scratch.cover_count.resize( my_rows );
+  scratch.since_best = 0;
+  while ( ! my_stop ) {
+    Node node;
+    if ( ! take( worker, scratch, node ) ) {
+      if ( my_open == 0 ) break;
+      std::this_thread::yield();
+      continue;
+    }
+    dive( worker, scratch, node );
+  }
+}
+
+bool
+CoverSolver::Search::take( unsigned worker, Scratch & scratch, Node & node )
+{
+  {
+    Pool & own = *my_pools[worker];
+    std::lock_guard<std::mutex> guard( own.lock );
+    if ( ! own.nodes.empty() ) {
+      if ( scratch.since_best >= BEST_BOUND_INTERVAL ) {
+        scratch.since_best = 0;
+        std::deque<Node>::iterator best = own.nodes.begin();
+        for ( std::deque<Node>::iterator it = own.nodes.begin();
+              it != own.nodes.end(); ++it ) {
+          if ( it->bound < best->bound ) best = it;
+        }
+        node = std::move( *best );
+        own.nodes.erase( best );
+      }
+      else {
+        node = std::move( own.nodes.back() );
+        own.nodes.pop_back();
+      }
+      return true;
+    }
+  }
+  // steal the oldest node, nearest the root, of another worker
+  for ( size_t v = 1; v < my_pools.size(); ++v ) {
+    Pool & victim = *my_pools[ (worker + v) % my_pools.size() ];
+    std::lock_guard<std::mutex> guard( victim.lock );
+    if ( ! victim.nodes.empty() ) {
+      node = std::move( victim.nodes.front() );
+      victim.nodes.pop_front();
+      ++my_stolen;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+CoverSolver::Search::push( unsigned worker, Node & node )
+{
+  Pool & own = *my_pools[worker];
+  std::lock_guard<std::mutex> guard( own.lock );
+  own.nodes.push_back( std::move( node ) );
+}
+
+void
+CoverSolver::Search::dive( unsigned worker, Scratch & scratch, Node & node )
+{
+  const std::vector<int> & row_starts = my_solver.my_row_starts;
+  const std::vector<int> & row_columns = my_solver.my_row_columns;
+  const std::vector<int> & column_starts = my_solver.my_column_starts;
+  const std::vector<int> & column_rows = my_solver.my_column_rows;
+  while ( true ) {
+    if ( prunable( node.bound ) ) {
+      --my_open;
+      return;
+    }
+    long count = ++my_nodes;
+    if ( my_stop
+         || (my_solver.my_node_limit > 0 && count > my_solver.my_node_limit)
+         || ClockTimer::wallClock() > my_deadline ) {
+      // keep the node, so that its bound counts for the best bound
+      --my_nodes;
+      my_stop = true;
+      push( worker, node );
+      return;
+    }
+    ++scratch.since_best;
+    std::shared_ptr< std::vector<double> > duals;
+    bool alive = evaluate( node, scratch, duals );
+    if ( count == 1 ) {
+      my_solver.my_root_bound = alive && ! scratch.uncovered.empty()
+        ? node.bound : std::min( node.bound, double( my_best ) );
+      my_root_done = true;
+    }
+    if ( ! alive ) {
+      --my_open;
+      return;
+    }
+    if ( scratch.uncovered.empty() ) {
+      leaf( node, scratch );
+      --my_open;
+      return;
+    }
+
+    // branch on the uncovered row with the fewest free columns
+    int row = -1;
+    for ( size_t r = 0; r < scratch.uncovered.size(); ++r ) {
+      int i = scratch.uncovered[r];
+      if ( row < 0 || scratch.free_count[i] < scratch.free_count[row] ) row = i;
+    }
+    std::vector<int> branch;
+    for ( int k = row_starts[row]; k < row_starts[row + 1]; ++k ) {
+      if ( ! test_bit( node.excluded, row_columns[k] ) ) {
+        branch.push_back( row_columns[k] );
+      }
+    }
+    const std::vector<double> & reduced = scratch.reduced;
+    std::sort( branch.begin(), branch.end(), [&reduced]( int a, int b ) {
+        return reduced[a] < reduced[b] || (reduced[a] == reduced[b] && a < b);
+      } );
+    std::vector<Node> children;
+    std::shared_ptr< const std::vector<double> > shared_duals( duals );
+    std::vector<uint64_t> excluded( node.excluded );
+    for ( size_t t = 0; t < branch.size(); ++t ) {
+      int j = branch[t];
+      double bound = node.bound + std::max( reduced[j], 0.0 );
+      if ( ! prunable( bound ) ) {
+        Node child;
+        child.covered = node.covered;
+        for ( int k = column_starts[j]; k < column_starts[j + 1]; ++k ) {
+          set_bit( child.covered, column_rows[k] );
+        }
+        child.excluded = excluded;
+        child.chosen = node.chosen;
+        child.chosen.push_back( j );
+        child.cost = node.cost + my_solver.my_costs[j];
+        child.bound = bound;
+        child.duals = shared_duals;
+        children.push_back( std::move( child ) );
+      }
+      set_bit( excluded, j );
+    }
+    my_open += children.size();
+    --my_open;
+    if ( children.empty() ) return;
+    for ( size_t t = children.size(); t-- > 1; ) push( worker, children[t] );
+    node = std::move( children[0] );
+  }
+}
+
+bool
+CoverSolver::Search::countFree( const Node & node, Scratch & scratch )
+{
+  const std::vector<int> & row_starts = my_solver.my_row_starts;
+  const std::vector<int> & row_columns = my_solver.my_row_columns;
+  for ( size_t r = 0; r < scratch.uncovered.size(); ++r ) {
+    int i = scratch.uncovered[r];
+    int count = 0;
+    for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+      if ( ! test_bit( node.excluded, row_columns[k] ) ) ++count;
+    }
+    if ( count == 0 ) return false;
+    scratch.free_count[i] = count;
+  }
+  return true;
+}
+
+bool
+CoverSolver::Search::evaluate( Node & node, Scratch & scratch,
+                               std::shared_ptr< std::vector<double> > & duals )
+{
+  const std::vector<int> & row_starts = my_solver.my_row_starts;
+  const std::vector<int> & row_columns = my_solver.my_row_columns;
+  const std::vector<double> & costs = my_solver.my_costs;
+  scratch.uncovered.clear();
+  for ( int i = 0; i < my_rows; ++i ) {
+    if ( ! test_bit( node.covered, i ) ) scratch.uncovered.push_back( i );
+  }
+  if ( ! countFree( node, scratch ) ) return false;
+  if ( scratch.uncovered.empty() ) {
+    node.bound = node.cost;
+    return ! prunable( node.cost );
+  }
+  std::vector<int> & free_count = scratch.free_count;
+  std::sort( scratch.uncovered.begin(), scratch.uncovered.end(),
+             [&free_count]( int a, int b ) {
+               return free_count[a] < free_count[b]
+                 || (free_count[a] == free_count[b] && a < b);
+             } );
+
+  // start from the parent's duals on the rows still uncovered, then raise
+  // each row's dual as far as the reduced costs of its columns allow
+  std::vector<double> & reduced = scratch.reduced;
+  reduced = costs;
+  duals.reset( new std::vector<double>( my_rows, 0.0 ) );
+  std::vector<double> & u = *duals;
+  if ( node.duals ) {
+    for ( size_t r = 0; r < scratch.uncovered.size(); ++r ) {
+      int i = scratch.uncovered[r];
+      double parent = (*node.duals)[i];
+      if ( parent <= 0 ) continue;
+      u[i] = parent;
+      for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+        reduced[ row_columns[k] ] -= parent;
+      }
+    }
+  }
+  double bound = node.cost;
+  for ( size_t r = 0; r < scratch.uncovered.size(); ++r ) {
+    int i = scratch.uncovered[r];
+    double delta = std::numeric_limits<double>::infinity();
+    for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+      int j = row_columns[k];
+      if ( ! test_bit( node.excluded, j ) ) delta = std::min( delta, reduced[j] );
+    }
+    if ( delta > 0 ) {
+      u[i] += delta;
+      for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+        reduced[ row_columns[k] ] -= delta;
+      }
+    }
+    bound += u[i];
+  }
+  // rounding can leave reduced costs slightly negative; the bound stays
+  // valid if they are counted as well
+  for ( int j = 0; j < my_columns; ++j ) {
+    if ( reduced[j] < 0 && ! test_bit( node.excluded, j ) ) bound += reduced[j];
+  }
+  node.bound = std::max( node.bound, bound );
+  if ( prunable( node.bound ) ) return false;
+
+  // reduced cost fixing
+  bool fixed = false;
+  if ( my_best < std::numeric_limits<double>::infinity() ) {
+    for ( size_t r = 0; r < scratch.uncovered.size(); ++r ) {
+      int i = scratch.uncovered[r];
+      for ( int k = row_starts[i]; k < row_starts[i + 1]; ++k ) {
+        int j = row_columns[k];
+        if ( reduced[j] > 0 && ! test_bit( node.excluded, j )
+             && prunable( node.bound + reduced[j] ) ) {
+          set_bit( node.excluded, j );
+          fixed = true;
+        }
+      }
+    }
+  }
+  return ! fixed || countFree( node, scratch );
+}
+
+void
+CoverSolver::Search::leaf( Node & node, Scratch & scratch )
+{
+  const std::vector<int> & column_starts = my_solver.my_column_starts;
+  const std::vector<int> & column_rows = my_solver.my_column_rows;
+  const std::vector<double> & costs = my_solver.my_costs;
+
+  // drop columns whose rows are all covered twice, most expensive first
+  std::vector<int> & cover_count = scratch.cover_count;
+  std::fill( cover_count.begin(), cover_count.end(), 0 );
+  for ( size_t c = 0; c < node.chosen.size(); ++c ) {
+    int j = node.chosen[c];
+    for ( int k = column_starts[j]; k < column_starts[j + 1]; ++k ) {
+      ++cover_count[ column_rows[k] ];
+    }
+  }
+  std::sort( node.chosen.begin(), node.chosen.end(), [&costs]( int a, int b ) {
+      return costs[a] > costs[b] || (costs[a] == costs[b] && a < b);
+    } );
+  std::vector<int> kept;
+  double cost = 0;
+  for ( size_t c = 0; c < node.chosen.size(); ++c ) {
+    int j = node.chosen[c];
+    bool redundant = true;
+    for ( int k = column_starts[j]; k < column_starts[j + 1] && redundant;
+          ++k ) {
+      redundant = cover_count[ column_rows[k] ] > 1;
+    }
+    if ( redundant ) {
+      for ( int k = column_starts[j]; k < column_starts[j + 1]; ++k ) {
+        --cover_count[ column_rows[k] ];
+      }
+    }
+    else {
+      kept.push_back( j );
+      cost += costs[j];
+    }
+  }
+
+  std::lock_guard<std::mutex> guard( my_incumbent_lock );
+  if ( cost < my_best ) {
+    my_best = cost;
+    my_solver.my_has_incumbent = true;
+    my_solver.my_incumbent_cost = cost;
+    my_solver.my_incumbent = kept;
+  }
+}
+
+bool
+CoverSolver::Search::prunable( double bound ) const
+{
+  double best = my_best;
+  if ( best == std::numeric_limits<double>::infinity() ) return false;
+  if ( my_solver.my_integral_costs ) return bound > best - 1 + 1e-6;
+  return bound >= best - 1e-9 * std::max( 1.0, std::fabs( best ) );
+}
+
+const char *
+CoverSolver::statusName( Status status )
+{
+  switch ( status ) {
+  case OPTIMAL: return "Optimal";
+  case INFEASIBLE: return "Infeasible";
+  case TIME_LIMIT: return "AbortTimeLim";
+  case NODE_LIMIT_FEASIBLE: return "NodeLimFeas";
+  case NODE_LIMIT_INFEASIBLE: return "NodeLimInfeas";
+  }
+  return "Unknown";
+}
+
+CoverSolver::CoverSolver( const LpModel & model ):
+  my_model( model ), my_time_limit( 3600 ), my_node_limit( 0 ),
+  my_threads( 0 ), my_sign( 1 ), my_fixed_cost( 0 ),
+  my_integral_costs( true ), my_has_incumbent( false ),
+  my_incumbent_cost( 0 ), my_status( INFEASIBLE ),
+  my_solution_found( false ), my_value( 0 ), my_best_bound( 0 ),
+  my_root_bound( 0 ), my_nodes( 0 ), my_nodes_stolen( 0 ),
+  my_threads_used( 0 ), my_time( 0 )
+{
+  setUp();
+}
+
+bool
+CoverSolver::setUp()
+{
+  if ( CoverReduction::classify( my_model ) != CoverReduction::COVERING ) {
+    return fail( "not a set covering model (binary columns, rows"
+                 " sum x_j >= 1)" );
+  }
+  int number_of_rows = my_model.numberOfRows();
+  int number_of_columns = my_model.numberOfColumns();
+  my_sign = my_model.minimize() ? 1 : -1;
+  my_fixed_to_one.assign( number_of_columns, 0 );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    double cost = my_sign * my_model.objectiveCoefficient( j );
+    if ( cost <= 0 ) {
+      my_fixed_to_one[j] = 1;
+      my_fixed_cost += cost;
+    }
+  }
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  std::vector<int> problem_column( number_of_columns, -1 );
+  my_row_starts.assign( 1, 0 );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    bool covered = false;
+    for ( int k = my_model.rowBegin( i ); k < my_model.rowEnd( i ) && ! covered;
+          ++k ) {
+      covered = my_fixed_to_one[ row_columns[k] ];
+    }
+    if ( covered ) continue;
+    for ( int k = my_model.rowBegin( i ); k < my_model.rowEnd( i ); ++k ) {
+      int j = row_columns[k];
+      if ( problem_column[j] < 0 ) {
+        problem_column[j] = my_costs.size();
+        my_original_columns.push_back( j );
+        double cost = my_sign * my_model.objectiveCoefficient( j );
+        my_costs.push_back( cost );
+        if ( cost != std::floor( cost ) ) my_integral_costs = false;
+      }
+      my_row_columns.push_back( problem_column[j] );
+    }
+    my_row_starts.push_back( my_row_columns.size() );
+  }
+  std::vector<int> degree( my_costs.size() + 1, 0 );
+  for ( size_t k = 0; k < my_row_columns.size(); ++k ) {
+    ++degree[ my_row_columns[k] + 1 ];
+  }
+  my_column_starts.assign( my_costs.size() + 1, 0 );
+  for ( size_t j = 0; j < my_costs.size(); ++j ) {
+    my_column_starts[j + 1] = my_column_starts[j] + degree[j + 1];
+  }
+  my_column_rows.resize( my_row_columns.size() );
+  std::vector<int> next( my_column_starts.begin(), my_column_starts.end() - 1 );
+  for ( size_t i = 0; i + 1 < my_row_starts.size(); ++i ) {
+    for ( int k = my_row_starts[i]; k < my_row_starts[i + 1]; ++k ) {
+      my_column_rows[ next[ my_row_columns[k] ]++ ] = i;
+    }
+  }
+  return true;
+}
+
+bool
+CoverSolver::setIncumbent( const std::vector<double> & values )
+{
+  if ( ! my_error_message.empty() ) return false;
+  double cost = internalCost( values );
+  if ( cost < 0 ) return false;
+  if ( my_has_incumbent && cost >= my_incumbent_cost ) return true;
+  my_has_incumbent = true;
+  my_incumbent_cost = cost;
+  my_incumbent.clear();
+  for ( size_t p = 0; p < my_original_columns.size(); ++p ) {
+    if ( values[ my_original_columns[p] ] > 0.5 ) my_incumbent.push_back( p );
+  }
+  return true;
+}
+
+double
+CoverSolver::internalCost( const std::vector<double> & values ) const
+{
+  if ( values.size() != my_fixed_to_one.size() ) return -1;
+  double cost = 0;
+  for ( size_t i = 0; i + 1 < my_row_starts.size(); ++i ) {
+    bool covered = false;
+    for ( int k = my_row_starts[i]; k < my_row_starts[i + 1] && ! covered;
+          ++k ) {
+      covered = values[ my_original_columns[ my_row_columns[k] ] ] > 0.5;
+    }
+    if ( ! covered ) return -1;
+  }
+  for ( size_t p = 0; p < my_original_columns.size(); ++p ) {
+    if ( values[ my_original_columns[p] ] > 0.5 ) cost += my_costs[p];
+  }
+  return cost;
+}
+
+double
+CoverSolver::external( double internal_cost ) const
+{
+  return my_sign * (my_fixed_cost + internal_cost) + my_model.objectiveOffset();
+}
+
+bool
+CoverSolver::solve()
+{
+  double start = ClockTimer::wallClock();
+  if ( ! my_error_message.empty() ) return false;
+  my_threads_used = my_threads;
+  if ( my_threads_used == 0 ) {
+    my_threads_used = std::max( std::thread::hardware_concurrency(), 1u );
+  }
+
+  bool empty_row = false;
+  for ( size_t i = 0; i + 1 < my_row_starts.size(); ++i ) {
+    if ( my_row_starts[i] == my_row_starts[i + 1] ) empty_row = true;
+  }
+  bool stopped = false;
+  double bound = std::numeric_limits<double>::infinity();
+  if ( empty_row ) {
+    my_has_incumbent = false;
+  }
+  else {
+    Search search( *this );
+    search.run( my_threads_used, start + my_time_limit );
+    my_nodes = search.my_nodes;
+    my_nodes_stolen = search.my_stolen;
+    stopped = search.my_stop;
+    if ( stopped ) {
+      for ( size_t w = 0; w < search.my_pools.size(); ++w ) {
+        const std::deque<Search::Node> & nodes = search.my_pools[w]->nodes;
+        for ( size_t n = 0; n < nodes.size(); ++n ) {
+          bound = std::min( bound, nodes[n].bound );
+        }
+      }
+    }
+    if ( ! search.my_root_done ) my_root_bound = bound;
+  }
+
+  my_solution_found = my_has_incumbent;
+  if ( my_has_incumbent ) bound = std::min( bound, my_incumbent_cost );
+  if ( ! stopped ) {
+    my_status = my_has_incumbent ? OPTIMAL : INFEASIBLE;
+  }
+  else if ( my_node_limit > 0 && my_nodes >= my_node_limit ) {
+    my_status = my_has_incumbent ? NODE_LIMIT_FEASIBLE : NODE_LIMIT_INFEASIBLE;
+  }
+  else my_status = TIME_LIMIT;
+  my_best_bound = bound < std::numeric_limits<double>::infinity()
+    ? external( bound ) : my_sign * bound;
+  my_root_bound = my_root_bound < std::numeric_limits<double>::infinity()
+    ? external( my_root_bound ) : my_sign * my_root_bound;
+
+  my_values.assign( my_fixed_to_one.size(), 0 );
+  if ( my_has_incumbent ) {
+    for ( size_t j = 0; j < my_fixed_to_one.size(); ++j ) {
+      if ( my_fixed_to_one[j] ) my_values[j] = 1;
+    }
+    for ( size_t c = 0; c < my_incumbent.size(); ++c ) {
+      my_values[ my_original_columns[ my_incumbent[c] ] ] = 1;
+    }
+    my_value = external( my_incumbent_cost );
+  }
+  my_time = ClockTimer::wallClock() - start;
+  return true;
+}
+
+bool
+CoverSolver::fail( const std::string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+//  [Last modified: 2026 10 18 at 01:12:30 GMT]
@@ -0,0 +1,134 @@
+/**
+ * @file CoverSolver.h
+ * @brief Native branch and bound for set covering models (-engine=native),
+ * for runs without CPLEX
+ *
+ * Columns that cost nothing (or gain something) are set to 1 first. A
+ * node of the search fixes some columns to 1 -- the rows they cover are
+ * kept as a bitset -- and others to 0. Its lower bound comes from a
+ * feasible solution of the dual of the LP relaxation, built greedily:
+ * each uncovered row, fewest free columns first, gets the least reduced
+ * cost of its free columns as its dual value. The duals of a node start
+ * from those of its parent, which remain feasible for the children, so
+ * bounds are built up incrementally. Columns whose reduced cost would take
+ * the bound past the incumbent are set to 0 (reduced cost fixing).
+ *
+ * Branching is on the uncovered row with the fewest free columns
+ * j_1, ..., j_k, ordered by reduced cost: child t sets j_t to 1 and
+ * j_1, ..., j_{t-1} to 0. Every level covers at least one more row, so the
+ * depth is bounded by the number of rows. Each worker dives depth first,
+ * into the child with the least reduced cost, and keeps the other children
+ * in a deque of its own; every so often it ends the dive and takes the
+ * node with the least bound from its deque instead (best bound), and a
+ * worker that runs out of nodes steals the oldest node of another.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef COVERSOLVER_H
+#define COVERSOLVER_H
+
+#include<string>
+#include<vector>
+#include"LpModel.h"
+
+/// Usage:
+///   CoverSolver solver(model);
+///   solver.setTimeLimit(60);  solver.setThreads(4);
+///   if ( ! solver.solve() ) error(solver.errorMessage());
+///   ... solver.status(), solver.value(), solver.values()
+class CoverSolver {
+public:
+  /// the names are those CPLEX prints for its corresponding status
+  enum Status { OPTIMAL, INFEASIBLE, TIME_LIMIT, NODE_LIMIT_FEASIBLE,
+                NODE_LIMIT_INFEASIBLE };
+  static const char * statusName( Status status );
+
+  explicit CoverSolver( const LpModel & model );
+
+  void setTimeLimit( double seconds ) { my_time_limit = seconds; }
+  /// 0 = no limit
+  void setNodeLimit( long nodes ) { my_node_limit = nodes; }
+  /// 0 = one per core
+  void setThreads( unsigned threads ) { my_threads = threads; }
+  /// starts from a solution (a value per column of the model), if it is
+  /// feasible
+  /// @return true if it is
+  bool setIncumbent( const std::vector<double> & values );
+
+  /// @return false if the model is not a set covering model (see
+  /// errorMessage())
+  bool solve();
+
+  Status status() const { return my_status; }
+  bool solutionFound() const { return my_solution_found; }
+  bool provedOptimal() const {
+    return my_status == OPTIMAL || my_status == INFEASIBLE;
+  }
+  /// objective value, offset included
+  double value() const { return my_value; }
+  /// 0/1 value of each column of the model
+  const std::vector<double> & values() const { return my_values; }
+  /// bound on the objective value: the least bound of the open nodes when
+  /// the search stopped, the value itself if it finished
+  double bestBound() const { return my_best_bound; }
+  double rootBound() const { return my_root_bound; }
+  long nodes() const { return my_nodes; }
+  long nodesStolen() const { return my_nodes_stolen; }
+  unsigned threadsUsed() const { return my_threads_used; }
+  double time() const { return my_time; }
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  class Search;
+  friend class Search;
+
+  /// sets up the reduced problem: rows not covered by columns set to 1,
+  /// and the columns that cost something
+  bool setUp();
+  /// internal cost of the original columns at 1 in values, -1 if they
+  /// don't cover every row
+  double internalCost( const std::vector<double> & values ) const;
+  /// @return the objective value of the original model for an internal
+  /// cost
+  double external( double internal_cost ) const;
+  bool fail( const std::string & message );
+
+  const LpModel & my_model;
+  double my_time_limit;
+  long my_node_limit;
+  unsigned my_threads;
+
+  // the reduced problem: minimize the sum of my_costs over chosen columns
+  // so that every row is covered
+  double my_sign;               // 1 to minimize, -1 to maximize
+  double my_fixed_cost;         // of the columns set to 1 at the start
+  bool my_integral_costs;
+  std::vector<int> my_original_columns;     // per column of the problem
+  std::vector<double> my_costs;
+  std::vector<int> my_row_starts;           // rows, CSR
+  std::vector<int> my_row_columns;
+  std::vector<int> my_column_starts;        // columns, CSC
+  std::vector<int> my_column_rows;
+  std::vector<char> my_fixed_to_one;        // per original column
+
+  bool my_has_incumbent;
+  double my_incumbent_cost;
+  std::vector<int> my_incumbent;            // columns of the problem
+
+  Status my_status;
+  bool my_solution_found;
+  double my_value;
+  std::vector<double> my_values;
+  double my_best_bound;
+  double my_root_bound;
+  long my_nodes;
+  long my_nodes_stolen;
+  unsigned my_threads_used;
+  double my_time;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 01:12:30 GMT]
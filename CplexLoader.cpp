@@ -0,0 +1,98 @@
+/// @file CplexLoader.cpp
+/// @brief bulk copy of an LpModel into Concert objects
+
+#include "CplexLoader.h"
+
+ILOSTLBEGIN
+
+/// sets the bounds of a range for row i of lp_model
+static void row_bounds( const LpModel & lp_model, int i, double & lower,
+                        double & upper )
+{
+  lower = -IloInfinity;
+  upper = IloInfinity;
+  switch ( lp_model.rowSense( i ) ) {
+  case LpModel::GREATER_EQUAL: lower = lp_model.rightHandSide( i ); break;
+  case LpModel::LESS_EQUAL: upper = lp_model.rightHandSide( i ); break;
+  default: lower = upper = lp_model.rightHandSide( i );
+  }
+}
+
+void loadModel( IloEnv env, const LpModel & lp_model, IloModel model,
+                IloObjective & obj, IloNumVarArray var, IloRangeArray rng,
+                const std::vector<char> * rows )
+{
+  const int number_of_columns = lp_model.numberOfColumns();
+  const int number_of_rows = lp_model.numberOfRows();
+
+  IloNumArray costs( env, number_of_columns );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    const char * name = lp_model.columnName( j ).c_str();
+    double lower = lp_model.lowerBound( j );
+    double upper = lp_model.upperBound( j );
+    switch ( lp_model.columnType( j ) ) {
+    case LpModel::BINARY:
+      var.add( IloNumVar( env, lower, upper, ILOBOOL, name ) );
+      break;
+    case LpModel::INTEGER:
+      var.add( IloNumVar( env, lower, upper, ILOINT, name ) );
+      break;
+    case LpModel::SEMICONTINUOUS:
+      var.add( IloSemiContVar( env, lower, upper, ILOFLOAT, name ) );
+      break;
+    default:
+      var.add( IloNumVar( env, lower, upper, ILOFLOAT, name ) );
+    }
+    costs[j] = lp_model.objectiveCoefficient( j );
+  }
+
+  obj = IloObjective( env, lp_model.objectiveOffset(),
+                      lp_model.minimize() ? IloObjective::Minimize
+                      : IloObjective::Maximize,
+                      lp_model.objectiveName().c_str() );
+  obj.setLinearCoefs( var, costs );
+  model.add( obj );
+  model.add( var );
+
+  // the per-row arrays are reused so that only the ranges themselves are
+  // allocated inside the loop
+  const std::vector<int> & columns = lp_model.rowColumns();
+  const std::vector<double> & values = lp_model.rowValues();
+  IloNumVarArray row_vars( env );
+  IloNumArray row_values( env );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    if ( rows && ! (*rows)[i] ) continue;
+    double lower, upper;
+    row_bounds( lp_model, i, lower, upper );
+    IloRange range( env, lower, upper, lp_model.rowName( i ).c_str() );
+    row_vars.clear();
+    row_values.clear();
+    for ( int k = lp_model.rowBegin( i ); k < lp_model.rowEnd( i ); ++k ) {
+      row_vars.add( var[ columns[k] ] );
+      row_values.add( values[k] );
+    }
+    range.setLinearCoefs( row_vars, row_values );
+    rng.add( range );
+  }
+  model.add( rng );
+
+  row_vars.end();
+  row_values.end();
+  costs.end();
+}
+
+IloRange rowRange( IloEnv env, const LpModel & lp_model, int i,
+                   const IloNumVarArray var )
+{
+  double lower, upper;
+  row_bounds( lp_model, i, lower, upper );
+  IloRange range( env, lower, upper, lp_model.rowName( i ).c_str() );
+  const std::vector<int> & columns = lp_model.rowColumns();
+  const std::vector<double> & values = lp_model.rowValues();
+  for ( int k = lp_model.rowBegin( i ); k < lp_model.rowEnd( i ); ++k ) {
+    range.setLinearCoef( var[ columns[k] ], values[k] );
+  }
+  return range;
+}
+
+//  [Last modified: 2026 10 18 at 03:24:10 GMT]
@@ -0,0 +1,30 @@
+/**
+ * @file CplexLoader.h
+ * @brief Copies an LpModel into a Concert model, as a replacement for
+ * IloCplex::importModel() when the file has already been parsed
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef CPLEXLOADER_H
+#define CPLEXLOADER_H
+
+#include <ilcplex/ilocplex.h>
+#include "LpModel.h"
+
+/// Fills model, obj, var and rng the same way importModel() would: one
+/// variable per column (in column order), one range per row, and the
+/// objective; everything is added to model. If rows is given, only the
+/// rows i with rows[i] nonzero are (-lazy_rows).
+void loadModel( IloEnv env, const LpModel & lp_model, IloModel model,
+                IloObjective & obj, IloNumVarArray var, IloRangeArray rng,
+                const std::vector<char> * rows = 0 );
+
+/// @return a range for row i of lp_model over var, to be ended by the
+/// caller
+IloRange rowRange( IloEnv env, const LpModel & lp_model, int i,
+                   const IloNumVarArray var );
+
+#endif
+
+//  [Last modified: 2026 10 18 at 03:24:10 GMT]
@@ -0,0 +1,190 @@
+/// @file Decompose.cpp
+/// @brief concurrent runs on the components of a model
+
+#include "Decompose.h"
+#include "SolutionFile.h"
+#include "WorkStealingPool.h"
+#include "ClockTimer.h"
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
+
+ILOSTLBEGIN
+
+/// seconds of the time limit when -time isn't given, as for a whole model
+static const int DEFAULT_TIME_LIMIT = 3600;
+
+/// flags that concern the whole model, not its components
+static const char * const WHOLE_MODEL_FLAGS[] = {
+  "decompose", "prereduce", "check", "verify", "write_sol",
+  "mipstart", "checkpoint", "checkpoint_every", "resume", "report",
+  "report_dir", "progress", "metrics", "features", "auto_params",
+  "portfolio", "cost", "UB", "sols", "parse_only", "cache", "lagrangian",
+  "lagrangian_stop", 0
+};
+
+/// fills the result of a run on component from its output
+static void parse_result( const LpModel & component, ComponentResult & result )
+{
+  result.status = outputTagValue( result.output, "StatusCode" );
+  // the status is printed after a placeholder _ (see solveInstance)
+  if ( ! result.status.empty() && result.status[0] == '_' ) {
+    result.status.erase( 0, 1 );
+  }
+  result.timed_out = outputTagValue( result.output, "TimedOut" ) == "1";
+  result.solution_found
+    = outputTagValue( result.output, "SolutionFound" ) == "1";
+  result.proved_optimal
+    = outputTagValue( result.output, "ProvedOptimal" ) == "1";
+  result.value = atof( outputTagValue( result.output, "value" ).c_str() );
+  result.cplex_time
+    = atof( outputTagValue( result.output, "CPXtime" ).c_str() );
+  result.branches
+    = atol( outputTagValue( result.output, "num_branches" ).c_str() );
+  result.iterations
+    = atol( outputTagValue( result.output, "iterations" ).c_str() );
+  result.frac_cuts
+    = atol( outputTagValue( result.output, "frac_cuts" ).c_str() );
+  result.clique_cuts
+    = atol( outputTagValue( result.output, "clique_cuts" ).c_str() );
+  result.cover_cuts
+    = atol( outputTagValue( result.output, "cover_cuts" ).c_str() );
+  if ( ! result.solution_found ) return;
+
+  SolutionFile solutions;
+  istringstream output_stream( result.output );
+  if ( ! solutions.read( output_stream, "component output" )
+       || solutions.numberOfSolutions() == 0 ) {
+    result.solution_found = false;
+    return;
+  }
+  // columns that aren't printed take the value closest to 0
+  result.values.resize( component.numberOfColumns() );
+  for ( int j = 0; j < component.numberOfColumns(); ++j ) {
+    result.values[j] = min( max( 0.0, component.lowerBound( j ) ),
+                            component.upperBound( j ) );
+  }
+  const StoredSolution & solution = solutions.solution( 0 );
+  for ( size_t i = 0; i < solution.values.size(); ++i ) {
+    int j = component.findColumn( solution.values[i].first );
+    if ( j >= 0 ) result.values[j] = solution.values[i].second;
+  }
+}
+
+void solveComponents( const CmdLine & command_line,
+                      InstanceSolver solve_instance,
+                      const string & file_name,
+                      const ModelDecomposition & decomposition,
+                      vector<ComponentResult> & results,
+                      unsigned & workers, unsigned & threads_per_component )
+{
+  const size_t number_of_components = decomposition.numberOfComponents();
+  results.assign( number_of_components, ComponentResult() );
+  batchResources( command_line, number_of_components, workers,
+                  threads_per_component );
+  CmdLine options( command_line );
+  for ( const char * const * flag = WHOLE_MODEL_FLAGS; *flag; ++flag ) {
+    options.removeFlag( *flag );
+  }
+  ostringstream threads_value;
+  threads_value << threads_per_component;
+  options.setFlag( "threads", threads_value.str() );
+  options.setFlag( "solution", "0" );
+  int time_limit = DEFAULT_TIME_LIMIT;
+  if ( command_line.flagPresent( "time" )
+       && command_line.intFlag( "time" ) > 0 ) {
+    time_limit = command_line.intFlag( "time" );
+  }
+  const double deadline = ClockTimer::wallClock() + time_limit;
+
+  vector<IloEnv> envs;
+  for ( unsigned w = 0; w < workers; ++w ) envs.push_back( IloEnv() );
+  WorkStealingPool pool( workers );
+  // components are largest first: deal them out round robin so that every
+  // worker starts with one of the large ones
+  for ( size_t c = 0; c < number_of_components; ++c ) {
+    pool.addTask( c % workers, c );
+  }
+  pool.run( [&]( unsigned worker, size_t c ) {
+      ComponentResult & result = results[c];
+      // -time takes whole seconds; a component with less than one left
+      // isn't started
+      int time_left = (int) ( deadline - ClockTimer::wallClock() );
+      if ( time_left < 1 ) {
+        result.status = "AbortTimeLim";
+        result.timed_out = true;
+        return;
+      }
+      CmdLine component_options( options );
+      ostringstream time_value;
+      time_value << time_left;
+      component_options.setFlag( "time", time_value.str() );
+      ostringstream output;
+      ClockTimer component_timer = ClockTimer();
+      component_timer.start();
+      result.exit_status = EXIT_FAILURE;
+      try {
+        result.exit_status
+          = solve_instance( envs[worker], component_options, file_name,
+                            &decomposition.component( c ), 0, output );
+      }
+      catch ( IloException & e ) {
+        output << "ERROR\t" << e.getMessage() << endl;
+        e.end();
+      }
+      catch ( ... ) {
+        output << "ERROR\tunexpected exception" << endl;
+      }
+      component_timer.stop();
+      result.runtime = component_timer.getTotalTime();
+      result.output = output.str();
+      parse_result( decomposition.component( c ), result );
+    } );
+  for ( unsigned w = 0; w < workers; ++w ) envs[w].end();
+}
+
+ComponentResult combineResults( const ModelDecomposition & decomposition,
+                                const vector<ComponentResult> & results )
+{
+  ComponentResult combined;
+  combined.status = "Optimal";
+  combined.solution_found = true;
+  combined.proved_optimal = true;
+  bool infeasible = false;
+  vector< vector<double> > values( results.size() );
+  for ( size_t c = 0; c < results.size(); ++c ) {
+    const ComponentResult & result = results[c];
+    if ( result.exit_status != 0 ) combined.exit_status = result.exit_status;
+    combined.timed_out = combined.timed_out || result.timed_out;
+    combined.runtime = max( combined.runtime, result.runtime );
+    combined.value += result.value;
+    combined.cplex_time += result.cplex_time;
+    combined.branches += result.branches;
+    combined.iterations += result.iterations;
+    combined.frac_cuts += result.frac_cuts;
+    combined.clique_cuts += result.clique_cuts;
+    combined.cover_cuts += result.cover_cuts;
+    combined.solution_found = combined.solution_found && result.solution_found;
+    values[c] = result.values;
+    bool component_infeasible = result.status.compare( 0, 3, "Inf" ) == 0;
+    if ( component_infeasible && ! infeasible ) {
+      // one infeasible component makes the whole model infeasible
+      infeasible = true;
+      combined.status = result.status;
+      combined.proved_optimal = result.proved_optimal;
+    }
+    else if ( ! infeasible ) {
+      if ( result.status != "Optimal" && combined.status == "Optimal" ) {
+        combined.status = result.status;
+      }
+      combined.proved_optimal
+        = combined.proved_optimal && result.proved_optimal;
+    }
+  }
+  if ( infeasible ) combined.solution_found = false;
+  if ( combined.solution_found ) combined.values = decomposition.combine( values );
+  else combined.value = 0;
+  return combined;
+}
+
+//  [Last modified: 2026 10 18 at 08:27:45 GMT]
@@ -0,0 +1,79 @@
+/**
+ * @file Decompose.h
+ * @brief Solving the connected components of a model (see
+ * ModelDecomposition.h) as separate problems, several at a time
+ * (-decompose)
+ *
+ * Each component is solved by a run of its own, as in a sweep: workers on
+ * a WorkStealingPool, each with its own IloEnv, pass the component's
+ * LpModel to the instance solver with the options of the whole run (the
+ * largest components are started first). Options that concern the whole
+ * model -- its reports, solution files, checks, bounds and
+ * reductions -- are left out of the runs on components. The time limit
+ * is for the whole model: each component gets the time left until a
+ * deadline shared by all, and those not started by then count as timed
+ * out. The node limit applies to each component. The results are then
+ * put together:
+ * the value of the model is the sum of those of its components and its
+ * solution is the union of theirs.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef DECOMPOSE_H
+#define DECOMPOSE_H
+
+#include <string>
+#include <vector>
+#include "Batch.h"
+#include "ModelDecomposition.h"
+
+/// the result of the run on one component, or of the whole model
+struct ComponentResult {
+  ComponentResult(): exit_status( 0 ), timed_out( false ),
+                     solution_found( false ), proved_optimal( false ),
+                     value( 0 ), runtime( 0 ), cplex_time( 0 ),
+                     branches( 0 ), iterations( 0 ), frac_cuts( 0 ),
+                     clique_cuts( 0 ), cover_cuts( 0 ) {}
+  int exit_status;
+  std::string status;           // CPLEX status, as printed by StatusCode
+  bool timed_out;
+  bool solution_found;
+  bool proved_optimal;
+  double value;
+  double runtime;               // wall time of the run
+  // the counts of the run, as printed by CPXtime, num_branches, etc.
+  double cplex_time;
+  long branches;
+  long iterations;
+  long frac_cuts;
+  long clique_cuts;
+  long cover_cuts;
+  /// values of the columns of the component (of the model, once
+  /// combined), if a solution was found
+  std::vector<double> values;
+  std::string output;           // the tag/value output of the run
+};
+
+/// Solves each component of decomposition, whose model was read from
+/// file_name, with the options of command_line, using -workers concurrent
+/// runs with -threads CPLEX threads each (see batchResources()).
+void solveComponents( const CmdLine & command_line,
+                      InstanceSolver solve_instance,
+                      const std::string & file_name,
+                      const ModelDecomposition & decomposition,
+                      std::vector<ComponentResult> & results,
+                      unsigned & workers, unsigned & threads_per_component );
+
+/// @return the result for the whole model: its status is that of an
+/// infeasible component if there is one, Optimal if every component was
+/// solved to optimality and otherwise that of the first component that
+/// wasn't; a solution is found (optimality proved) if it is for every
+/// component; runtime is the largest runtime of a component, and the
+/// CPLEX time and the counts are sums over the components
+ComponentResult combineResults( const ModelDecomposition & decomposition,
+                                const std::vector<ComponentResult> & results );
+
+#endif
+
+//  [Last modified: 2026 10 18 at 08:27:45 GMT]
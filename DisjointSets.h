@@ -0,0 +1,60 @@
+/**
+ * @file DisjointSets.h
+ * @brief Union-find over the integers 0..n-1, with union by size and path
+ * halving, for finding connected components of a model
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef DISJOINTSETS_H
+#define DISJOINTSETS_H
+
+#include<vector>
+#include<utility>
+
+/// Usage:
+///   DisjointSets sets(n);
+///   sets.unite(a, b);
+///   if ( sets.find(a) == sets.find(c) ) ...
+///   sets.numberOfSets(), sets.setSize(x)
+class DisjointSets {
+public:
+  explicit DisjointSets( int n ): my_parent( n ), my_size( n, 1 ), my_sets( n ) {
+    for ( int i = 0; i < n; ++i ) my_parent[i] = i;
+  }
+
+  /// @return the representative of the set containing x
+  int find( int x ) {
+    while ( my_parent[x] != x ) {
+      my_parent[x] = my_parent[ my_parent[x] ];
+      x = my_parent[x];
+    }
+    return x;
+  }
+
+  /// merges the sets containing a and b
+  /// @return false if they were the same set already
+  bool unite( int a, int b ) {
+    a = find( a );
+    b = find( b );
+    if ( a == b ) return false;
+    if ( my_size[a] < my_size[b] ) std::swap( a, b );
+    my_parent[b] = a;
+    my_size[a] += my_size[b];
+    --my_sets;
+    return true;
+  }
+
+  int numberOfSets() const { return my_sets; }
+  /// number of elements in the set containing x
+  int setSize( int x ) { return my_size[ find( x ) ]; }
+
+private:
+  std::vector<int> my_parent;
+  std::vector<int> my_size;     // valid for representatives only
+  int my_sets;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 22:51:20 GMT]
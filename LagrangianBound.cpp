@@ -0,0 +1,300 @@
+/// @file LagrangianBound.cpp
+/// @brief subgradient optimization of the Lagrangian dual of all rows
+
+#include"LagrangianBound.h"
+#include"ClockTimer.h"
+#include"ThreadTeam.h"
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<thread>
+
+/// theta at the start, and the value at which the steps stop
+static const double INITIAL_THETA = 2;
+static const double MIN_THETA = 1e-4;
+
+/// steps without a better bound before theta is halved
+static const long HALVE_AFTER = 20;
+
+/// without a known upper bound, the target is this much (relative to the
+/// bound, at least 1 absolute) above the best bound so far
+static const double TARGET_MARGIN = 0.05;
+
+/// fewer nonzeros per thread are not worth a thread of their own
+static const int MIN_NONZEROS_PER_THREAD = 50000;
+
+static const double INFINITE = std::numeric_limits<double>::infinity();
+
+/// sum of values[k] * x[columns[k]] for k < length; four independent sums
+/// so that the loads of x can overlap (and the loop be vectorized)
+static inline double sparse_dot( const int * columns, const double * values,
+                                 const double * x, int length )
+{
+  double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+  int k = 0;
+  for ( ; k + 4 <= length; k += 4 ) {
+    sum0 += values[k] * x[ columns[k] ];
+    sum1 += values[k + 1] * x[ columns[k + 1] ];
+    sum2 += values[k + 2] * x[ columns[k + 2] ];
+    sum3 += values[k + 3] * x[ columns[k + 3] ];
+  }
+  for ( ; k < length; ++k ) sum0 += values[k] * x[ columns[k] ];
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+static bool is_integral( double value )
+{
+  return std::fabs( value - std::floor( value + 0.5 ) ) < 1e-9;
+}
+
+LagrangianBound::LagrangianBound( const LpModel & model ):
+  my_model( model ),
+  my_threads( 0 ),
+  my_sign( model.minimize() ? 1 : -1 ),
+  my_has_upper_bound( false ),
+  my_upper_bound( 0 ),
+  my_integral_objective( is_integral( model.objectiveOffset() ) ),
+  my_bound_found( false ),
+  my_bound( -my_sign * INFINITE ),
+  my_initial_bound( -my_sign * INFINITE ),
+  my_reached_upper_bound( false ),
+  my_iterations( 0 ),
+  my_threads_used( 0 ),
+  my_time( 0 )
+{
+  const int number_of_rows = model.numberOfRows();
+  const int number_of_columns = model.numberOfColumns();
+  const std::vector<int> & row_columns = model.rowColumns();
+  my_row_values = model.rowValues();
+  my_rhs = model.rightHandSides();
+  my_free.assign( number_of_rows, 0 );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    if ( model.rowSense( i ) == LpModel::EQUAL ) my_free[i] = 1;
+    if ( model.rowSense( i ) != LpModel::LESS_EQUAL ) continue;
+    my_rhs[i] = -my_rhs[i];
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      my_row_values[k] = -my_row_values[k];
+    }
+  }
+
+  my_column_starts.assign( number_of_columns + 1, 0 );
+  for ( size_t k = 0; k < row_columns.size(); ++k ) {
+    ++my_column_starts[ row_columns[k] + 1 ];
+  }
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    my_column_starts[j + 1] += my_column_starts[j];
+  }
+  my_column_rows.resize( row_columns.size() );
+  my_column_values.resize( row_columns.size() );
+  std::vector<int> next( my_column_starts.begin(), my_column_starts.end() - 1 );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      int position = next[ row_columns[k] ]++;
+      my_column_rows[position] = i;
+      my_column_values[position] = my_row_values[k];
+    }
+  }
+
+  my_costs.resize( number_of_columns );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    double cost = model.objectiveCoefficient( j );
+    my_costs[j] = my_sign * cost;
+    if ( cost != 0 && ( ! model.isInteger( j ) || ! is_integral( cost ) ) ) {
+      my_integral_objective = false;
+    }
+  }
+}
+
+void
+LagrangianBound::setUpperBound( double value )
+{
+  my_has_upper_bound = true;
+  my_upper_bound = my_sign * ( value - my_model.objectiveOffset() );
+}
+
+double
+LagrangianBound::roundedBound() const
+{
+  if ( ! my_integral_objective || ! my_bound_found ) return my_bound;
+  if ( my_sign > 0 ) return std::ceil( my_bound - 1e-6 );
+  return std::floor( my_bound + 1e-6 );
+}
+
+double
+LagrangianBound::columnPass( int first, int last )
+{
+  double sum = 0;
+  bool infinite = false;
+  for ( int j = first; j < last; ++j ) {
+    double reduced_cost = my_costs[j];
+    for ( int k = my_column_starts[j]; k < my_column_starts[j + 1]; ++k ) {
+      reduced_cost -= my_column_values[k] * my_y[ my_column_rows[k] ];
+    }
+    double lower = my_model.lowerBound( j );
+    double upper = my_model.upperBound( j );
+    bool lower_finite = lower > -LP_INFINITY;
+    bool upper_finite = upper < LP_INFINITY;
+    double x;
+    if ( reduced_cost > 0 ) {
+      // with no lower bound, L is -infinity; x is a step along the ray,
+      // which still gives the subgradient its direction
+      if ( lower_finite ) x = lower;
+      else {
+        infinite = true;
+        x = ( upper_finite ? std::min( upper, 0.0 ) : 0.0 ) - 1;
+      }
+    }
+    else if ( reduced_cost < 0 ) {
+      if ( upper_finite ) x = upper;
+      else {
+        infinite = true;
+        x = ( lower_finite ? std::max( lower, 0.0 ) : 0.0 ) + 1;
+      }
+    }
+    else {
+      x = lower_finite ? lower : ( upper_finite ? upper : 0.0 );
+    }
+    my_x[j] = x;
+    sum += reduced_cost * x;
+  }
+  return infinite ? -INFINITE : sum;
+}
+
+double
+LagrangianBound::rowPass( int first, int last, double & norm )
+{
+  const std::vector<int> & row_starts = my_model.rowStarts();
+  const int * row_columns = my_model.rowColumns().data();
+  const double * row_values = my_row_values.data();
+  const double * x = my_x.data();
+  double sum = 0;
+  norm = 0;
+  for ( int i = first; i < last; ++i ) {
+    int begin = row_starts[i];
+    double g = my_rhs[i] - sparse_dot( row_columns + begin, row_values + begin,
+                                       x, row_starts[i + 1] - begin );
+    // projected: a multiplier at 0 can't go below
+    if ( ! my_free[i] && my_y[i] <= 0 && g < 0 ) g = 0;
+    my_subgradient[i] = g;
+    norm += g * g;
+    sum += my_y[i] * my_rhs[i];
+  }
+  return sum;
+}
+
+std::vector<int>
+LagrangianBound::split( const std::vector<int> & starts, unsigned parts )
+{
+  const int size = starts.size() - 1;
+  std::vector<int> bounds( parts + 1, size );
+  bounds[0] = 0;
+  int next = 0;
+  for ( unsigned p = 1; p < parts; ++p ) {
+    double target = starts[size] * static_cast<double>( p ) / parts;
+    while ( next < size && starts[next] < target ) ++next;
+    bounds[p] = next;
+  }
+  return bounds;
+}
+
+bool
+LagrangianBound::run( double time_limit )
+{
+  double start_time = ClockTimer::wallClock();
+  double deadline = start_time + time_limit;
+  const int number_of_rows = my_model.numberOfRows();
+  const int number_of_columns = my_model.numberOfColumns();
+
+  unsigned threads = my_threads;
+  if ( threads == 0 ) threads = std::max( std::thread::hardware_concurrency(), 1u );
+  threads = std::min<unsigned>( threads, my_model.numberOfNonZeros()
+                                / MIN_NONZEROS_PER_THREAD + 1 );
+  my_threads_used = threads;
+  std::vector<int> column_parts = split( my_column_starts, threads );
+  std::vector<int> row_parts = split( my_model.rowStarts(), threads );
+  std::vector<double> column_sums( threads );
+  std::vector<double> row_sums( threads );
+  std::vector<double> norms( threads );
+
+  my_y.assign( number_of_rows, 0 );
+  my_x.assign( number_of_columns, 0 );
+  my_subgradient.assign( number_of_rows, 0 );
+  std::vector<double> best_y( my_y );
+  double best = -INFINITE;
+  double theta = INITIAL_THETA;
+  long since_improvement = 0;
+  double step = 0;
+  my_iterations = 0;
+  my_reached_upper_bound = false;
+
+  ThreadTeam team( threads );
+  while ( true ) {
+    team.run( [&]( unsigned p ) {
+        column_sums[p] = columnPass( column_parts[p], column_parts[p + 1] );
+      } );
+    team.run( [&]( unsigned p ) {
+        row_sums[p] = rowPass( row_parts[p], row_parts[p + 1], norms[p] );
+      } );
+    ++my_iterations;
+    double value = 0;
+    double norm = 0;
+    for ( unsigned p = 0; p < threads; ++p ) {
+      value += column_sums[p] + row_sums[p];
+      norm += norms[p];
+    }
+    if ( my_iterations == 1 && value > -INFINITE ) {
+      my_initial_bound = my_sign * value + my_model.objectiveOffset();
+    }
+    if ( value > best ) {
+      best = value;
+      best_y = my_y;
+      since_improvement = 0;
+    }
+    else ++since_improvement;
+
+    if ( my_has_upper_bound && best > -INFINITE ) {
+      double reached = my_integral_objective ? std::ceil( best - 1e-6 ) : best;
+      if ( reached >= my_upper_bound
+           - 1e-9 * std::max( 1.0, std::fabs( my_upper_bound ) ) ) {
+        my_reached_upper_bound = true;
+        break;
+      }
+    }
+    // a zero subgradient: x(y) is feasible and y is optimal
+    if ( norm == 0 ) break;
+    if ( since_improvement >= HALVE_AFTER ) {
+      theta /= 2;
+      since_improvement = 0;
+    }
+    if ( theta < MIN_THETA || ClockTimer::wallClock() >= deadline ) break;
+
+    double base = best > -INFINITE ? best : 0;
+    double target = my_has_upper_bound ? my_upper_bound
+      : base + TARGET_MARGIN * std::max( 1.0, std::fabs( base ) );
+    double gap = value > -INFINITE ? target - value
+      : TARGET_MARGIN * std::max( 1.0, std::fabs( base ) );
+    step = theta * std::max( gap, 0.0 ) / norm;
+    if ( step == 0 ) break;
+    team.run( [&]( unsigned p ) {
+        for ( int i = row_parts[p]; i < row_parts[p + 1]; ++i ) {
+          double y = my_y[i] + step * my_subgradient[i];
+          my_y[i] = my_free[i] || y > 0 ? y : 0;
+        }
+      } );
+  }
+
+  my_bound_found = best > -INFINITE;
+  my_bound = my_bound_found ? my_sign * best + my_model.objectiveOffset()
+    : -my_sign * INFINITE;
+  my_multipliers.resize( number_of_rows );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    // back to the sense of the row, and of the objective
+    double y = best_y[i];
+    if ( my_model.rowSense( i ) == LpModel::LESS_EQUAL ) y = -y;
+    my_multipliers[i] = my_sign * y;
+  }
+  my_time = ClockTimer::wallClock() - start_time;
+  return my_bound_found;
+}
+
+//  [Last modified: 2026 10 18 at 07:40:05 GMT]
@@ -0,0 +1,117 @@
+/**
+ * @file LagrangianBound.h
+ * @brief Bound on the objective value by Lagrangian relaxation of all rows
+ * (-lagrangian), without solving an LP
+ *
+ * For a minimization model min cx, Ax (>=, <=, =) b, l <= x <= u, and
+ * multipliers y -- y_i >= 0 for a >= row, <= 0 for a <= row, free for an
+ * equation -- L(y) = yb + sum_j min over l_j <= x_j <= u_j of
+ * (c_j - yA_j) x_j is a lower bound on the value of every solution, even
+ * of the LP relaxation: each column simply goes to the bound its reduced
+ * cost points to. L is maximized over y by projected subgradient steps
+ * y += t (b - Ax(y)), with the step length of Polyak, t = theta (T - L(y))
+ * / |b - Ax(y)|^2, for a target T: a known objective value if there is
+ * one, else a little above the best bound so far. theta is halved when
+ * the bound has not improved for a while. A maximization model is handled
+ * as the minimization of -cx, so that the bound is an upper bound.
+ *
+ * Each step is two sparse matrix-vector products, one over the columns
+ * (reduced costs) and one over the rows (subgradient); both are split
+ * among a team of threads, the rows and columns in ranges of about the
+ * same number of nonzeros.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef LAGRANGIANBOUND_H
+#define LAGRANGIANBOUND_H
+
+#include<string>
+#include<vector>
+#include"LpModel.h"
+
+/// Usage:
+///   LagrangianBound lagrangian( model );
+///   lagrangian.setUpperBound( value_of_a_known_solution );  // optional
+///   lagrangian.setThreads( 4 );
+///   if ( lagrangian.run( time_limit ) ) ... lagrangian.bound()
+class LagrangianBound {
+public:
+  explicit LagrangianBound( const LpModel & model );
+
+  /// objective value of a known solution (of a minimization model; of a
+  /// maximization model, it is a lower bound): the target of the steps,
+  /// and the search stops if the bound reaches it
+  void setUpperBound( double value );
+  /// 0 = one per core
+  void setThreads( unsigned threads ) { my_threads = threads; }
+
+  /// steps for at most time_limit seconds
+  /// @return true if a finite bound was found
+  bool run( double time_limit );
+
+  bool boundFound() const { return my_bound_found; }
+  /// lower bound on the objective value (upper bound when maximizing),
+  /// offset included
+  double bound() const { return my_bound; }
+  /// the bound rounded to the next integer that can be the value of a
+  /// solution, if the objective only takes integral values
+  double roundedBound() const;
+  bool integralObjective() const { return my_integral_objective; }
+  /// the bound with all multipliers 0
+  double initialBound() const { return my_initial_bound; }
+  /// multiplier of each row at the best bound, with the signs of the LP
+  /// duals
+  const std::vector<double> & multipliers() const { return my_multipliers; }
+  /// true if the bound reached the known upper bound
+  bool reachedUpperBound() const { return my_reached_upper_bound; }
+  long iterations() const { return my_iterations; }
+  unsigned threadsUsed() const { return my_threads_used; }
+  double time() const { return my_time; }
+
+private:
+  /// computes the reduced costs of a range of columns and their minimizing
+  /// values x
+  /// @return the sum of (c_j - yA_j) x_j, or -infinity
+  double columnPass( int first, int last );
+  /// computes the subgradient b - Ax of a range of rows
+  /// @return the sum of y_i b_i
+  double rowPass( int first, int last, double & norm );
+  /// splits 0 .. starts.size() - 1 into parts of about the same number of
+  /// nonzeros
+  static std::vector<int> split( const std::vector<int> & starts,
+                                 unsigned parts );
+
+  const LpModel & my_model;
+  unsigned my_threads;
+  double my_sign;                       // 1 to minimize, -1 to maximize
+  bool my_has_upper_bound;
+  double my_upper_bound;                // internal: sign * (value - offset)
+  bool my_integral_objective;
+
+  // rows as >= or = rows, i.e., those of a <= row negated
+  std::vector<double> my_row_values;
+  std::vector<double> my_rhs;
+  std::vector<char> my_free;            // an equation: y_i free
+  std::vector<int> my_column_starts;    // columns, CSC
+  std::vector<int> my_column_rows;
+  std::vector<double> my_column_values;
+  std::vector<double> my_costs;         // sign * c
+
+  std::vector<double> my_y;
+  std::vector<double> my_x;
+  std::vector<double> my_subgradient;
+
+  bool my_bound_found;
+  double my_bound;
+  double my_initial_bound;
+  std::vector<double> my_multipliers;
+  bool my_reached_upper_bound;
+  long my_iterations;
+  unsigned my_threads_used;
+  double my_time;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 01:57:20 GMT]
@@ -0,0 +1,129 @@
+/// @file LazyRowPool.cpp
+/// @brief initial rows and separation of violated rows for -lazy_rows
+
+#include"LazyRowPool.h"
+#include"CoverReduction.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<cmath>
+
+LazyRowPool::LazyRowPool( const LpModel & model ):
+  my_model( model ),
+  my_covering( CoverReduction::classify( model ) == CoverReduction::COVERING ),
+  my_loaded( model.numberOfRows(), 0 ),
+  my_returned( model.numberOfRows(), 0 ),
+  my_initial_rows( 0 ),
+  my_rows_returned( 0 ),
+  my_separations( 0 ),
+  my_separation_time( 0 )
+{
+}
+
+/// orders rows by decreasing length
+struct LongerRow {
+  const LpModel * model;
+  bool operator()( int a, int b ) const {
+    int length_a = model->rowEnd( a ) - model->rowBegin( a );
+    int length_b = model->rowEnd( b ) - model->rowBegin( b );
+    return length_a > length_b || ( length_a == length_b && a < b );
+  }
+};
+
+void
+LazyRowPool::selectInitialRows()
+{
+  const int number_of_rows = my_model.numberOfRows();
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  std::vector<int> order( number_of_rows );
+  for ( int i = 0; i < number_of_rows; ++i ) order[i] = i;
+  LongerRow longer = { &my_model };
+  std::sort( order.begin(), order.end(), longer );
+
+  // a row is taken if it has a column that no row taken before has; rows
+  // that are not >= rows (or that have no columns) are always taken
+  std::vector<char> column_in_row( my_model.numberOfColumns(), 0 );
+  my_initial_rows = 0;
+  for ( int t = 0; t < number_of_rows; ++t ) {
+    int i = order[t];
+    bool take = my_model.rowSense( i ) != LpModel::GREATER_EQUAL
+      || my_model.rowBegin( i ) == my_model.rowEnd( i );
+    for ( int k = my_model.rowBegin( i ); k < my_model.rowEnd( i ); ++k ) {
+      if ( ! column_in_row[ row_columns[k] ] ) {
+        take = true;
+        column_in_row[ row_columns[k] ] = 1;
+      }
+    }
+    if ( take && ! my_loaded[i] ) {
+      my_loaded[i] = 1;
+      ++my_initial_rows;
+    }
+  }
+}
+
+bool
+LazyRowPool::violated( int row, const std::vector<double> & x,
+                       double tolerance,
+                       const std::vector<uint64_t> & ones ) const
+{
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  if ( ! ones.empty() ) {
+    for ( int k = my_model.rowBegin( row ); k < my_model.rowEnd( row ); ++k ) {
+      int j = row_columns[k];
+      if ( ones[j >> 6] >> (j & 63) & 1 ) return false;
+    }
+    return true;
+  }
+  const std::vector<double> & row_values = my_model.rowValues();
+  double activity = 0;
+  for ( int k = my_model.rowBegin( row ); k < my_model.rowEnd( row ); ++k ) {
+    activity += row_values[k] * x[ row_columns[k] ];
+  }
+  double rhs = my_model.rightHandSide( row );
+  switch ( my_model.rowSense( row ) ) {
+  case LpModel::GREATER_EQUAL: return activity < rhs - tolerance;
+  case LpModel::LESS_EQUAL: return activity > rhs + tolerance;
+  default: return activity < rhs - tolerance || activity > rhs + tolerance;
+  }
+}
+
+size_t
+LazyRowPool::separate( const std::vector<double> & x, double tolerance,
+                       size_t limit, std::vector<int> & rows )
+{
+  double start_time = ClockTimer::wallClock();
+  rows.clear();
+  // with 0/1 values, a covering row is satisfied if one of its columns is
+  // at 1
+  std::vector<uint64_t> ones;
+  bool zero_one = my_covering;
+  for ( size_t j = 0; j < x.size() && zero_one; ++j ) {
+    zero_one = std::min( std::fabs( x[j] ), std::fabs( x[j] - 1 ) )
+      <= tolerance;
+  }
+  if ( zero_one ) {
+    ones.assign( x.size() / 64 + 1, 0 );
+    for ( size_t j = 0; j < x.size(); ++j ) {
+      if ( x[j] > 0.5 ) ones[j >> 6] |= uint64_t( 1 ) << (j & 63);
+    }
+  }
+  // the initial rows are in the solver; a row returned before may not be
+  // in the LP this candidate comes from
+  const int number_of_rows = my_model.numberOfRows();
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    if ( my_loaded[i] || ! violated( i, x, tolerance, ones ) ) continue;
+    rows.push_back( i );
+    if ( rows.size() == limit ) break;
+  }
+
+  std::lock_guard<std::mutex> guard( my_lock );
+  for ( size_t r = 0; r < rows.size(); ++r ) {
+    if ( my_returned[ rows[r] ] ) continue;
+    my_returned[ rows[r] ] = 1;
+    ++my_rows_returned;
+  }
+  ++my_separations;
+  my_separation_time += ClockTimer::wallClock() - start_time;
+  return rows.size();
+}
+
+//  [Last modified: 2026 10 18 at 07:24:15 GMT]
@@ -0,0 +1,80 @@
+/**
+ * @file LazyRowPool.h
+ * @brief The rows of a model that are left out of the solver (-lazy_rows),
+ * and the search for those a candidate solution violates
+ *
+ * A model with millions of rows, of which only a few are ever binding
+ * (e.g., a covering model from a large SAT instance), is given to the
+ * solver with a subset of its rows: a greedy cover of the columns by rows,
+ * longest rows first, so that every column is in at least one row from the
+ * start. The others stay in the CSR arrays of the parsed model, which are
+ * scanned for rows violated by each candidate solution; those are added to
+ * the solver. A row added once is still checked at every candidate: other
+ * threads, or a callback called again on the same node, may see candidates
+ * found before it was added. For a covering model and a 0/1
+ * solution the scan uses a bitset of the columns at 1 and stops at the
+ * first such column of each row; otherwise each row is evaluated.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef LAZYROWPOOL_H
+#define LAZYROWPOOL_H
+
+#include<vector>
+#include<mutex>
+#include<cstddef>
+#include<stdint.h>
+#include"LpModel.h"
+
+/// Usage:
+///   LazyRowPool pool( model );
+///   pool.selectInitialRows();
+///   ... load the rows i with pool.loaded(i) into the solver
+///   at each candidate x: pool.separate( x, tolerance, limit, rows ), then
+///   add those rows to the solver
+class LazyRowPool {
+public:
+  explicit LazyRowPool( const LpModel & model );
+
+  /// marks the rows of the initial subset as loaded
+  void selectInitialRows();
+
+  bool loaded( int row ) const { return my_loaded[row] != 0; }
+  /// per row, nonzero if it is in the initial subset
+  const std::vector<char> & loadedRows() const { return my_loaded; }
+  int initialRows() const { return my_initial_rows; }
+  /// initial rows and rows returned by separate(), each counted once
+  int rowsLoaded() const { return my_initial_rows + my_rows_returned; }
+
+  /// finds rows outside the initial subset that x (a value per column)
+  /// violates by more than tolerance, at most limit of them (0 = no
+  /// limit), whether returned before or not; can be called from several
+  /// threads at once
+  /// @return the number of rows found, which are put in rows
+  size_t separate( const std::vector<double> & x, double tolerance,
+                   size_t limit, std::vector<int> & rows );
+
+  long separations() const { return my_separations; }
+  double separationTime() const { return my_separation_time; }
+
+private:
+  /// ones: a bitset of the columns at 1 if x is 0/1 and the model is a
+  /// covering model, empty otherwise
+  bool violated( int row, const std::vector<double> & x, double tolerance,
+                 const std::vector<uint64_t> & ones ) const;
+
+  const LpModel & my_model;
+  bool my_covering;
+  std::vector<char> my_loaded;
+  std::vector<char> my_returned;
+  int my_initial_rows;
+  int my_rows_returned;
+  long my_separations;
+  double my_separation_time;
+  std::mutex my_lock;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:24:15 GMT]
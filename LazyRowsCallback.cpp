@@ -0,0 +1,44 @@
+/// @file LazyRowsCallback.cpp
+/// @brief separation of the rows left out by -lazy_rows
+
+#include "LazyRowsCallback.h"
+#include "CplexLoader.h"
+
+ILOSTLBEGIN
+
+/// violation that counts, as CPLEX's default feasibility tolerance
+static const double LAZY_TOLERANCE = 1e-6;
+
+/// rows added per candidate solution, at most
+static const size_t MAX_ROWS_PER_CALL = 1000;
+
+void
+LazyRowsCallbackI::main()
+{
+  IloNumArray values( getEnv() );
+  getValues( values, my_var );
+  vector<double> x( values.getSize() );
+  for ( IloInt j = 0; j < values.getSize(); ++j ) x[j] = values[j];
+  values.end();
+  vector<int> rows;
+  my_pool->separate( x, LAZY_TOLERANCE, MAX_ROWS_PER_CALL, rows );
+  for ( size_t r = 0; r < rows.size(); ++r ) {
+    add( rowRange( getEnv(), my_lp_model, rows[r], my_var ) ).end();
+  }
+}
+
+IloCplex::CallbackI *
+LazyRowsCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) LazyRowsCallbackI( *this ));
+}
+
+IloCplex::Callback
+lazyRowsCallback( IloEnv env, const LpModel & lp_model,
+                  const IloNumVarArray var, LazyRowPool * pool )
+{
+  return IloCplex::Callback( new (env) LazyRowsCallbackI( env, lp_model, var,
+                                                          pool ) );
+}
+
+//  [Last modified: 2026 10 18 at 03:24:10 GMT]
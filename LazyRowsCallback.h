@@ -0,0 +1,41 @@
+/**
+ * @file LazyRowsCallback.h
+ * @brief Lazy constraint callback that adds the rows of a LazyRowPool
+ * violated by a candidate solution (-lazy_rows)
+ *
+ * The rows found are added as global cuts, so that CPLEX keeps them for
+ * the rest of the search; the pool still checks them at later candidates,
+ * which other threads may have found before the rows were added.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef LAZYROWSCALLBACK_H
+#define LAZYROWSCALLBACK_H
+
+#include <ilcplex/ilocplex.h>
+#include "LazyRowPool.h"
+
+class LazyRowsCallbackI: public IloCplex::LazyConstraintCallbackI {
+public:
+  LazyRowsCallbackI( IloEnv env, const LpModel & lp_model,
+                     const IloNumVarArray var, LazyRowPool * pool ):
+    IloCplex::LazyConstraintCallbackI( env ), my_lp_model( lp_model ),
+    my_var( var ), my_pool( pool ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  const LpModel & my_lp_model;
+  IloNumVarArray my_var;
+  LazyRowPool * my_pool;
+};
+
+/// @return a callback for IloCplex::use() that separates the rows of pool
+/// (the rows of lp_model that were not loaded, over var)
+IloCplex::Callback lazyRowsCallback( IloEnv env, const LpModel & lp_model,
+                                     const IloNumVarArray var,
+                                     LazyRowPool * pool );
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:24:15 GMT]
@@ -0,0 +1,150 @@
+/// @file LpModel.cpp
+/// @brief implementation of the solver-independent model representation
+
+#include"LpModel.h"
+#include<sstream>
+#include<cstring>
+
+/// FNV-1a; names are short, so anything fancier doesn't pay off
+static size_t hash_name( const char * name, size_t length )
+{
+  size_t hash = 2166136261u;
+  for ( size_t i = 0; i < length; ++i ) {
+    hash ^= static_cast<unsigned char>( name[i] );
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+LpModel::LpModel()
+{
+  clear();
+}
+
+void
+LpModel::clear()
+{
+  my_minimize = true;
+  my_objective_name = "obj";
+  my_objective_offset = 0;
+  my_column_names.clear();
+  my_objective.clear();
+  my_lower_bounds.clear();
+  my_upper_bounds.clear();
+  my_column_types.clear();
+  my_row_names.clear();
+  my_row_starts.assign( 1, 0 );
+  my_row_columns.clear();
+  my_row_values.clear();
+  my_row_senses.clear();
+  my_rhs.clear();
+  my_hash_slots.assign( 1024, -1 );
+  my_position_in_row.clear();
+}
+
+int
+LpModel::findColumn( const char * name, size_t length ) const
+{
+  size_t mask = my_hash_slots.size() - 1;
+  size_t slot = hash_name( name, length ) & mask;
+  while ( my_hash_slots[slot] >= 0 ) {
+    const std::string & candidate = my_column_names[ my_hash_slots[slot] ];
+    if ( candidate.size() == length
+         && memcmp( candidate.data(), name, length ) == 0 ) {
+      return my_hash_slots[slot];
+    }
+    slot = (slot + 1) & mask;
+  }
+  return -1;
+}
+
+int
+LpModel::findOrAddColumn( const char * name, size_t length )
+{
+  size_t mask = my_hash_slots.size() - 1;
+  size_t slot = hash_name( name, length ) & mask;
+  while ( my_hash_slots[slot] >= 0 ) {
+    const std::string & candidate = my_column_names[ my_hash_slots[slot] ];
+    if ( candidate.size() == length
+         && memcmp( candidate.data(), name, length ) == 0 ) {
+      return my_hash_slots[slot];
+    }
+    slot = (slot + 1) & mask;
+  }
+  int column = my_column_names.size();
+  my_column_names.push_back( std::string( name, length ) );
+  my_objective.push_back( 0 );
+  my_lower_bounds.push_back( 0 );
+  my_upper_bounds.push_back( LP_INFINITY );
+  my_column_types.push_back( CONTINUOUS );
+  my_position_in_row.push_back( -1 );
+  my_hash_slots[slot] = column;
+  // keep the load factor at most 1/2
+  if ( 2 * my_column_names.size() > my_hash_slots.size() ) {
+    rebuildHashTable( 2 * my_hash_slots.size() );
+  }
+  return column;
+}
+
+void
+LpModel::rebuildHashTable( size_t number_of_slots )
+{
+  my_hash_slots.assign( number_of_slots, -1 );
+  size_t mask = number_of_slots - 1;
+  for ( size_t column = 0; column < my_column_names.size(); ++column ) {
+    const std::string & name = my_column_names[column];
+    size_t slot = hash_name( name.data(), name.size() ) & mask;
+    while ( my_hash_slots[slot] >= 0 ) slot = (slot + 1) & mask;
+    my_hash_slots[slot] = column;
+  }
+}
+
+void
+LpModel::setColumnType( int j, ColumnType type )
+{
+  my_column_types[j] = type;
+  if ( type == BINARY ) {
+    my_lower_bounds[j] = 0;
+    my_upper_bounds[j] = 1;
+  }
+}
+
+void
+LpModel::beginRow( const std::string & name )
+{
+  my_row_names.push_back( name );
+}
+
+void
+LpModel::addTerm( int column, double coefficient )
+{
+  int position = my_position_in_row[column];
+  if ( position >= my_row_starts.back()
+       && position < static_cast<int>( my_row_columns.size() )
+       && my_row_columns[position] == column ) {
+    my_row_values[position] += coefficient;
+    return;
+  }
+  my_position_in_row[column] = my_row_columns.size();
+  my_row_columns.push_back( column );
+  my_row_values.push_back( coefficient );
+}
+
+void
+LpModel::endRow( RowSense sense, double rhs )
+{
+  my_row_senses.push_back( sense );
+  my_rhs.push_back( rhs );
+  my_row_starts.push_back( my_row_columns.size() );
+}
+
+std::string
+LpModel::rowName( int i ) const
+{
+  if ( ! my_row_names[i].empty() ) return my_row_names[i];
+  std::ostringstream default_name;
+  default_name << "c" << i + 1;
+  return default_name.str();
+}
+
+//  [Last modified: 2026 10 17 at 14:20:37 GMT]
@@ -0,0 +1,138 @@
+/**
+ * @file LpModel.h
+ * @brief Solver-independent representation of a linear or integer program:
+ * named columns with bounds, types and objective coefficients, and rows
+ * stored in compressed sparse row (CSR) form
+ *
+ * Readers (see LpParser.h) build an LpModel without going through CPLEX;
+ * CplexLoader.h copies one into a Concert model in bulk.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef LPMODEL_H
+#define LPMODEL_H
+
+#include<string>
+#include<vector>
+#include<cstddef>
+
+/// bounds at or beyond this magnitude are infinite (same as IloInfinity)
+const double LP_INFINITY = 1e20;
+
+/// Usage:
+///   LpModel model;
+///   int x = model.findOrAddColumn("x", 1);
+///   model.setObjectiveCoefficient(x, 1.0);
+///   model.beginRow("c1");
+///   model.addTerm(x, 2.0);
+///   model.endRow(LpModel::GREATER_EQUAL, 1.0);
+/// Rows are stored contiguously: the nonzeros of row i are at positions
+/// rowStarts()[i] .. rowStarts()[i+1]-1 of rowColumns() and rowValues().
+class LpModel {
+public:
+  enum ColumnType { CONTINUOUS = 'C', BINARY = 'B', INTEGER = 'I',
+                    SEMICONTINUOUS = 'S' };
+  enum RowSense { GREATER_EQUAL = 'G', LESS_EQUAL = 'L', EQUAL = 'E' };
+
+  LpModel();
+  void clear();
+
+  int numberOfColumns() const { return my_column_names.size(); }
+  int numberOfRows() const { return my_row_senses.size(); }
+  int numberOfNonZeros() const { return my_row_columns.size(); }
+
+  bool minimize() const { return my_minimize; }
+  void setMinimize( bool minimize ) { my_minimize = minimize; }
+  const std::string & objectiveName() const { return my_objective_name; }
+  void setObjectiveName( const std::string & name ) { my_objective_name = name; }
+  /// constant term of the objective
+  double objectiveOffset() const { return my_objective_offset; }
+  void setObjectiveOffset( double offset ) { my_objective_offset = offset; }
+
+  /// @return index of the column with the given name, -1 if there is none
+  int findColumn( const char * name, size_t length ) const;
+  int findColumn( const std::string & name ) const {
+    return findColumn( name.data(), name.size() );
+  }
+  /// @return index of the column with the given name, creating it with
+  /// default attributes (continuous, bounds [0,inf), cost 0) if necessary
+  int findOrAddColumn( const char * name, size_t length );
+
+  const std::string & columnName( int j ) const { return my_column_names[j]; }
+  double objectiveCoefficient( int j ) const { return my_objective[j]; }
+  double lowerBound( int j ) const { return my_lower_bounds[j]; }
+  double upperBound( int j ) const { return my_upper_bounds[j]; }
+  char columnType( int j ) const { return my_column_types[j]; }
+  bool isInteger( int j ) const {
+    return my_column_types[j] == BINARY || my_column_types[j] == INTEGER;
+  }
+
+  void setObjectiveCoefficient( int j, double value ) { my_objective[j] = value; }
+  void setLowerBound( int j, double value ) { my_lower_bounds[j] = value; }
+  void setUpperBound( int j, double value ) { my_upper_bounds[j] = value; }
+  /// binary columns also get bounds [0,1]
+  void setColumnType( int j, ColumnType type );
+
+  /// starts a new row; an empty name means the row gets the default name
+  /// c<i> (1-based), which is what the CPLEX LP reader does
+  void beginRow( const std::string & name );
+  /// adds coefficient * column to the current row; repeated occurrences of
+  /// a column are merged into a single nonzero
+  void addTerm( int column, double coefficient );
+  void endRow( RowSense sense, double rhs );
+
+  std::string rowName( int i ) const;
+  char rowSense( int i ) const { return my_row_senses[i]; }
+  double rightHandSide( int i ) const { return my_rhs[i]; }
+  int rowBegin( int i ) const { return my_row_starts[i]; }
+  int rowEnd( int i ) const { return my_row_starts[i + 1]; }
+
+  /// bulk (read-only) access for algorithms that scan the whole matrix
+  const std::vector<std::string> & columnNames() const { return my_column_names; }
+  const std::vector<double> & objective() const { return my_objective; }
+  const std::vector<double> & lowerBounds() const { return my_lower_bounds; }
+  const std::vector<double> & upperBounds() const { return my_upper_bounds; }
+  const std::vector<char> & columnTypes() const { return my_column_types; }
+  const std::vector<int> & rowStarts() const { return my_row_starts; }
+  const std::vector<int> & rowColumns() const { return my_row_columns; }
+  const std::vector<double> & rowValues() const { return my_row_values; }
+  const std::vector<char> & rowSenses() const { return my_row_senses; }
+  const std::vector<double> & rightHandSides() const { return my_rhs; }
+
+private:
+  // reads and writes the arrays directly
+  friend class ModelCache;
+
+  void rebuildHashTable( size_t number_of_slots );
+
+  bool my_minimize;
+  std::string my_objective_name;
+  double my_objective_offset;
+
+  // columns
+  std::vector<std::string> my_column_names;
+  std::vector<double> my_objective;
+  std::vector<double> my_lower_bounds;
+  std::vector<double> my_upper_bounds;
+  std::vector<char> my_column_types;
+
+  // rows, CSR; my_row_starts always has numberOfRows() + 1 entries
+  std::vector<std::string> my_row_names; // empty = default name
+  std::vector<int> my_row_starts;
+  std::vector<int> my_row_columns;
+  std::vector<double> my_row_values;
+  std::vector<char> my_row_senses;
+  std::vector<double> my_rhs;
+
+  /// open addressing table of column indices (-1 = empty slot), keyed by
+  /// name, so that lookups can be done on tokens that are not strings yet
+  std::vector<int> my_hash_slots;
+  /// position of each column's nonzero in the row under construction, used
+  /// to merge duplicate terms
+  std::vector<int> my_position_in_row;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 14:20:37 GMT]
@@ -0,0 +1,558 @@
+/// @file LpParser.cpp
+/// @brief implementation of the memory-mapped LP format reader
+
+#include"LpParser.h"
+#include"MappedFile.h"
+#include<cstdlib>
+#include<cstring>
+#include<sstream>
+
+/// characters that end a name (besides white space); see the CPLEX
+/// documentation of the LP format for the characters a name may contain
+static bool is_delimiter( char c )
+{
+  switch ( c ) {
+  case ' ': case '\t': case '\r': case '\n': case '\f': case '\v':
+  case '+': case '-': case '<': case '>': case '=': case ':':
+  case '\\': case '[': case ']': case '*': case '^':
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool is_digit( char c ) { return c >= '0' && c <= '9'; }
+
+/// powers of ten that are exactly representable as doubles
+static const double EXACT_POWERS_OF_TEN[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+LpParser::LpParser():
+  my_position( 0 ), my_end( 0 ), my_line( 1 ), my_at_line_start( true ),
+  my_minimize_heading( true ), my_have_lookahead( false ), my_unsupported( false ), my_bytes_read( 0 )
+{
+}
+
+bool
+LpParser::isLpFile( const std::string & file_name )
+{
+  std::string::size_type start_of_extension = file_name.find_last_of( "." );
+  if ( start_of_extension == std::string::npos ) return false;
+  std::string extension = file_name.substr( start_of_extension + 1 );
+  return extension == "lp" || extension == "lpx"
+    || extension == "LP" || extension == "LPX";
+}
+
+bool
+LpParser::parse( const std::string & file_name, LpModel & model )
+{
+  model.clear();
+  my_error_message = "";
+  my_unsupported = false;
+  MappedFile input;
+  if ( ! input.open( file_name ) ) {
+    my_error_message = input.errorMessage();
+    return false;
+  }
+  my_bytes_read = input.size();
+  my_position = input.begin();
+  my_end = input.end();
+  my_line = 1;
+  my_at_line_start = true;
+  my_have_lookahead = false;
+  advance();
+
+  Section section = NO_SECTION;
+  while ( my_token.type != END_OF_INPUT && section != END_SECTION ) {
+    Section heading = sectionHeading();
+    if ( heading != NO_SECTION ) {
+      if ( heading == OBJECTIVE_SECTION ) {
+        // the objective has no terminator other than the next heading, so
+        // it's read right here
+        if ( ! parseObjective( model ) ) return false;
+      }
+      section = heading;
+      continue;
+    }
+    if ( ! my_error_message.empty() ) return false;
+    bool ok = true;
+    switch ( section ) {
+    case NO_SECTION:
+      ok = syntaxError( "expected Minimize or Maximize" );
+      break;
+    case OBJECTIVE_SECTION:
+      ok = syntaxError( "unexpected token after objective" );
+      break;
+    case CONSTRAINT_SECTION:
+      ok = parseConstraint( model );
+      break;
+    case BOUNDS_SECTION:
+      ok = parseBound( model );
+      break;
+    case BINARY_SECTION:
+    case GENERAL_SECTION:
+    case SEMI_SECTION:
+      if ( my_token.type != NAME ) {
+        ok = syntaxError( "expected a variable name" );
+        break;
+      }
+      {
+        int column = model.findOrAddColumn( my_token.text, my_token.length );
+        model.setColumnType( column,
+                             section == BINARY_SECTION ? LpModel::BINARY
+                             : section == GENERAL_SECTION ? LpModel::INTEGER
+                             : LpModel::SEMICONTINUOUS );
+      }
+      advance();
+      break;
+    case END_SECTION:
+      break;
+    }
+    if ( ! ok ) return false;
+  }
+  if ( section == NO_SECTION ) {
+    return syntaxError( "no objective section" );
+  }
+  return true;
+}
+
+void
+LpParser::lex( Token & token )
+{
+  // skip white space and comments, noting whether a new line starts
+  while ( my_position < my_end ) {
+    char c = *my_position;
+    if ( c == '\n' ) {
+      ++my_line;
+      my_at_line_start = true;
+      ++my_position;
+    }
+    else if ( c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v' ) {
+      ++my_position;
+    }
+    else if ( c == '\\' ) {
+      if ( my_position + 1 < my_end && my_position[1] == '*' ) {
+        // block comment \* ... *\ (may span lines)
+        my_position += 2;
+        while ( my_position + 1 < my_end
+                && ! (my_position[0] == '*' && my_position[1] == '\\') ) {
+          if ( *my_position == '\n' ) ++my_line;
+          ++my_position;
+        }
+        my_position = my_position + 2 < my_end ? my_position + 2 : my_end;
+      }
+      else {
+        const char * newline = static_cast<const char *>
+          ( memchr( my_position, '\n', my_end - my_position ) );
+        my_position = newline ? newline : my_end;
+      }
+    }
+    else break;
+  }
+
+  token.first_on_line = my_at_line_start;
+  token.line = my_line;
+  token.text = my_position;
+  token.length = 0;
+  token.value = 0;
+  my_at_line_start = false;
+  if ( my_position >= my_end ) {
+    token.type = END_OF_INPUT;
+    return;
+  }
+
+  const char * start = my_position;
+  char c = *my_position++;
+  switch ( c ) {
+  case '+': token.type = PLUS; break;
+  case '-': token.type = MINUS; break;
+  case ':': token.type = COLON; break;
+  case '<':
+    if ( my_position < my_end && *my_position == '=' ) ++my_position;
+    token.type = LESS_EQUAL;
+    break;
+  case '>':
+    if ( my_position < my_end && *my_position == '=' ) ++my_position;
+    token.type = GREATER_EQUAL;
+    break;
+  case '=':
+    token.type = EQUAL;
+    if ( my_position < my_end && *my_position == '<' ) {
+      ++my_position;
+      token.type = LESS_EQUAL;
+    }
+    else if ( my_position < my_end && *my_position == '>' ) {
+      ++my_position;
+      token.type = GREATER_EQUAL;
+    }
+    break;
+  default:
+    if ( is_digit( c )
+         || (c == '.' && my_position < my_end && is_digit( *my_position )) ) {
+      // number: digits [. digits] [e [sign] digits]; the common case is
+      // converted exactly without copying, anything else goes to strtod()
+      unsigned long long mantissa = 0;
+      int significant_digits = 0;
+      int scale = 0;
+      const char * p = start;
+      for ( ; p < my_end && is_digit( *p ); ++p ) {
+        if ( mantissa != 0 || *p != '0' ) ++significant_digits;
+        if ( significant_digits <= 18 ) mantissa = 10 * mantissa + (*p - '0');
+        else ++scale;
+      }
+      if ( p < my_end && *p == '.' ) {
+        for ( ++p; p < my_end && is_digit( *p ); ++p ) {
+          if ( mantissa != 0 || *p != '0' ) ++significant_digits;
+          if ( significant_digits <= 18 ) {
+            mantissa = 10 * mantissa + (*p - '0');
+            --scale;
+          }
+        }
+      }
+      if ( p + 1 < my_end && (*p == 'e' || *p == 'E')
+           && (is_digit( p[1] )
+               || ((p[1] == '+' || p[1] == '-')
+                   && p + 2 < my_end && is_digit( p[2] ))) ) {
+        ++p;
+        bool negative_exponent = (*p == '-');
+        if ( *p == '+' || *p == '-' ) ++p;
+        int exponent = 0;
+        for ( ; p < my_end && is_digit( *p ); ++p ) {
+          if ( exponent < 100000 ) exponent = 10 * exponent + (*p - '0');
+        }
+        scale += negative_exponent ? -exponent : exponent;
+      }
+      my_position = p;
+      token.type = NUMBER;
+      if ( significant_digits <= 15 && scale >= -22 && scale <= 22 ) {
+        double value = static_cast<double>( mantissa );
+        token.value = scale < 0 ? value / EXACT_POWERS_OF_TEN[-scale]
+          : value * EXACT_POWERS_OF_TEN[scale];
+      }
+      else {
+        std::string copy( start, p - start );
+        token.value = strtod( copy.c_str(), 0 );
+      }
+    }
+    else if ( c == '[' || c == ']' || c == '*' || c == '^' ) {
+      token.type = OTHER;
+    }
+    else {
+      while ( my_position < my_end && ! is_delimiter( *my_position ) ) {
+        ++my_position;
+      }
+      token.type = NAME;
+    }
+  }
+  token.length = my_position - start;
+}
+
+void
+LpParser::advance()
+{
+  if ( my_have_lookahead ) {
+    my_token = my_lookahead;
+    my_have_lookahead = false;
+  }
+  else lex( my_token );
+}
+
+const LpParser::Token &
+LpParser::peek()
+{
+  if ( ! my_have_lookahead ) {
+    lex( my_lookahead );
+    my_have_lookahead = true;
+  }
+  return my_lookahead;
+}
+
+bool
+LpParser::tokenIs( const Token & token, const char * word ) const
+{
+  size_t length = strlen( word );
+  return token.type == NAME && token.length == length
+    && strncasecmp( token.text, word, length ) == 0;
+}
+
+bool
+LpParser::isInfinity( const Token & token ) const
+{
+  return tokenIs( token, "inf" ) || tokenIs( token, "infinity" );
+}
+
+bool
+LpParser::atHeading()
+{
+  static const char * const HEADINGS[] = {
+    "min", "minimize", "minimum", "minimise",
+    "max", "maximize", "maximum", "maximise",
+    "st", "s.t.", "st.", "subject", "such",
+    "bounds", "bound", "binary", "binaries", "bin",
+    "general", "generals", "gen", "semi", "semis", "end",
+    "sos", "lazy", "user", "pwl", "generalconstraints", 0 };
+  if ( my_token.type != NAME || ! my_token.first_on_line ) return false;
+  bool keyword = false;
+  for ( const char * const * word = HEADINGS; *word && ! keyword; ++word ) {
+    keyword = tokenIs( my_token, *word );
+  }
+  if ( ! keyword ) return false;
+  // a name followed by a colon is a label, even if it looks like a keyword
+  if ( peek().type == COLON ) return false;
+  if ( tokenIs( my_token, "subject" ) ) return tokenIs( peek(), "to" );
+  if ( tokenIs( my_token, "such" ) ) return tokenIs( peek(), "that" );
+  return true;
+}
+
+LpParser::Section
+LpParser::sectionHeading()
+{
+  if ( ! atHeading() ) return NO_SECTION;
+
+  Section section = NO_SECTION;
+  if ( tokenIs( my_token, "min" ) || tokenIs( my_token, "minimize" )
+       || tokenIs( my_token, "minimum" ) || tokenIs( my_token, "minimise" ) ) {
+    section = OBJECTIVE_SECTION;
+    my_minimize_heading = true;
+  }
+  else if ( tokenIs( my_token, "max" ) || tokenIs( my_token, "maximize" )
+            || tokenIs( my_token, "maximum" )
+            || tokenIs( my_token, "maximise" ) ) {
+    section = OBJECTIVE_SECTION;
+    my_minimize_heading = false;
+  }
+  else if ( tokenIs( my_token, "st" ) || tokenIs( my_token, "s.t." )
+            || tokenIs( my_token, "st." ) ) {
+    section = CONSTRAINT_SECTION;
+  }
+  else if ( tokenIs( my_token, "subject" ) || tokenIs( my_token, "such" ) ) {
+    advance();
+    section = CONSTRAINT_SECTION;
+  }
+  else if ( tokenIs( my_token, "bounds" ) || tokenIs( my_token, "bound" ) ) {
+    section = BOUNDS_SECTION;
+  }
+  else if ( tokenIs( my_token, "binary" ) || tokenIs( my_token, "binaries" )
+            || tokenIs( my_token, "bin" ) ) {
+    section = BINARY_SECTION;
+  }
+  else if ( tokenIs( my_token, "general" ) || tokenIs( my_token, "generals" )
+            || tokenIs( my_token, "gen" ) ) {
+    section = GENERAL_SECTION;
+  }
+  else if ( tokenIs( my_token, "semi" ) || tokenIs( my_token, "semis" ) ) {
+    // semi-continuous is lexed as semi - continuous
+    if ( peek().type == MINUS ) {
+      advance();
+      if ( ! tokenIs( peek(), "continuous" ) ) {
+        syntaxError( "expected semi-continuous" );
+        return NO_SECTION;
+      }
+      advance();
+    }
+    section = SEMI_SECTION;
+  }
+  else if ( tokenIs( my_token, "end" ) ) {
+    section = END_SECTION;
+  }
+  else {
+    // sos, lazy constraints, user cuts, ...
+    unsupportedConstruct( "section " + std::string( my_token.text,
+                                                     my_token.length ) );
+    return NO_SECTION;
+  }
+  if ( section != NO_SECTION ) advance();
+  return section;
+}
+
+bool
+LpParser::parseObjective( LpModel & model )
+{
+  model.setMinimize( my_minimize_heading );
+  if ( my_token.type == NAME && peek().type == COLON ) {
+    model.setObjectiveName( std::string( my_token.text, my_token.length ) );
+    advance();
+    advance();
+  }
+  return parseLinearExpression( model, true );
+}
+
+bool
+LpParser::parseLinearExpression( LpModel & model, bool objective )
+{
+  while ( true ) {
+    bool negative = false;
+    bool signed_term = false;
+    while ( my_token.type == PLUS || my_token.type == MINUS ) {
+      if ( my_token.type == MINUS ) negative = ! negative;
+      signed_term = true;
+      advance();
+    }
+    double coefficient = 1;
+    bool have_number = false;
+    if ( my_token.type == NUMBER ) {
+      coefficient = my_token.value;
+      have_number = true;
+      advance();
+    }
+    if ( negative ) coefficient = -coefficient;
+
+    if ( my_token.type == NAME && ! atHeading() ) {
+      int column = model.findOrAddColumn( my_token.text, my_token.length );
+      if ( objective ) {
+        model.setObjectiveCoefficient( column,
+                                       model.objectiveCoefficient( column )
+                                       + coefficient );
+      }
+      else model.addTerm( column, coefficient );
+      advance();
+    }
+    else if ( have_number ) {
+      if ( ! objective ) {
+        return unsupportedConstruct( "constant on the left hand side" );
+      }
+      model.setObjectiveOffset( model.objectiveOffset() + coefficient );
+    }
+    else if ( my_token.type == OTHER ) {
+      return unsupportedConstruct( "quadratic term" );
+    }
+    else if ( signed_term ) {
+      return syntaxError( "expected a coefficient or variable" );
+    }
+    else return true;
+  }
+}
+
+bool
+LpParser::parseConstraint( LpModel & model )
+{
+  std::string name;
+  if ( my_token.type == NAME && peek().type == COLON ) {
+    name.assign( my_token.text, my_token.length );
+    advance();
+    advance();
+  }
+  model.beginRow( name );
+  if ( ! parseLinearExpression( model, false ) ) return false;
+  LpModel::RowSense sense;
+  switch ( my_token.type ) {
+  case LESS_EQUAL: sense = LpModel::LESS_EQUAL; break;
+  case GREATER_EQUAL: sense = LpModel::GREATER_EQUAL; break;
+  case EQUAL: sense = LpModel::EQUAL; break;
+  default:
+    return syntaxError( "expected <=, >= or =" );
+  }
+  advance();
+  if ( my_token.type == OTHER ) {
+    return unsupportedConstruct( "indicator constraint" );
+  }
+  double rhs = 0;
+  if ( ! parseSignedValue( rhs ) ) return false;
+  if ( my_token.type == LESS_EQUAL || my_token.type == GREATER_EQUAL
+       || my_token.type == EQUAL ) {
+    return unsupportedConstruct( "ranged constraint" );
+  }
+  model.endRow( sense, rhs );
+  return true;
+}
+
+bool
+LpParser::parseSignedValue( double & value )
+{
+  bool negative = false;
+  while ( my_token.type == PLUS || my_token.type == MINUS ) {
+    if ( my_token.type == MINUS ) negative = ! negative;
+    advance();
+  }
+  if ( my_token.type == NUMBER ) {
+    value = my_token.value;
+    if ( value >= LP_INFINITY ) value = LP_INFINITY;
+  }
+  else if ( isInfinity( my_token ) ) {
+    value = LP_INFINITY;
+  }
+  else return syntaxError( "expected a number" );
+  if ( negative ) value = -value;
+  advance();
+  return true;
+}
+
+bool
+LpParser::parseBound( LpModel & model )
+{
+  if ( my_token.type == NAME && ! isInfinity( my_token ) ) {
+    // x free | x <= u | x >= l | x = v
+    int column = model.findOrAddColumn( my_token.text, my_token.length );
+    advance();
+    if ( tokenIs( my_token, "free" ) ) {
+      model.setLowerBound( column, -LP_INFINITY );
+      model.setUpperBound( column, LP_INFINITY );
+      advance();
+      return true;
+    }
+    TokenType sense = my_token.type;
+    if ( sense != LESS_EQUAL && sense != GREATER_EQUAL && sense != EQUAL ) {
+      return syntaxError( "expected free, <=, >= or = in bound" );
+    }
+    advance();
+    double value = 0;
+    if ( ! parseSignedValue( value ) ) return false;
+    if ( sense != GREATER_EQUAL ) model.setUpperBound( column, value );
+    if ( sense != LESS_EQUAL ) model.setLowerBound( column, value );
+    return true;
+  }
+
+  // l <= x [<= u], or the same with >=
+  double first_value = 0;
+  if ( ! parseSignedValue( first_value ) ) return false;
+  TokenType first_sense = my_token.type;
+  if ( first_sense != LESS_EQUAL && first_sense != GREATER_EQUAL
+       && first_sense != EQUAL ) {
+    return syntaxError( "expected <=, >= or = in bound" );
+  }
+  advance();
+  if ( my_token.type != NAME ) {
+    return syntaxError( "expected a variable name in bound" );
+  }
+  int column = model.findOrAddColumn( my_token.text, my_token.length );
+  advance();
+  if ( first_sense != GREATER_EQUAL ) model.setLowerBound( column, first_value );
+  if ( first_sense != LESS_EQUAL ) model.setUpperBound( column, first_value );
+  TokenType second_sense = my_token.type;
+  if ( second_sense == LESS_EQUAL || second_sense == GREATER_EQUAL ) {
+    advance();
+    double second_value = 0;
+    if ( ! parseSignedValue( second_value ) ) return false;
+    if ( second_sense == LESS_EQUAL ) model.setUpperBound( column, second_value );
+    else model.setLowerBound( column, second_value );
+  }
+  return true;
+}
+
+bool
+LpParser::syntaxError( const std::string & message )
+{
+  std::ostringstream error_stream;
+  error_stream << "line " << my_token.line << ": " << message;
+  if ( my_token.type != END_OF_INPUT ) {
+    error_stream << " at '" << std::string( my_token.text, my_token.length )
+                 << "'";
+  }
+  my_error_message = error_stream.str();
+  return false;
+}
+
+bool
+LpParser::unsupportedConstruct( const std::string & message )
+{
+  std::ostringstream error_stream;
+  error_stream << "line " << my_token.line << ": " << message
+               << " not supported";
+  my_error_message = error_stream.str();
+  my_unsupported = true;
+  return false;
+}
+
+//  [Last modified: 2026 10 17 at 14:41:52 GMT]
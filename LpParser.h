@@ -0,0 +1,102 @@
+/**
+ * @file LpParser.h
+ * @brief Streaming reader for the CPLEX LP format (the .lp/.lpx files in
+ * Examples), independent of the solver
+ *
+ * The file is memory mapped and tokenized in place; names are only copied
+ * when a column is created. Supported: \ comments (and \* ... *\ blocks),
+ * Min/Max objective with optional label, st/subject to rows with optional
+ * labels and terms continued over several lines, Bounds (including free and
+ * infinite bounds), Binary, General and Semi-continuous sections, End.
+ * Quadratic terms, SOS, lazy constraint/user cut sections, indicator and
+ * ranged constraints are reported as unsupported so that the caller can
+ * fall back on IloCplex::importModel().
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef LPPARSER_H
+#define LPPARSER_H
+
+#include<string>
+#include<cstddef>
+#include"LpModel.h"
+
+/// Usage:
+///   LpParser parser;
+///   LpModel model;
+///   if ( ! parser.parse(file_name, model) ) ... report parser.errorMessage()
+class LpParser {
+public:
+  LpParser();
+
+  /// @return true if the file name has an extension used for the LP format
+  /// (.lp or .lpx), i.e., the file is one this parser is meant for
+  static bool isLpFile( const std::string & file_name );
+
+  /// @return true if the whole file was read into model (which is cleared
+  /// first); on failure errorMessage() says why and where
+  bool parse( const std::string & file_name, LpModel & model );
+
+  const std::string & errorMessage() const { return my_error_message; }
+  /// true if the failure was caused by a legal construct the parser does
+  /// not handle rather than by a syntax error
+  bool unsupported() const { return my_unsupported; }
+  /// number of bytes in the most recently parsed file
+  size_t bytesRead() const { return my_bytes_read; }
+
+private:
+  enum TokenType { END_OF_INPUT, NAME, NUMBER, PLUS, MINUS,
+                   LESS_EQUAL, GREATER_EQUAL, EQUAL, COLON, OTHER };
+  enum Section { NO_SECTION, OBJECTIVE_SECTION, CONSTRAINT_SECTION,
+                 BOUNDS_SECTION, BINARY_SECTION, GENERAL_SECTION,
+                 SEMI_SECTION, END_SECTION };
+
+  /// a token points into the mapped file; nothing is copied
+  struct Token {
+    TokenType type;
+    const char * text;
+    size_t length;
+    double value;               // for NUMBER tokens
+    bool first_on_line;         // for recognizing section headings
+    int line;
+  };
+
+  void lex( Token & token );
+  void advance();
+  const Token & peek();
+  /// @return true if the current token is a section heading: a keyword
+  /// at the start of a line that is not used as a label
+  bool atHeading();
+  /// @return the section introduced by the current token (and consumes the
+  /// heading), or NO_SECTION if the current token is not a heading
+  Section sectionHeading();
+  bool isInfinity( const Token & token ) const;
+  bool tokenIs( const Token & token, const char * word ) const;
+
+  bool parseObjective( LpModel & model );
+  bool parseConstraint( LpModel & model );
+  bool parseBound( LpModel & model );
+  bool parseSignedValue( double & value );
+  /// reads a sum of terms into the objective or into the current row
+  bool parseLinearExpression( LpModel & model, bool objective );
+
+  bool syntaxError( const std::string & message );
+  bool unsupportedConstruct( const std::string & message );
+
+  const char * my_position;
+  const char * my_end;
+  int my_line;
+  bool my_at_line_start;
+  bool my_minimize_heading;
+  Token my_token;
+  Token my_lookahead;
+  bool my_have_lookahead;
+  std::string my_error_message;
+  bool my_unsupported;
+  size_t my_bytes_read;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 14:41:52 GMT]
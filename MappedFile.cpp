@@ -0,0 +1,68 @@
+/// @file MappedFile.cpp
+/// @brief implementation of read-only file mapping using mmap()
+
+#include"MappedFile.h"
+#include<cstring>
+#include<cerrno>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+MappedFile::MappedFile():
+  my_data( 0 ), my_size( 0 ), my_modification_time( 0 )
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool
+MappedFile::open( const std::string & file_name )
+{
+  close();
+  int descriptor = ::open( file_name.c_str(), O_RDONLY );
+  if ( descriptor < 0 ) {
+    my_error_message = "unable to open " + file_name + ": " + strerror( errno );
+    return false;
+  }
+  struct stat file_status;
+  if ( fstat( descriptor, &file_status ) != 0 ) {
+    my_error_message = "unable to stat " + file_name + ": " + strerror( errno );
+    ::close( descriptor );
+    return false;
+  }
+  my_size = file_status.st_size;
+  my_modification_time = file_status.st_mtime;
+  if ( my_size == 0 ) {
+    // mmap() refuses zero-length mappings; an empty file is simply empty
+    ::close( descriptor );
+    return true;
+  }
+  void * address = mmap( 0, my_size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+  // the mapping stays valid after the descriptor is closed
+  ::close( descriptor );
+  if ( address == MAP_FAILED ) {
+    my_error_message = "unable to map " + file_name + ": " + strerror( errno );
+    my_size = 0;
+    return false;
+  }
+  // input is always scanned front to back
+  madvise( address, my_size, MADV_SEQUENTIAL );
+  my_data = static_cast<const char *>( address );
+  return true;
+}
+
+void
+MappedFile::close()
+{
+  if ( my_data ) {
+    munmap( const_cast<char *>( my_data ), my_size );
+  }
+  my_data = 0;
+  my_size = 0;
+}
+
+//  [Last modified: 2026 10 17 at 14:02:11 GMT]
@@ -0,0 +1,52 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of an input file, so that readers can
+ * tokenize the contents in place instead of copying them through a stream
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include<string>
+#include<cstddef>
+
+/// Usage:
+///   MappedFile input;
+///   if ( ! input.open(file_name) ) ... report input.errorMessage()
+///   for ( const char * p = input.begin(); p != input.end(); ++p ) ...
+/// The mapping is released when the object goes out of scope or close() is
+/// called; pointers into the file are invalid after that.
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+
+  /// @return true if the file could be opened and mapped; an empty file is
+  /// legal and yields begin() == end()
+  bool open( const std::string & file_name );
+  void close();
+
+  const char * begin() const { return my_data; }
+  const char * end() const { return my_data + my_size; }
+  size_t size() const { return my_size; }
+  /// modification time and size at the time the file was opened, used to
+  /// decide whether derived data (e.g., a cached model) is stale
+  long modificationTime() const { return my_modification_time; }
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  // mappings are not copied
+  MappedFile( const MappedFile & );
+  MappedFile & operator=( const MappedFile & );
+
+  const char * my_data;
+  size_t my_size;
+  long my_modification_time;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 14:02:11 GMT]
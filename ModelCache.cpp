@@ -0,0 +1,349 @@
+/// @file ModelCache.cpp
+/// @brief reading and writing of binary model snapshots
+
+#include"ModelCache.h"
+#include"MappedFile.h"
+#include<fstream>
+#include<sstream>
+#include<cstring>
+#include<cstdio>
+#include<stdint.h>
+#include<unistd.h>
+
+static const char MAGIC[8] = { 'L', 'P', 'X', 'B', 'C', 'A', 'C', 'H' };
+
+/// amount of the source file, at each end, that goes into its signature;
+/// hashing all of it would cost about as much as parsing it
+static const size_t SIGNATURE_SAMPLE = 1 << 16;
+
+/// fixed-size header at the start of every cache file
+struct CacheHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t source_size;
+  int64_t source_modification_time;
+  uint64_t source_hash;
+  uint64_t payload_size;        // bytes after the header
+  uint64_t payload_checksum;
+  uint64_t minimize;
+  uint64_t columns;
+  uint64_t rows;
+  uint64_t nonzeros;
+  double objective_offset;
+};
+
+/// one step of the word-at-a-time hash used for checksums and signatures
+static inline uint64_t mix( uint64_t hash, uint64_t word )
+{
+  hash ^= word * 0x9E3779B97F4A7C15ULL;
+  hash = (hash << 31) | (hash >> 33);
+  return hash * 0xC2B2AE3D27D4EB4FULL;
+}
+
+/// hash of a region whose length is a multiple of 8
+static uint64_t hash_words( const char * data, size_t size, uint64_t hash )
+{
+  for ( size_t offset = 0; offset + 8 <= size; offset += 8 ) {
+    uint64_t word;
+    memcpy( &word, data + offset, 8 );
+    hash = mix( hash, word );
+  }
+  return hash;
+}
+
+/// hash of an arbitrary region, treated as if padded with zeros
+static uint64_t hash_bytes( const char * data, size_t size, uint64_t hash )
+{
+  size_t whole = size & ~static_cast<size_t>( 7 );
+  hash = hash_words( data, whole, hash );
+  if ( whole < size ) {
+    uint64_t word = 0;
+    memcpy( &word, data + whole, size - whole );
+    hash = mix( hash, word );
+  }
+  return hash;
+}
+
+static uint64_t source_signature( const MappedFile & source )
+{
+  uint64_t hash = mix( 0, source.size() );
+  if ( source.size() <= 2 * SIGNATURE_SAMPLE ) {
+    return hash_bytes( source.begin(), source.size(), hash );
+  }
+  hash = hash_bytes( source.begin(), SIGNATURE_SAMPLE, hash );
+  return hash_bytes( source.end() - SIGNATURE_SAMPLE, SIGNATURE_SAMPLE, hash );
+}
+
+/// Writes the payload of a cache file, keeping a running checksum; every
+/// array starts at a multiple of 8 bytes so that it can be used directly
+/// from a mapping when the file is read back
+class PayloadWriter {
+public:
+  PayloadWriter( std::ostream & out ):
+    my_out( out ), my_checksum( 0 ), my_size( 0 ), my_pending_bytes( 0 ) {}
+
+  void put( const void * data, size_t size ) {
+    const char * bytes = static_cast<const char *>( data );
+    my_out.write( bytes, size );
+    my_size += size;
+    // complete the pending word first, then hash whole words
+    while ( size > 0 && my_pending_bytes > 0 ) {
+      my_pending[ my_pending_bytes++ ] = *bytes++;
+      --size;
+      if ( my_pending_bytes == 8 ) flushPending();
+    }
+    size_t whole = size & ~static_cast<size_t>( 7 );
+    my_checksum = hash_words( bytes, whole, my_checksum );
+    for ( size_t i = whole; i < size; ++i ) {
+      my_pending[ my_pending_bytes++ ] = bytes[i];
+    }
+  }
+  void pad() {
+    static const char zeros[8] = { 0 };
+    if ( my_size % 8 != 0 ) put( zeros, 8 - my_size % 8 );
+  }
+  template<class T> void putArray( const std::vector<T> & values ) {
+    if ( ! values.empty() ) put( &values[0], values.size() * sizeof(T) );
+    pad();
+  }
+  void putUnsigned( uint64_t value ) { put( &value, sizeof(value) ); }
+  void putStrings( const std::vector<std::string> & strings ) {
+    // offsets first, then the concatenated characters
+    uint64_t offset = 0;
+    putUnsigned( offset );
+    for ( size_t i = 0; i < strings.size(); ++i ) {
+      offset += strings[i].size();
+      putUnsigned( offset );
+    }
+    for ( size_t i = 0; i < strings.size(); ++i ) {
+      put( strings[i].data(), strings[i].size() );
+    }
+    pad();
+  }
+  uint64_t checksum() const { return my_checksum; }
+  uint64_t size() const { return my_size; }
+
+private:
+  void flushPending() {
+    uint64_t word;
+    memcpy( &word, my_pending, 8 );
+    my_checksum = mix( my_checksum, word );
+    my_pending_bytes = 0;
+  }
+
+  std::ostream & my_out;
+  uint64_t my_checksum;
+  uint64_t my_size;
+  char my_pending[8];
+  size_t my_pending_bytes;
+};
+
+/// Reads the arrays of a mapped payload in the order they were written
+class PayloadReader {
+public:
+  PayloadReader( const char * begin, const char * end ):
+    my_position( begin ), my_end( end ) {}
+
+  bool ok() const { return my_position != 0; }
+
+  template<class T> void getArray( std::vector<T> & values, size_t count ) {
+    const char * data = take( count * sizeof(T) );
+    if ( data ) {
+      const T * first = reinterpret_cast<const T *>( data );
+      values.assign( first, first + count );
+    }
+  }
+  uint64_t getUnsigned() {
+    uint64_t value = 0;
+    const char * data = take( sizeof(value) );
+    if ( data ) memcpy( &value, data, sizeof(value) );
+    return value;
+  }
+  void getStrings( std::vector<std::string> & strings, size_t count ) {
+    const char * offsets = take( (count + 1) * sizeof(uint64_t) );
+    if ( ! offsets ) return;
+    uint64_t total;
+    memcpy( &total, offsets + count * sizeof(uint64_t), sizeof(total) );
+    const char * characters = take( total );
+    if ( ! characters ) return;
+    strings.resize( count );
+    uint64_t start;
+    memcpy( &start, offsets, sizeof(start) );
+    for ( size_t i = 0; i < count; ++i ) {
+      uint64_t next;
+      memcpy( &next, offsets + (i + 1) * sizeof(uint64_t), sizeof(next) );
+      if ( next < start || next > total ) {
+        my_position = 0;
+        return;
+      }
+      strings[i].assign( characters + start, next - start );
+      start = next;
+    }
+  }
+
+private:
+  /// @return pointer to the next size bytes (and skips the padding after
+  /// them), or 0 if the payload is too short
+  const char * take( size_t size ) {
+    if ( ! my_position ) return 0;
+    size_t padded = (size + 7) & ~static_cast<size_t>( 7 );
+    if ( static_cast<size_t>( my_end - my_position ) < padded ) {
+      my_position = 0;
+      return 0;
+    }
+    const char * data = my_position;
+    my_position += padded;
+    return data;
+  }
+
+  const char * my_position;
+  const char * my_end;
+};
+
+std::string
+ModelCache::cacheFileName( const std::string & source_file_name,
+                           const std::string & directory )
+{
+  if ( directory.empty() ) return source_file_name + "b";
+  std::string::size_type start_of_basename = source_file_name.find_last_of( "/" );
+  std::string basename = (start_of_basename == std::string::npos)
+    ? source_file_name : source_file_name.substr( start_of_basename + 1 );
+  return directory + "/" + basename + "b";
+}
+
+bool
+ModelCache::load( const std::string & cache_file_name,
+                  const std::string & source_file_name,
+                  LpModel & model )
+{
+  my_error_message = "";
+  MappedFile cache;
+  if ( ! cache.open( cache_file_name ) ) return fail( cache.errorMessage() );
+  CacheHeader header;
+  if ( cache.size() < sizeof(header) ) return fail( "truncated header" );
+  memcpy( &header, cache.begin(), sizeof(header) );
+  if ( memcmp( header.magic, MAGIC, sizeof(MAGIC) ) != 0 ) {
+    return fail( "not a model cache file" );
+  }
+  if ( header.version != FORMAT_VERSION ) {
+    return fail( "cache file has a different format version" );
+  }
+
+  MappedFile source;
+  if ( ! source.open( source_file_name ) ) return fail( source.errorMessage() );
+  if ( header.source_size != source.size()
+       || header.source_modification_time != source.modificationTime()
+       || header.source_hash != source_signature( source ) ) {
+    return fail( "cache file is older than " + source_file_name );
+  }
+
+  const char * payload = cache.begin() + sizeof(header);
+  if ( header.payload_size != cache.size() - sizeof(header) ) {
+    return fail( "cache file has the wrong size" );
+  }
+  if ( hash_words( payload, header.payload_size, 0 )
+       != header.payload_checksum ) {
+    return fail( "checksum mismatch" );
+  }
+
+  const size_t columns = header.columns;
+  const size_t rows = header.rows;
+  const size_t nonzeros = header.nonzeros;
+  PayloadReader reader( payload, cache.end() );
+  model.clear();
+  model.my_minimize = header.minimize != 0;
+  model.my_objective_offset = header.objective_offset;
+  std::vector<std::string> objective_name;
+  reader.getStrings( objective_name, 1 );
+  reader.getStrings( model.my_column_names, columns );
+  reader.getArray( model.my_objective, columns );
+  reader.getArray( model.my_lower_bounds, columns );
+  reader.getArray( model.my_upper_bounds, columns );
+  reader.getArray( model.my_column_types, columns );
+  reader.getStrings( model.my_row_names, rows );
+  reader.getArray( model.my_row_starts, rows + 1 );
+  reader.getArray( model.my_row_columns, nonzeros );
+  reader.getArray( model.my_row_values, nonzeros );
+  reader.getArray( model.my_row_senses, rows );
+  reader.getArray( model.my_rhs, rows );
+  if ( ! reader.ok() ) {
+    model.clear();
+    return fail( "cache file is inconsistent" );
+  }
+  model.my_objective_name = objective_name[0];
+  model.my_position_in_row.assign( columns, -1 );
+  size_t slots = 1024;
+  while ( slots < 2 * columns ) slots *= 2;
+  model.rebuildHashTable( slots );
+  return true;
+}
+
+bool
+ModelCache::write( const std::string & cache_file_name,
+                   const std::string & source_file_name,
+                   const LpModel & model )
+{
+  my_error_message = "";
+  MappedFile source;
+  if ( ! source.open( source_file_name ) ) return fail( source.errorMessage() );
+
+  std::ostringstream temporary_name;
+  temporary_name << cache_file_name << ".tmp." << getpid();
+  std::ofstream out( temporary_name.str().c_str(),
+                     std::ios::out | std::ios::binary | std::ios::trunc );
+  if ( ! out ) return fail( "unable to create " + temporary_name.str() );
+
+  CacheHeader header;
+  memset( &header, 0, sizeof(header) );
+  memcpy( header.magic, MAGIC, sizeof(MAGIC) );
+  header.version = FORMAT_VERSION;
+  header.source_size = source.size();
+  header.source_modification_time = source.modificationTime();
+  header.source_hash = source_signature( source );
+  header.minimize = model.minimize() ? 1 : 0;
+  header.columns = model.numberOfColumns();
+  header.rows = model.numberOfRows();
+  header.nonzeros = model.numberOfNonZeros();
+  header.objective_offset = model.objectiveOffset();
+  // header is rewritten once the checksum is known
+  out.write( reinterpret_cast<const char *>( &header ), sizeof(header) );
+
+  PayloadWriter writer( out );
+  writer.putStrings( std::vector<std::string>( 1, model.objectiveName() ) );
+  writer.putStrings( model.my_column_names );
+  writer.putArray( model.my_objective );
+  writer.putArray( model.my_lower_bounds );
+  writer.putArray( model.my_upper_bounds );
+  writer.putArray( model.my_column_types );
+  writer.putStrings( model.my_row_names );
+  writer.putArray( model.my_row_starts );
+  writer.putArray( model.my_row_columns );
+  writer.putArray( model.my_row_values );
+  writer.putArray( model.my_row_senses );
+  writer.putArray( model.my_rhs );
+
+  header.payload_size = writer.size();
+  header.payload_checksum = writer.checksum();
+  out.seekp( 0 );
+  out.write( reinterpret_cast<const char *>( &header ), sizeof(header) );
+  out.close();
+  if ( ! out ) {
+    unlink( temporary_name.str().c_str() );
+    return fail( "error writing " + temporary_name.str() );
+  }
+  if ( rename( temporary_name.str().c_str(), cache_file_name.c_str() ) != 0 ) {
+    unlink( temporary_name.str().c_str() );
+    return fail( "unable to rename " + temporary_name.str() + " to "
+                 + cache_file_name );
+  }
+  return true;
+}
+
+bool
+ModelCache::fail( const std::string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+//  [Last modified: 2026 10 17 at 16:05:44 GMT]
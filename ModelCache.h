@@ -0,0 +1,62 @@
+/**
+ * @file ModelCache.h
+ * @brief Binary snapshots (.lpxb files) of a parsed LpModel, so that
+ * repeated runs on the same instance skip the text parse
+ *
+ * A cache file has a fixed header (magic number, format version,
+ * dimensions, a signature of the source file and a checksum of everything
+ * after the header) followed by the column names, bounds, types and
+ * objective and the CSR rows, each array padded to a multiple of 8 bytes.
+ * A cache file is used only if it is intact and the source file still has
+ * the size, modification time and sampled content hash recorded in it.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef MODELCACHE_H
+#define MODELCACHE_H
+
+#include<string>
+#include"LpModel.h"
+
+/// Usage:
+///   ModelCache cache;
+///   string cache_file = ModelCache::cacheFileName(source, directory);
+///   if ( ! cache.load(cache_file, source, model) ) {
+///     ... parse source into model
+///     cache.write(cache_file, source, model);
+///   }
+class ModelCache {
+public:
+  /// incremented whenever the layout of a cache file changes
+  static const unsigned FORMAT_VERSION = 1;
+
+  /// @return the cache file for the given source: source_file_name with a
+  /// 'b' appended (e.g., x.lpx -> x.lpxb), in the given directory or next
+  /// to the source if the directory is empty
+  static std::string cacheFileName( const std::string & source_file_name,
+                                    const std::string & directory );
+
+  /// @return true if model now holds the contents of the cache file; false
+  /// if the file is missing, damaged, from another version or stale
+  bool load( const std::string & cache_file_name,
+             const std::string & source_file_name,
+             LpModel & model );
+
+  /// writes the cache file (atomically, via a temporary file and rename)
+  /// @return true if successful
+  bool write( const std::string & cache_file_name,
+              const std::string & source_file_name,
+              const LpModel & model );
+
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  bool fail( const std::string & message );
+
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 16:05:44 GMT]
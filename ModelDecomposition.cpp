@@ -0,0 +1,128 @@
+/// @file ModelDecomposition.cpp
+/// @brief connected components of a model, as separate models
+
+#include"ModelDecomposition.h"
+#include"ClockTimer.h"
+#include"DisjointSets.h"
+#include<algorithm>
+
+void
+ModelDecomposition::decompose( const LpModel & model )
+{
+  double start = ClockTimer::wallClock();
+  my_components.clear();
+  my_columns.clear();
+  int number_of_rows = model.numberOfRows();
+  int number_of_columns = model.numberOfColumns();
+  my_number_of_columns = number_of_columns;
+  const std::vector<int> & row_columns = model.rowColumns();
+
+  DisjointSets sets( number_of_columns );
+  std::vector<bool> in_some_row( number_of_columns, false );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      in_some_row[ row_columns[k] ] = true;
+      if ( k > model.rowBegin( i ) ) sets.unite( row_columns[k - 1],
+                                                 row_columns[k] );
+    }
+  }
+
+  // number the components, columns in no row last, and count nonzeros
+  std::vector<int> component_of_set( number_of_columns, -1 );
+  std::vector<int> column_component( number_of_columns );
+  std::vector<size_t> nonzeros;
+  int empty_component = -1;
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    if ( ! in_some_row[j] ) continue;
+    int root = sets.find( j );
+    if ( component_of_set[root] < 0 ) {
+      component_of_set[root] = nonzeros.size();
+      nonzeros.push_back( 0 );
+    }
+    column_component[j] = component_of_set[root];
+  }
+  int connected = nonzeros.size();
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    if ( in_some_row[j] ) continue;
+    if ( empty_component < 0 ) {
+      empty_component = nonzeros.size();
+      nonzeros.push_back( 0 );
+    }
+    column_component[j] = empty_component;
+  }
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    if ( model.rowEnd( i ) > model.rowBegin( i ) ) {
+      nonzeros[ column_component[ row_columns[ model.rowBegin( i ) ] ] ]
+        += model.rowEnd( i ) - model.rowBegin( i );
+    }
+  }
+
+  // largest first; the component of columns in no row stays last
+  std::vector<int> order( nonzeros.size() );
+  for ( size_t c = 0; c < order.size(); ++c ) order[c] = c;
+  std::stable_sort( order.begin(), order.begin() + connected,
+                    [&nonzeros]( int a, int b ) {
+                      return nonzeros[a] > nonzeros[b];
+                    } );
+  std::vector<int> position( order.size() );
+  for ( size_t p = 0; p < order.size(); ++p ) position[ order[p] ] = p;
+  if ( order.empty() ) {
+    // no columns at all: the model is its own single component
+    order.push_back( 0 );
+    position.push_back( 0 );
+  }
+
+  my_components.resize( order.size() );
+  my_columns.resize( order.size() );
+  std::vector<int> local_index( number_of_columns );
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    size_t c = position[ column_component[j] ];
+    LpModel & component = my_components[c];
+    const std::string & name = model.columnName( j );
+    local_index[j] = component.findOrAddColumn( name.data(), name.size() );
+    component.setColumnType( local_index[j],
+                             LpModel::ColumnType( model.columnType( j ) ) );
+    component.setLowerBound( local_index[j], model.lowerBound( j ) );
+    component.setUpperBound( local_index[j], model.upperBound( j ) );
+    component.setObjectiveCoefficient( local_index[j],
+                                       model.objectiveCoefficient( j ) );
+    my_columns[c].push_back( j );
+  }
+  for ( size_t c = 0; c < my_components.size(); ++c ) {
+    my_components[c].setMinimize( model.minimize() );
+    my_components[c].setObjectiveName( model.objectiveName() );
+  }
+  my_components[0].setObjectiveOffset( model.objectiveOffset() );
+
+  const std::vector<double> & row_values = model.rowValues();
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    size_t c = 0;
+    if ( model.rowEnd( i ) > model.rowBegin( i ) ) {
+      c = position[ column_component[ row_columns[ model.rowBegin( i ) ] ] ];
+    }
+    LpModel & component = my_components[c];
+    component.beginRow( model.rowName( i ) );
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      component.addTerm( local_index[ row_columns[k] ], row_values[k] );
+    }
+    component.endRow( LpModel::RowSense( model.rowSense( i ) ),
+                      model.rightHandSide( i ) );
+  }
+  my_time = ClockTimer::wallClock() - start;
+}
+
+std::vector<double>
+ModelDecomposition::combine( const std::vector< std::vector<double> > & values )
+  const
+{
+  std::vector<double> combined( my_number_of_columns, 0 );
+  for ( size_t c = 0; c < my_columns.size() && c < values.size(); ++c ) {
+    for ( size_t k = 0; k < my_columns[c].size() && k < values[c].size();
+          ++k ) {
+      combined[ my_columns[c][k] ] = values[c][k];
+    }
+  }
+  return combined;
+}
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
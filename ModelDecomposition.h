@@ -0,0 +1,61 @@
+/**
+ * @file ModelDecomposition.h
+ * @brief Splitting of a model into the connected components of its
+ * variable-constraint graph (-decompose), so that each can be solved as a
+ * separate, smaller problem
+ *
+ * Two columns are connected if some row has nonzeros in both; the
+ * components are found with union-find over the rows of the CSR matrix.
+ * Each component becomes an LpModel of its own with the columns and rows
+ * of the original (same names, bounds, types, objective coefficients and
+ * sense), so that the objective of the original is the sum of those of
+ * the components. Columns in no row are gathered into one more component,
+ * rows without nonzeros go into the first one (they can only make it
+ * infeasible) and so does the objective offset. Components are ordered by
+ * number of nonzeros, largest first, which is also a good order in which
+ * to start solving them.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef MODELDECOMPOSITION_H
+#define MODELDECOMPOSITION_H
+
+#include<vector>
+#include<cstddef>
+#include"LpModel.h"
+
+/// Usage:
+///   ModelDecomposition decomposition;
+///   decomposition.decompose(model);
+///   for ( size_t c = 0; c < decomposition.numberOfComponents(); ++c )
+///     ... solve decomposition.component(c); column k of it is column
+///         decomposition.columns(c)[k] of model
+class ModelDecomposition {
+public:
+  ModelDecomposition(): my_number_of_columns( 0 ), my_time( 0 ) {}
+
+  /// replaces the components with those of model
+  void decompose( const LpModel & model );
+
+  size_t numberOfComponents() const { return my_components.size(); }
+  const LpModel & component( size_t c ) const { return my_components[c]; }
+  /// indices, in the original model, of the columns of component c
+  const std::vector<int> & columns( size_t c ) const { return my_columns[c]; }
+  /// @return values of the columns of the original model, given the
+  /// values of the columns of each component
+  std::vector<double>
+  combine( const std::vector< std::vector<double> > & values ) const;
+  /// time taken by decompose()
+  double time() const { return my_time; }
+
+private:
+  size_t my_number_of_columns;
+  std::vector<LpModel> my_components;
+  std::vector< std::vector<int> > my_columns;
+  double my_time;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -0,0 +1,175 @@
+/// @file ModelFeatures.cpp
+/// @brief computation of instance statistics from an LpModel
+
+#include"ModelFeatures.h"
+#include"ClockTimer.h"
+#include"DisjointSets.h"
+#include<algorithm>
+#include<cmath>
+
+/// running minimum, maximum, mean and standard deviation
+class Distribution {
+public:
+  Distribution(): my_count( 0 ), my_sum( 0 ), my_sum_of_squares( 0 ),
+                  my_min( 0 ), my_max( 0 ) {}
+  void add( double x ) {
+    if ( my_count == 0 || x < my_min ) my_min = x;
+    if ( my_count == 0 || x > my_max ) my_max = x;
+    ++my_count;
+    my_sum += x;
+    my_sum_of_squares += x * x;
+  }
+  double min() const { return my_min; }
+  double max() const { return my_max; }
+  double mean() const { return my_count > 0 ? my_sum / my_count : 0; }
+  double deviation() const {
+    if ( my_count == 0 ) return 0;
+    double variance = my_sum_of_squares / my_count - mean() * mean();
+    return variance > 0 ? std::sqrt( variance ) : 0;
+  }
+private:
+  size_t my_count;
+  double my_sum;
+  double my_sum_of_squares;
+  double my_min;
+  double my_max;
+};
+
+static double fraction( double part, double whole )
+{
+  return whole > 0 ? part / whole : 0;
+}
+
+/// @return log10 of the ratio of the largest to the smallest magnitude in
+/// distribution, 0 if it is empty
+static double magnitude_range( const Distribution & magnitudes )
+{
+  return magnitudes.min() > 0 ? std::log10( magnitudes.max() / magnitudes.min() )
+    : 0;
+}
+
+void
+ModelFeatures::compute( const LpModel & model )
+{
+  double start = ClockTimer::wallClock();
+  my_names.clear();
+  my_values.clear();
+  int number_of_rows = model.numberOfRows();
+  int number_of_columns = model.numberOfColumns();
+  const std::vector<int> & row_columns = model.rowColumns();
+  const std::vector<double> & row_values = model.rowValues();
+
+  // rows: degrees, coefficients, kinds, and the components they join
+  std::vector<int> column_degree( number_of_columns, 0 );
+  DisjointSets components( number_of_columns );
+  Distribution row_degree, coefficient, rhs;
+  int cover_rows = 0, packing_rows = 0, partitioning_rows = 0;
+  int equality_rows = 0;
+  size_t unit_coefficients = 0;
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    bool set_row = true;        // binary columns, coefficients 1
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      int j = row_columns[k];
+      double a = row_values[k];
+      ++column_degree[j];
+      coefficient.add( std::fabs( a ) );
+      if ( std::fabs( a ) == 1 ) ++unit_coefficients;
+      set_row = set_row && a == 1 && model.columnType( j ) == LpModel::BINARY;
+      if ( k > model.rowBegin( i ) ) components.unite( row_columns[k - 1], j );
+    }
+    row_degree.add( model.rowEnd( i ) - model.rowBegin( i ) );
+    rhs.add( std::fabs( model.rightHandSide( i ) ) );
+    char sense = model.rowSense( i );
+    if ( sense == LpModel::EQUAL ) ++equality_rows;
+    if ( set_row && model.rightHandSide( i ) == 1 ) {
+      if ( sense == LpModel::GREATER_EQUAL ) ++cover_rows;
+      else if ( sense == LpModel::LESS_EQUAL ) ++packing_rows;
+      else ++partitioning_rows;
+    }
+  }
+
+  // columns: degrees, types, objective
+  Distribution degree, objective;
+  int binaries = 0, integers = 0, continuous = 0, semicontinuous = 0;
+  int empty_columns = 0, largest_component = 0;
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    degree.add( column_degree[j] );
+    if ( model.objectiveCoefficient( j ) != 0 ) {
+      objective.add( std::fabs( model.objectiveCoefficient( j ) ) );
+    }
+    switch ( model.columnType( j ) ) {
+    case LpModel::BINARY: ++binaries; break;
+    case LpModel::INTEGER: ++integers; break;
+    case LpModel::SEMICONTINUOUS: ++semicontinuous; break;
+    default: ++continuous;
+    }
+    if ( column_degree[j] == 0 ) ++empty_columns;
+    else largest_component = std::max( largest_component,
+                                       components.setSize( j ) );
+  }
+
+  double nonzeros = model.numberOfNonZeros();
+  add( "variables", number_of_columns );
+  add( "constraints", number_of_rows );
+  add( "nonzeros", nonzeros );
+  add( "density", fraction( nonzeros,
+                            static_cast<double>( number_of_rows )
+                            * number_of_columns ) );
+  add( "minimize", model.minimize() );
+  add( "row_degree_min", row_degree.min() );
+  add( "row_degree_max", row_degree.max() );
+  add( "row_degree_mean", row_degree.mean() );
+  add( "row_degree_std", row_degree.deviation() );
+  add( "column_degree_min", degree.min() );
+  add( "column_degree_max", degree.max() );
+  add( "column_degree_mean", degree.mean() );
+  add( "column_degree_std", degree.deviation() );
+  add( "coefficient_min", coefficient.min() );
+  add( "coefficient_max", coefficient.max() );
+  add( "coefficient_range", magnitude_range( coefficient ) );
+  add( "unit_coefficient_fraction", fraction( unit_coefficients, nonzeros ) );
+  add( "objective_min", objective.min() );
+  add( "objective_max", objective.max() );
+  add( "objective_range", magnitude_range( objective ) );
+  add( "rhs_min", rhs.min() );
+  add( "rhs_max", rhs.max() );
+  add( "binary_fraction", fraction( binaries, number_of_columns ) );
+  add( "integer_fraction", fraction( integers, number_of_columns ) );
+  add( "continuous_fraction", fraction( continuous, number_of_columns ) );
+  add( "semicontinuous_fraction", fraction( semicontinuous,
+                                            number_of_columns ) );
+  add( "cover_row_fraction", fraction( cover_rows, number_of_rows ) );
+  add( "packing_row_fraction", fraction( packing_rows, number_of_rows ) );
+  add( "partitioning_row_fraction", fraction( partitioning_rows,
+                                              number_of_rows ) );
+  add( "equality_row_fraction", fraction( equality_rows, number_of_rows ) );
+  add( "empty_columns", empty_columns );
+  add( "components", components.numberOfSets() - empty_columns );
+  add( "largest_component_fraction", fraction( largest_component,
+                                               number_of_columns ) );
+  my_time = ClockTimer::wallClock() - start;
+}
+
+void
+ModelFeatures::add( const std::string & name, double value )
+{
+  std::vector<std::string>::iterator existing
+    = std::find( my_names.begin(), my_names.end(), name );
+  if ( existing != my_names.end() ) {
+    my_values[ existing - my_names.begin() ] = value;
+    return;
+  }
+  my_names.push_back( name );
+  my_values.push_back( value );
+}
+
+double
+ModelFeatures::value( const std::string & name ) const
+{
+  std::vector<std::string>::const_iterator existing
+    = std::find( my_names.begin(), my_names.end(), name );
+  if ( existing == my_names.end() ) return NAN;
+  return my_values[ existing - my_names.begin() ];
+}
+
+//  [Last modified: 2026 10 17 at 22:51:20 GMT]
@@ -0,0 +1,55 @@
+/**
+ * @file ModelFeatures.h
+ * @brief Instance statistics used to characterize a model for algorithm
+ * selection (-features): sizes, row and column degree distributions,
+ * coefficient ranges, variable types, kinds of rows and connected
+ * components of the variable-constraint graph
+ *
+ * All of them come from one pass over the rows of the parsed model and
+ * one over its columns; nothing is solved. Callers can add features of
+ * their own (cplex_ilp adds statistics of the root LP relaxation). The
+ * features are kept in the order computed, so that the vectors of two
+ * instances can be compared element by element.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef MODELFEATURES_H
+#define MODELFEATURES_H
+
+#include<string>
+#include<vector>
+#include<cstddef>
+#include"LpModel.h"
+
+/// Usage:
+///   ModelFeatures features;
+///   features.compute(model);
+///   for ( size_t i = 0; i < features.size(); ++i )
+///     ... features.name(i), features.value(i)
+class ModelFeatures {
+public:
+  ModelFeatures(): my_time( 0 ) {}
+
+  /// replaces the features with those of model
+  void compute( const LpModel & model );
+  /// appends a feature (or replaces the value of an existing one)
+  void add( const std::string & name, double value );
+
+  size_t size() const { return my_names.size(); }
+  const std::string & name( size_t i ) const { return my_names[i]; }
+  double value( size_t i ) const { return my_values[i]; }
+  /// @return the value of the named feature, NaN if there is none
+  double value( const std::string & name ) const;
+  /// time taken by compute()
+  double time() const { return my_time; }
+
+private:
+  std::vector<std::string> my_names;
+  std::vector<double> my_values;
+  double my_time;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 22:51:20 GMT]
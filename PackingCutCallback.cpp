@@ -0,0 +1,50 @@
+/// @file PackingCutCallback.cpp
+/// @brief clique and odd-hole cuts for -packing_cuts
+
+#include "PackingCutCallback.h"
+
+ILOSTLBEGIN
+
+/// violation that counts for a cut: smaller ones hardly move the bound
+static const double CUT_TOLERANCE = 1e-3;
+
+/// cuts added per call, at most
+static const size_t MAX_CUTS_PER_CALL = 100;
+
+void
+PackingCutCallbackI::main()
+{
+  if ( isAfterCutLoop() ) return;
+  IloNumArray values( getEnv() );
+  getValues( values, my_var );
+  vector<double> x( values.getSize() );
+  for ( IloInt j = 0; j < values.getSize(); ++j ) x[j] = values[j];
+  values.end();
+  vector<PackingCutSeparator::Cut> cuts;
+  my_separator->separate( x, CUT_TOLERANCE, MAX_CUTS_PER_CALL, cuts );
+  for ( size_t c = 0; c < cuts.size(); ++c ) {
+    IloExpr lhs( getEnv() );
+    for ( size_t k = 0; k < cuts[c].columns.size(); ++k ) {
+      lhs += cuts[c].coefficients[k] * my_var[ cuts[c].columns[k] ];
+    }
+    add( IloRange( getEnv(), -IloInfinity, lhs, cuts[c].rhs ),
+         IloCplex::UseCutPurge ).end();
+    lhs.end();
+  }
+}
+
+IloCplex::CallbackI *
+PackingCutCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) PackingCutCallbackI( *this ));
+}
+
+IloCplex::Callback
+packingCutCallback( IloEnv env, const IloNumVarArray var,
+                    PackingCutSeparator * separator )
+{
+  return IloCplex::Callback( new (env) PackingCutCallbackI( env, var,
+                                                            separator ) );
+}
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
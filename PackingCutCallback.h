@@ -0,0 +1,39 @@
+/**
+ * @file PackingCutCallback.h
+ * @brief User cut callback that adds the clique and odd-hole inequalities
+ * a PackingCutSeparator finds (-packing_cuts)
+ *
+ * The cuts are added as purgeable, so that CPLEX may drop them again when
+ * they stop being useful. CPLEX calls the callback from each of its
+ * threads; the separator is shared.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef PACKINGCUTCALLBACK_H
+#define PACKINGCUTCALLBACK_H
+
+#include <ilcplex/ilocplex.h>
+#include "PackingCutSeparator.h"
+
+class PackingCutCallbackI: public IloCplex::UserCutCallbackI {
+public:
+  PackingCutCallbackI( IloEnv env, const IloNumVarArray var,
+                       PackingCutSeparator * separator ):
+    IloCplex::UserCutCallbackI( env ), my_var( var ),
+    my_separator( separator ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  IloNumVarArray my_var;
+  PackingCutSeparator * my_separator;
+};
+
+/// @return a callback for IloCplex::use() that cuts off fractional
+/// solutions with the inequalities of separator (over the columns var)
+IloCplex::Callback packingCutCallback( IloEnv env, const IloNumVarArray var,
+                                       PackingCutSeparator * separator );
+
+#endif
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
@@ -0,0 +1,345 @@
+/// @file PackingCutSeparator.cpp
+/// @brief clique and odd-hole cuts from the conflict graph
+
+#include"PackingCutSeparator.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<functional>
+#include<queue>
+#include<set>
+#include<utility>
+#include<stdint.h>
+
+/// literals this close to 0 or 1 are not in the support
+static const double SUPPORT_EPSILON = 1e-6;
+
+/// literals in the support, at most (the most valuable)
+static const size_t MAX_SUPPORT = 2000;
+
+/// literals outside the support tried to make a clique maximal, at most
+static const int MAX_LIFT_CANDIDATES = 1000;
+
+struct PackingCutSeparator::Support {
+  std::vector<int> literals;            // most valuable first
+  std::vector<double> values;
+  size_t words;
+  std::vector<uint64_t> adjacency;      // a bitset of words per literal
+  const uint64_t * row( int a ) const { return &adjacency[ a * words ]; }
+};
+
+/// position of the lowest bit set in word (not 0)
+static inline int first_bit( uint64_t word )
+{
+  return __builtin_ctzll( word );
+}
+
+static bool more_violated( const PackingCutSeparator::Cut & a,
+                           const PackingCutSeparator::Cut & b )
+{
+  return a.violation > b.violation;
+}
+
+static double literal_value( const std::vector<double> & x, int literal )
+{
+  double value = x[ ConflictGraph::column( literal ) ];
+  return ConflictGraph::complemented( literal ) ? 1 - value : value;
+}
+
+const char *
+PackingCutSeparator::familyName( Family family )
+{
+  switch ( family ) {
+  case CLIQUE: return "clique";
+  case ODD_HOLE: return "odd_hole";
+  default: return "unknown";
+  }
+}
+
+PackingCutSeparator::PackingCutSeparator( const ConflictGraph & graph ):
+  my_graph( graph ),
+  my_time_budget( 0.01 ),
+  my_calls( 0 )
+{
+  for ( int f = 0; f < NUMBER_OF_FAMILIES; ++f ) {
+    my_cuts[f] = 0;
+    my_time[f] = 0;
+  }
+}
+
+size_t
+PackingCutSeparator::separate( const std::vector<double> & x,
+                               double tolerance, size_t limit,
+                               std::vector<Cut> & cuts )
+{
+  double start_time = ClockTimer::wallClock();
+  double deadline = start_time + my_time_budget;
+  cuts.clear();
+
+  // the support and its adjacency
+  Support support;
+  std::vector< std::pair<double, int> > candidates;
+  for ( int u = 0; u < my_graph.numberOfLiterals(); ++u ) {
+    if ( ! my_graph.hasConflicts( u ) ) continue;
+    double value = literal_value( x, u );
+    if ( value > SUPPORT_EPSILON && value < 1 - SUPPORT_EPSILON ) {
+      candidates.push_back( std::make_pair( value, u ) );
+    }
+  }
+  std::sort( candidates.begin(), candidates.end(),
+             std::greater< std::pair<double, int> >() );
+  if ( candidates.size() > MAX_SUPPORT ) candidates.resize( MAX_SUPPORT );
+  const int size = candidates.size();
+  std::vector<int> local( my_graph.numberOfLiterals(), -1 );
+  for ( int a = 0; a < size; ++a ) {
+    support.values.push_back( candidates[a].first );
+    support.literals.push_back( candidates[a].second );
+    local[ candidates[a].second ] = a;
+  }
+  support.words = ( size + 63 ) >> 6;
+  support.adjacency.assign( size * support.words, 0 );
+  for ( int a = 0; a < size; ++a ) {
+    int u = support.literals[a];
+    uint64_t * row = &support.adjacency[ a * support.words ];
+    for ( const int * c = my_graph.cliquesOfBegin( u );
+          c != my_graph.cliquesOfEnd( u ); ++c ) {
+      for ( const int * v = my_graph.cliqueBegin( *c );
+            v != my_graph.cliqueEnd( *c ); ++v ) {
+        int b = local[*v];
+        if ( b >= 0 && b != a ) row[ b >> 6 ] |= uint64_t( 1 ) << (b & 63);
+      }
+    }
+  }
+  double support_time = ClockTimer::wallClock() - start_time;
+
+  // the cliques get half of what is left, the odd holes the rest
+  double clique_start = ClockTimer::wallClock();
+  separateCliques( support, tolerance, ( clique_start + deadline ) / 2, x,
+                   local, cuts );
+  double odd_hole_start = ClockTimer::wallClock();
+  separateOddHoles( support, tolerance, deadline, x, cuts );
+  double end_time = ClockTimer::wallClock();
+
+  std::sort( cuts.begin(), cuts.end(), more_violated );
+  if ( limit > 0 && cuts.size() > limit ) cuts.resize( limit );
+  long found[NUMBER_OF_FAMILIES] = { 0, 0 };
+  for ( size_t k = 0; k < cuts.size(); ++k ) ++found[ cuts[k].family ];
+
+  std::lock_guard<std::mutex> guard( my_lock );
+  ++my_calls;
+  for ( int f = 0; f < NUMBER_OF_FAMILIES; ++f ) my_cuts[f] += found[f];
+  // the support is shared; its time goes to the cliques, which come first
+  my_time[CLIQUE] += support_time + odd_hole_start - clique_start;
+  my_time[ODD_HOLE] += end_time - odd_hole_start;
+  return cuts.size();
+}
+
+void
+PackingCutSeparator::separateCliques( const Support & support,
+                                      double tolerance, double deadline,
+                                      const std::vector<double> & x,
+                                      const std::vector<int> & local,
+                                      std::vector<Cut> & cuts ) const
+{
+  const int size = support.literals.size();
+  std::vector<uint64_t> candidates( support.words );
+  std::set< std::vector<int> > found;
+  std::vector<int> clique;
+  for ( int a = 0; a < size; ++a ) {
+    if ( ClockTimer::wallClock() > deadline ) break;
+    std::copy( support.row( a ), support.row( a ) + support.words,
+               candidates.begin() );
+    clique.assign( 1, support.literals[a] );
+    double weight = support.values[a];
+    // the first bit left is the most valuable literal adjacent to all
+    size_t w = 0;
+    while ( true ) {
+      while ( w < support.words && candidates[w] == 0 ) ++w;
+      if ( w == support.words ) break;
+      int b = (w << 6) + first_bit( candidates[w] );
+      clique.push_back( support.literals[b] );
+      weight += support.values[b];
+      const uint64_t * row = support.row( b );
+      for ( size_t k = w; k < support.words; ++k ) candidates[k] &= row[k];
+    }
+    if ( weight <= 1 + tolerance ) continue;
+
+    // literals outside the support that conflict with all of the clique
+    int tried = 0;
+    int first = clique[0];
+    for ( const int * c = my_graph.cliquesOfBegin( first );
+          c != my_graph.cliquesOfEnd( first )
+            && tried < MAX_LIFT_CANDIDATES; ++c ) {
+      for ( const int * v = my_graph.cliqueBegin( *c );
+            v != my_graph.cliqueEnd( *c ) && tried < MAX_LIFT_CANDIDATES;
+            ++v ) {
+        if ( local[*v] >= 0 ) continue;
+        ++tried;
+        bool adjacent_to_all = true;
+        for ( size_t k = 0; k < clique.size() && adjacent_to_all; ++k ) {
+          adjacent_to_all = my_graph.adjacent( *v, clique[k] );
+        }
+        if ( adjacent_to_all ) clique.push_back( *v );
+      }
+    }
+    std::vector<int> sorted( clique );
+    std::sort( sorted.begin(), sorted.end() );
+    if ( found.insert( sorted ).second ) {
+      Cut cut = makeCut( CLIQUE, sorted, 1, x );
+      if ( cut.violation > tolerance ) cuts.push_back( cut );
+    }
+  }
+}
+
+void
+PackingCutSeparator::separateOddHoles( const Support & support,
+                                       double tolerance, double deadline,
+                                       const std::vector<double> & x,
+                                       std::vector<Cut> & cuts ) const
+{
+  typedef std::pair<double, int> Entry;
+  const int size = support.literals.size();
+  // cycles must weigh less than this to be violated by more than tolerance
+  const double max_weight = 1 - 2 * tolerance;
+  const double unreached = 2;
+  std::vector<double> distance( 2 * size, unreached );
+  std::vector<int> predecessor( 2 * size, -1 );
+  std::vector<int> touched;
+  std::set< std::vector<int> > found;
+  std::vector<int> cycle;
+  for ( int s = 0; s < size; ++s ) {
+    if ( ClockTimer::wallClock() > deadline ) break;
+    // node 2a + p is copy p of literal a; edges go between copies. A cycle
+    // s, t, ..., u is a path from copy 1 of a neighbor t of s to copy 0 of
+    // a neighbor u, through literals that are not neighbors of s -- which
+    // rules out triangles, the cliques
+    const uint64_t * neighbors = support.row( s );
+    for ( size_t k = 0; k < touched.size(); ++k ) {
+      distance[ touched[k] ] = unreached;
+      predecessor[ touched[k] ] = -1;
+    }
+    touched.clear();
+    std::priority_queue< Entry, std::vector<Entry>, std::greater<Entry> >
+      queue;
+    for ( size_t w = 0; w < support.words; ++w ) {
+      for ( uint64_t bits = neighbors[w]; bits; bits &= bits - 1 ) {
+        int t = (w << 6) + first_bit( bits );
+        double edge = std::max( 0.0, 1 - support.values[s]
+                                - support.values[t] );
+        distance[2 * t + 1] = edge;
+        touched.push_back( 2 * t + 1 );
+        queue.push( Entry( edge, 2 * t + 1 ) );
+      }
+    }
+    double best_weight = max_weight;
+    int best_end = -1;
+    while ( ! queue.empty() ) {
+      Entry entry = queue.top();
+      queue.pop();
+      int node = entry.second;
+      if ( entry.first > distance[node] ) continue;
+      if ( entry.first >= best_weight ) break;
+      int a = node / 2;
+      bool neighbor = ( neighbors[ a >> 6 ] >> (a & 63) ) & 1;
+      if ( neighbor && node % 2 == 0 ) {
+        // an end: close the cycle
+        double weight = entry.first
+          + std::max( 0.0, 1 - support.values[a] - support.values[s] );
+        if ( weight < best_weight ) {
+          best_weight = weight;
+          best_end = node;
+        }
+        continue;
+      }
+      int next_copy = 1 - node % 2;
+      const uint64_t * row = support.row( a );
+      for ( size_t w = 0; w < support.words; ++w ) {
+        for ( uint64_t bits = row[w]; bits; bits &= bits - 1 ) {
+          int b = (w << 6) + first_bit( bits );
+          if ( b == s ) continue;
+          bool end = ( neighbors[w] >> (b & 63) ) & 1;
+          if ( end && ( next_copy != 0 || neighbor ) ) continue;
+          double through = entry.first
+            + std::max( 0.0, 1 - support.values[a] - support.values[b] );
+          int next = 2 * b + next_copy;
+          if ( through < best_weight && through < distance[next] ) {
+            if ( distance[next] == unreached ) touched.push_back( next );
+            distance[next] = through;
+            predecessor[next] = node;
+            queue.push( Entry( through, next ) );
+          }
+        }
+      }
+    }
+    if ( best_end < 0 ) continue;
+
+    // the closed walk, cut down to a simple odd cycle
+    cycle.assign( 1, s );
+    for ( int node = best_end; node >= 0; node = predecessor[node] ) {
+      cycle.push_back( node / 2 );
+    }
+    bool simple = false;
+    while ( ! simple ) {
+      simple = true;
+      for ( size_t j = 1; j < cycle.size() && simple; ++j ) {
+        for ( size_t i = 0; i < j; ++i ) {
+          if ( cycle[i] != cycle[j] ) continue;
+          if ( ( j - i ) % 2 == 1 ) {
+            cycle = std::vector<int>( cycle.begin() + i, cycle.begin() + j );
+          }
+          else {
+            cycle.erase( cycle.begin() + i, cycle.begin() + j );
+          }
+          simple = false;
+          break;
+        }
+      }
+    }
+    if ( cycle.size() < 5 ) continue;
+    std::vector<int> literals;
+    for ( size_t k = 0; k < cycle.size(); ++k ) {
+      literals.push_back( support.literals[ cycle[k] ] );
+    }
+    std::sort( literals.begin(), literals.end() );
+    if ( found.insert( literals ).second ) {
+      Cut cut = makeCut( ODD_HOLE, literals, ( literals.size() - 1 ) / 2, x );
+      if ( cut.violation > tolerance ) cuts.push_back( cut );
+    }
+  }
+}
+
+PackingCutSeparator::Cut
+PackingCutSeparator::makeCut( Family family,
+                              const std::vector<int> & literals, double rhs,
+                              const std::vector<double> & x ) const
+{
+  // a complement 1 - x_j moves 1 to the right hand side
+  std::vector< std::pair<int, double> > terms;
+  for ( size_t k = 0; k < literals.size(); ++k ) {
+    int j = ConflictGraph::column( literals[k] );
+    if ( ConflictGraph::complemented( literals[k] ) ) {
+      terms.push_back( std::make_pair( j, -1.0 ) );
+      rhs -= 1;
+    }
+    else terms.push_back( std::make_pair( j, 1.0 ) );
+  }
+  std::sort( terms.begin(), terms.end() );
+  Cut cut;
+  cut.family = family;
+  cut.rhs = rhs;
+  double activity = 0;
+  for ( size_t k = 0; k < terms.size(); ++k ) {
+    double coefficient = terms[k].second;
+    // both literals of a column: x_j + (1 - x_j)
+    while ( k + 1 < terms.size() && terms[k + 1].first == terms[k].first ) {
+      coefficient += terms[++k].second;
+    }
+    if ( coefficient == 0 ) continue;
+    cut.columns.push_back( terms[k].first );
+    cut.coefficients.push_back( coefficient );
+    activity += coefficient * x[ terms[k].first ];
+  }
+  cut.violation = activity - rhs;
+  return cut;
+}
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
@@ -0,0 +1,101 @@
+/**
+ * @file PackingCutSeparator.h
+ * @brief Separation of clique and odd-hole inequalities on a ConflictGraph
+ * (-packing_cuts)
+ *
+ * Both work on the support of a fractional solution: the literals of the
+ * graph with a value strictly between 0 and 1, most valuable first, at
+ * most a few thousand of them, with their adjacency as one bitset per
+ * literal.
+ *
+ * Cliques: from each literal in turn, add the most valuable literal
+ * adjacent to all chosen so far -- the first bit of the intersection of
+ * their bitsets -- until there is none. A clique worth more than 1 is
+ * violated; it is then made maximal with literals outside the support
+ * (which cost nothing) before sum of its literals <= 1 is added.
+ *
+ * Odd holes: an odd cycle C of conflicts gives sum over C <= (|C| - 1) / 2.
+ * With edge weights 1 - l_u - l_v, which a solution of the rows makes
+ * nonnegative, it is violated iff the cycle weighs less than 1. The
+ * lightest odd cycle through a literal is the shortest path from it to
+ * its copy in the graph with two copies of each literal, where every edge
+ * goes from one copy to the other (Dijkstra, dense over the bitsets). A
+ * closed walk is cut down to a simple cycle, which doesn't make it
+ * heavier; cycles of 3 are cliques and are left to those.
+ *
+ * A call stops looking when its time budget runs out. The separator is
+ * shared by the threads of the callbacks; only the counts are locked.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef PACKINGCUTSEPARATOR_H
+#define PACKINGCUTSEPARATOR_H
+
+#include<vector>
+#include<mutex>
+#include<cstddef>
+#include"ConflictGraph.h"
+
+/// Usage:
+///   PackingCutSeparator separator( graph );
+///   separator.setTimeBudget( 0.01 );
+///   at each fractional x: separator.separate( x, tolerance, limit, cuts )
+///   and add sum of cut.coefficients x[cut.columns] <= cut.rhs for each
+class PackingCutSeparator {
+public:
+  enum Family { CLIQUE, ODD_HOLE, NUMBER_OF_FAMILIES };
+  static const char * familyName( Family family );
+
+  /// sum of coefficients[k] x[columns[k]] <= rhs
+  struct Cut {
+    Family family;
+    std::vector<int> columns;
+    std::vector<double> coefficients;
+    double rhs;
+    double violation;
+  };
+
+  explicit PackingCutSeparator( const ConflictGraph & graph );
+
+  /// seconds a call may take, about
+  void setTimeBudget( double seconds ) { my_time_budget = seconds; }
+
+  /// finds inequalities x (a value per column) violates by more than
+  /// tolerance, the limit most violated of them (0 = all)
+  /// @return the number found, which are put in cuts
+  size_t separate( const std::vector<double> & x, double tolerance,
+                   size_t limit, std::vector<Cut> & cuts );
+
+  long calls() const { return my_calls; }
+  long cuts( Family family ) const { return my_cuts[family]; }
+  double time( Family family ) const { return my_time[family]; }
+
+private:
+  /// the support of a solution, with its adjacency
+  struct Support;
+
+  /// local says where each literal is in the support, -1 if it isn't
+  void separateCliques( const Support & support, double tolerance,
+                        double deadline, const std::vector<double> & x,
+                        const std::vector<int> & local,
+                        std::vector<Cut> & cuts ) const;
+  void separateOddHoles( const Support & support, double tolerance,
+                         double deadline, const std::vector<double> & x,
+                         std::vector<Cut> & cuts ) const;
+  /// the cut sum of literals <= rhs, in terms of the columns
+  Cut makeCut( Family family, const std::vector<int> & literals, double rhs,
+               const std::vector<double> & x ) const;
+
+  const ConflictGraph & my_graph;
+  double my_time_budget;
+
+  std::mutex my_lock;
+  long my_calls;
+  long my_cuts[NUMBER_OF_FAMILIES];
+  double my_time[NUMBER_OF_FAMILIES];
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 05:27:50 GMT]
@@ -0,0 +1,399 @@
+/// @file ParameterSelector.cpp
+/// @brief k nearest neighbor choice of settings from past runs
+
+#include"ParameterSelector.h"
+#include<fstream>
+#include<sstream>
+#include<algorithm>
+#include<cmath>
+#include<cstdlib>
+
+const char * const ParameterSelector::TUNED_FLAGS[] = {
+  "feasible", "nsel", "vsel", "lp", "heur", "rins", "dep", "probing",
+  "frac_cuts", "covers", 0
+};
+
+/// features of the root LP relaxation are left out, since -auto_params
+/// doesn't solve it
+static const char * const LP_FEATURE_PREFIX = "root_lp_";
+
+static const int FORMAT_VERSION = 1;
+
+static double transform( double x )
+{
+  return x < 0 ? -std::log1p( -x ) : std::log1p( x );
+}
+
+std::string
+ParameterSelector::settingName( const FlagList & flags )
+{
+  std::string name;
+  for ( const char * const * tuned = TUNED_FLAGS; *tuned; ++tuned ) {
+    for ( size_t f = 0; f < flags.size(); ++f ) {
+      if ( flags[f].first != *tuned ) continue;
+      if ( ! name.empty() ) name += " ";
+      name += "-" + flags[f].first + "=" + flags[f].second;
+    }
+  }
+  return name.empty() ? "default" : name;
+}
+
+FlagList
+ParameterSelector::settingFlags( const std::string & setting )
+{
+  FlagList flags;
+  std::istringstream words( setting );
+  std::string word;
+  while ( words >> word ) {
+    size_t equals = word.find( '=' );
+    if ( word[0] != '-' || equals == std::string::npos ) continue;
+    flags.push_back( std::make_pair( word.substr( 1, equals - 1 ),
+                                     word.substr( equals + 1 ) ) );
+  }
+  return flags;
+}
+
+ParameterSelector::ParameterSelector():
+  my_neighbors( 5 ),
+  my_penalty( 10 ),
+  my_fallback( 0 ),
+  my_unused_runs( 0 )
+{
+}
+
+bool
+ParameterSelector::fail( const std::string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+bool
+ParameterSelector::train( const std::map<std::string, ModelFeatures> & features,
+                          const std::vector<TrainingRun> & runs )
+{
+  my_error_message = "";
+  my_feature_names.clear();
+  my_settings.clear();
+  my_instances.clear();
+  my_points.clear();
+  my_scores.clear();
+  my_unused_runs = 0;
+
+  // mean score of each instance with each setting
+  std::map<std::string, size_t> setting_index;
+  std::map<std::string, size_t> instance_index;
+  for ( size_t r = 0; r < runs.size(); ++r ) {
+    if ( features.find( runs[r].instance ) == features.end() ) {
+      ++my_unused_runs;
+      continue;
+    }
+    setting_index[ runs[r].setting ] = 0;
+    instance_index[ runs[r].instance ] = 0;
+  }
+  if ( instance_index.empty() ) {
+    return fail( "no runs on instances with known features" );
+  }
+  for ( std::map<std::string, size_t>::iterator s = setting_index.begin();
+        s != setting_index.end(); ++s ) {
+    s->second = my_settings.size();
+    my_settings.push_back( s->first );
+  }
+  for ( std::map<std::string, size_t>::iterator i = instance_index.begin();
+        i != instance_index.end(); ++i ) {
+    i->second = my_instances.size();
+    my_instances.push_back( i->first );
+  }
+  std::vector< std::vector<double> > sums( my_instances.size(),
+                                           std::vector<double>( my_settings.size(), 0 ) );
+  std::vector< std::vector<int> > counts( my_instances.size(),
+                                          std::vector<int>( my_settings.size(), 0 ) );
+  for ( size_t r = 0; r < runs.size(); ++r ) {
+    if ( features.find( runs[r].instance ) == features.end() ) continue;
+    size_t i = instance_index[ runs[r].instance ];
+    size_t s = setting_index[ runs[r].setting ];
+    sums[i][s] += runs[r].timed_out ? my_penalty * runs[r].runtime
+      : runs[r].runtime;
+    ++counts[i][s];
+  }
+  my_scores.assign( my_instances.size(),
+                    std::vector<double>( my_settings.size(), NAN ) );
+  for ( size_t i = 0; i < my_instances.size(); ++i ) {
+    for ( size_t s = 0; s < my_settings.size(); ++s ) {
+      if ( counts[i][s] > 0 ) my_scores[i][s] = sums[i][s] / counts[i][s];
+    }
+  }
+
+  // features, standardized over the training instances
+  const ModelFeatures & first = features.find( my_instances[0] )->second;
+  for ( size_t f = 0; f < first.size(); ++f ) {
+    if ( first.name( f ).compare( 0, 8, LP_FEATURE_PREFIX ) == 0 ) continue;
+    my_feature_names.push_back( first.name( f ) );
+  }
+  size_t number_of_features = my_feature_names.size();
+  my_means.assign( number_of_features, 0 );
+  my_deviations.assign( number_of_features, 1 );
+  std::vector< std::vector<double> > raw( my_instances.size() );
+  for ( size_t i = 0; i < my_instances.size(); ++i ) {
+    const ModelFeatures & instance = features.find( my_instances[i] )->second;
+    for ( size_t f = 0; f < number_of_features; ++f ) {
+      double x = instance.value( my_feature_names[f] );
+      raw[i].push_back( std::isnan( x ) ? NAN : transform( x ) );
+    }
+  }
+  for ( size_t f = 0; f < number_of_features; ++f ) {
+    double sum = 0, sum_of_squares = 0;
+    int known = 0;
+    for ( size_t i = 0; i < raw.size(); ++i ) {
+      if ( std::isnan( raw[i][f] ) ) continue;
+      sum += raw[i][f];
+      sum_of_squares += raw[i][f] * raw[i][f];
+      ++known;
+    }
+    if ( known == 0 ) continue;
+    my_means[f] = sum / known;
+    double variance = sum_of_squares / known - my_means[f] * my_means[f];
+    if ( variance > 1e-12 ) my_deviations[f] = std::sqrt( variance );
+  }
+  for ( size_t i = 0; i < raw.size(); ++i ) {
+    std::vector<double> standardized( number_of_features, 0 );
+    for ( size_t f = 0; f < number_of_features; ++f ) {
+      if ( std::isnan( raw[i][f] ) ) continue;
+      standardized[f] = (raw[i][f] - my_means[f]) / my_deviations[f];
+    }
+    my_points.push_back( standardized );
+  }
+
+  // fallback: best mean score among the settings most widely run
+  size_t most_runs = 0;
+  std::vector<size_t> runs_of( my_settings.size(), 0 );
+  for ( size_t s = 0; s < my_settings.size(); ++s ) {
+    for ( size_t i = 0; i < my_instances.size(); ++i ) {
+      if ( ! std::isnan( my_scores[i][s] ) ) ++runs_of[s];
+    }
+    most_runs = std::max( most_runs, runs_of[s] );
+  }
+  double best_mean = HUGE_VAL;
+  for ( size_t s = 0; s < my_settings.size(); ++s ) {
+    if ( 2 * runs_of[s] < most_runs ) continue;
+    double sum = 0;
+    for ( size_t i = 0; i < my_instances.size(); ++i ) {
+      if ( ! std::isnan( my_scores[i][s] ) ) sum += my_scores[i][s];
+    }
+    if ( sum / runs_of[s] < best_mean ) {
+      best_mean = sum / runs_of[s];
+      my_fallback = s;
+    }
+  }
+  return true;
+}
+
+std::vector<double>
+ParameterSelector::point( const ModelFeatures & features ) const
+{
+  std::vector<double> standardized( my_feature_names.size(), 0 );
+  for ( size_t f = 0; f < my_feature_names.size(); ++f ) {
+    double x = features.value( my_feature_names[f] );
+    if ( std::isnan( x ) ) continue;
+    standardized[f] = (transform( x ) - my_means[f]) / my_deviations[f];
+  }
+  return standardized;
+}
+
+size_t
+ParameterSelector::choose( const std::vector<double> & point,
+                           int excluded ) const
+{
+  std::vector< std::pair<double, size_t> > distances;
+  for ( size_t i = 0; i < my_points.size(); ++i ) {
+    if ( static_cast<int>( i ) == excluded ) continue;
+    double distance = 0;
+    for ( size_t f = 0; f < point.size(); ++f ) {
+      double difference = point[f] - my_points[i][f];
+      distance += difference * difference;
+    }
+    distances.push_back( std::make_pair( distance, i ) );
+  }
+  size_t k = std::min( distances.size(),
+                       static_cast<size_t>( std::max( my_neighbors, 1 ) ) );
+  std::partial_sort( distances.begin(), distances.begin() + k,
+                     distances.end() );
+
+  size_t chosen = my_fallback;
+  double best_mean = HUGE_VAL;
+  for ( size_t s = 0; s < my_settings.size(); ++s ) {
+    double sum = 0;
+    size_t runs = 0;
+    for ( size_t n = 0; n < k; ++n ) {
+      double score = my_scores[ distances[n].second ][s];
+      if ( std::isnan( score ) ) continue;
+      sum += score;
+      ++runs;
+    }
+    if ( runs == 0 || 2 * runs < k ) continue;
+    if ( sum / runs < best_mean ) {
+      best_mean = sum / runs;
+      chosen = s;
+    }
+  }
+  return chosen;
+}
+
+size_t
+ParameterSelector::select( const ModelFeatures & features ) const
+{
+  if ( my_settings.empty() ) return 0;
+  return choose( point( features ), -1 );
+}
+
+size_t
+ParameterSelector::evaluate( size_t & best_single, double & best_single_mean,
+                             double & virtual_best_mean,
+                             double & selected_mean ) const
+{
+  std::vector<size_t> complete;
+  for ( size_t i = 0; i < my_instances.size(); ++i ) {
+    bool all_run = true;
+    for ( size_t s = 0; s < my_settings.size() && all_run; ++s ) {
+      all_run = ! std::isnan( my_scores[i][s] );
+    }
+    if ( all_run ) complete.push_back( i );
+  }
+  best_single = 0;
+  best_single_mean = virtual_best_mean = selected_mean = NAN;
+  if ( complete.empty() ) return 0;
+  best_single_mean = HUGE_VAL;
+  for ( size_t s = 0; s < my_settings.size(); ++s ) {
+    double sum = 0;
+    for ( size_t c = 0; c < complete.size(); ++c ) {
+      sum += my_scores[ complete[c] ][s];
+    }
+    if ( sum / complete.size() < best_single_mean ) {
+      best_single_mean = sum / complete.size();
+      best_single = s;
+    }
+  }
+  double virtual_best = 0, selected = 0;
+  for ( size_t c = 0; c < complete.size(); ++c ) {
+    size_t i = complete[c];
+    virtual_best += *std::min_element( my_scores[i].begin(),
+                                       my_scores[i].end() );
+    selected += my_scores[i][ choose( my_points[i], i ) ];
+  }
+  virtual_best_mean = virtual_best / complete.size();
+  selected_mean = selected / complete.size();
+  return complete.size();
+}
+
+bool
+ParameterSelector::write( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ofstream out( file_name.c_str() );
+  if ( ! out ) return fail( "unable to create " + file_name );
+  out.precision( 17 );
+  out << "ParameterSelectorVersion\t" << FORMAT_VERSION << "\n";
+  out << "Neighbors\t" << my_neighbors << "\n";
+  out << "Fallback\t" << my_fallback << "\n";
+  out << "Features\t" << my_feature_names.size() << "\n";
+  for ( size_t f = 0; f < my_feature_names.size(); ++f ) {
+    out << my_feature_names[f] << "\t" << my_means[f] << "\t"
+        << my_deviations[f] << "\n";
+  }
+  out << "Settings\t" << my_settings.size() << "\n";
+  for ( size_t s = 0; s < my_settings.size(); ++s ) {
+    out << my_settings[s] << "\n";
+  }
+  out << "Instances\t" << my_instances.size() << "\n";
+  for ( size_t i = 0; i < my_instances.size(); ++i ) {
+    out << my_instances[i];
+    for ( size_t f = 0; f < my_points[i].size(); ++f ) {
+      out << "\t" << my_points[i][f];
+    }
+    for ( size_t s = 0; s < my_scores[i].size(); ++s ) {
+      out << "\t";
+      if ( std::isnan( my_scores[i][s] ) ) out << "-";
+      else out << my_scores[i][s];
+    }
+    out << "\n";
+  }
+  out.close();
+  if ( ! out ) return fail( "error writing " + file_name );
+  return true;
+}
+
+/// reads a line "tag<TAB>count"
+static bool read_count( std::istream & in, const std::string & tag,
+                        size_t & count )
+{
+  std::string line, word;
+  if ( ! getline( in, line ) ) return false;
+  std::istringstream fields( line );
+  return (fields >> word) && word == tag && (fields >> count);
+}
+
+bool
+ParameterSelector::read( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ifstream in( file_name.c_str() );
+  if ( ! in ) return fail( "unable to open " + file_name );
+  size_t version = 0, neighbors = 0, count = 0;
+  if ( ! read_count( in, "ParameterSelectorVersion", version )
+       || version != static_cast<size_t>( FORMAT_VERSION ) ) {
+    return fail( file_name + ": not a parameter selector model (version "
+                 + "line missing or wrong)" );
+  }
+  if ( ! read_count( in, "Neighbors", neighbors )
+       || ! read_count( in, "Fallback", my_fallback )
+       || ! read_count( in, "Features", count ) ) {
+    return fail( file_name + ": bad header" );
+  }
+  my_neighbors = neighbors;
+  my_feature_names.assign( count, "" );
+  my_means.assign( count, 0 );
+  my_deviations.assign( count, 1 );
+  std::string line;
+  for ( size_t f = 0; f < count; ++f ) {
+    if ( ! getline( in, line ) ) return fail( file_name + ": too few features" );
+    std::istringstream fields( line );
+    if ( ! (fields >> my_feature_names[f] >> my_means[f] >> my_deviations[f]) ) {
+      return fail( file_name + ": bad feature line " + line );
+    }
+  }
+  if ( ! read_count( in, "Settings", count ) ) {
+    return fail( file_name + ": expected Settings" );
+  }
+  my_settings.assign( count, "" );
+  for ( size_t s = 0; s < count; ++s ) {
+    if ( ! getline( in, my_settings[s] ) ) {
+      return fail( file_name + ": too few settings" );
+    }
+  }
+  if ( ! read_count( in, "Instances", count ) ) {
+    return fail( file_name + ": expected Instances" );
+  }
+  my_instances.assign( count, "" );
+  my_points.assign( count, std::vector<double>( my_feature_names.size() ) );
+  my_scores.assign( count, std::vector<double>( my_settings.size() ) );
+  for ( size_t i = 0; i < count; ++i ) {
+    if ( ! getline( in, line ) ) return fail( file_name + ": too few instances" );
+    std::istringstream fields( line );
+    fields >> my_instances[i];
+    for ( size_t f = 0; f < my_feature_names.size(); ++f ) {
+      fields >> my_points[i][f];
+    }
+    for ( size_t s = 0; s < my_settings.size(); ++s ) {
+      std::string score;
+      fields >> score;
+      my_scores[i][s] = score == "-" ? NAN : atof( score.c_str() );
+    }
+    if ( ! fields ) return fail( file_name + ": bad instance line " + line );
+  }
+  if ( my_fallback >= my_settings.size() && ! my_settings.empty() ) {
+    return fail( file_name + ": bad fallback setting" );
+  }
+  return true;
+}
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]
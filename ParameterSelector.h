@@ -0,0 +1,126 @@
+/**
+ * @file ParameterSelector.h
+ * @brief Choice of solver flags for an instance from the results of past
+ * runs on similar instances (-auto_params), by k nearest neighbors over
+ * the features of ModelFeatures
+ *
+ * Training (see train_params.cpp) takes the runtimes of runs with
+ * different settings -- combinations of the flags in TUNED_FLAGS -- on a
+ * set of instances whose features are known. Each instance is kept as a
+ * point (features transformed by sign(x) log(1 + |x|) and standardized)
+ * with its mean score for each setting it was run with; the score is the
+ * runtime, multiplied by a penalty factor (default 10, as in PAR10) for
+ * runs that timed out. An instance is given the setting with the lowest
+ * mean score over its k nearest training instances, counting only
+ * settings that at least half of them were run with; if there is none,
+ * the setting that does best over all training instances is used.
+ *
+ * The model file is plain text:
+ *     ParameterSelectorVersion<TAB>1
+ *     Neighbors<TAB>K
+ *     Fallback<TAB>S                      index of the overall best setting
+ *     Features<TAB>N
+ *     NAME<TAB>MEAN<TAB>DEVIATION         (N lines)
+ *     Settings<TAB>M
+ *     SETTING                             (M lines, e.g. -nsel=b -vsel=2)
+ *     Instances<TAB>P
+ *     NAME<TAB>N standardized features<TAB>M scores, - if not run
+ * with fields separated by tabs; the default setting is written default.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PARAMETERSELECTOR_H
+#define PARAMETERSELECTOR_H
+
+#include<string>
+#include<vector>
+#include<map>
+#include<utility>
+#include<cstddef>
+#include"ModelFeatures.h"
+
+/// one past run: an instance, the setting it was run with and the result
+struct TrainingRun {
+  std::string instance;
+  std::string setting;          // see ParameterSelector::settingName()
+  double runtime;
+  bool timed_out;
+};
+
+typedef std::vector< std::pair<std::string, std::string> > FlagList;
+
+/// Usage:
+///   ParameterSelector selector;
+///   if ( ! selector.read(model_file) ) error(selector.errorMessage());
+///   FlagList flags = ParameterSelector::settingFlags(
+///       selector.setting(selector.select(features)));
+class ParameterSelector {
+public:
+  /// flags (without -) that make up a setting, terminated by 0
+  static const char * const TUNED_FLAGS[];
+
+  /// @return the setting given by the tuned flags among flags, as
+  /// "-flag=value ..." in the order of TUNED_FLAGS ("default" if none)
+  static std::string settingName( const FlagList & flags );
+  /// @return the flags and values of a setting returned by settingName()
+  static FlagList settingFlags( const std::string & setting );
+
+  ParameterSelector();
+
+  void setNeighbors( int k ) { my_neighbors = k; }
+  void setTimeoutPenalty( double factor ) { my_penalty = factor; }
+
+  /// builds the model from runs on the instances in features (runs on
+  /// other instances are ignored; see unusedRuns())
+  /// @return false if there is nothing to train on
+  bool train( const std::map<std::string, ModelFeatures> & features,
+              const std::vector<TrainingRun> & runs );
+  bool read( const std::string & file_name );
+  bool write( const std::string & file_name );
+
+  /// @return the index of the setting chosen for an instance
+  size_t select( const ModelFeatures & features ) const;
+
+  size_t numberOfSettings() const { return my_settings.size(); }
+  const std::string & setting( size_t s ) const { return my_settings[s]; }
+  size_t numberOfInstances() const { return my_instances.size(); }
+  size_t numberOfFeatures() const { return my_feature_names.size(); }
+  int neighbors() const { return my_neighbors; }
+  size_t fallback() const { return my_fallback; }
+  size_t unusedRuns() const { return my_unused_runs; }
+
+  /// Compares, on the training instances that were run with every
+  /// setting, the mean score of the best single setting, of the best
+  /// setting for each instance (the virtual best) and of the settings
+  /// chosen with each instance left out of the training set.
+  /// @return the number of such instances
+  size_t evaluate( size_t & best_single, double & best_single_mean,
+                   double & virtual_best_mean, double & selected_mean ) const;
+
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  std::vector<double> point( const ModelFeatures & features ) const;
+  /// @return the setting chosen for point, ignoring training instance
+  /// excluded (-1 for none)
+  size_t choose( const std::vector<double> & point, int excluded ) const;
+  bool fail( const std::string & message );
+
+  int my_neighbors;
+  double my_penalty;
+  size_t my_fallback;
+  size_t my_unused_runs;
+  std::vector<std::string> my_feature_names;
+  std::vector<double> my_means;         // of the transformed features
+  std::vector<double> my_deviations;
+  std::vector<std::string> my_settings;
+  std::vector<std::string> my_instances;
+  std::vector< std::vector<double> > my_points;
+  std::vector< std::vector<double> > my_scores;  // NaN if not run
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]
@@ -0,0 +1,57 @@
+/// @file PhaseProfiler.cpp
+/// @brief per-phase timing
+
+#include"PhaseProfiler.h"
+#include"ClockTimer.h"
+
+size_t
+PhaseProfiler::index( const std::string & phase )
+{
+  for ( size_t i = 0; i < my_names.size(); ++i ) {
+    if ( my_names[i] == phase ) return i;
+  }
+  my_names.push_back( phase );
+  my_wall_times.push_back( 0 );
+  my_cpu_times.push_back( 0 );
+  return my_names.size() - 1;
+}
+
+void
+PhaseProfiler::begin( const std::string & phase )
+{
+  end();
+  my_current = index( phase );
+  my_wall_start = ClockTimer::wallClock();
+  my_cpu_start = ClockTimer::cpuClock();
+}
+
+void
+PhaseProfiler::end()
+{
+  if ( my_current == NO_PHASE ) return;
+  my_wall_times[ my_current ] += ClockTimer::wallClock() - my_wall_start;
+  my_cpu_times[ my_current ] += ClockTimer::cpuClock() - my_cpu_start;
+  my_current = NO_PHASE;
+}
+
+void
+PhaseProfiler::add( const std::string & phase, double wall_time,
+                    double cpu_time )
+{
+  size_t i = index( phase );
+  my_wall_times[i] += wall_time;
+  my_cpu_times[i] += cpu_time;
+}
+
+void
+PhaseProfiler::print( std::ostream & out ) const
+{
+  for ( size_t i = 0; i < my_names.size(); ++i ) {
+    out << "phase_" << my_names[i] << "\t" << my_wall_times[i] << std::endl;
+    if ( ! my_cpu ) continue;
+    out << "phase_" << my_names[i] << "_cpu\t" << my_cpu_times[i]
+        << std::endl;
+  }
+}
+
+//  [Last modified: 2026 10 18 at 09:26:40 GMT]
@@ -0,0 +1,69 @@
+/**
+ * @file PhaseProfiler.h
+ * @brief Wall and processor time of the consecutive phases of a run
+ * (argument parsing, file open, import, extract, presolve, root LP,
+ * branch and bound, output), reported as phase_* tags
+ *
+ * Phases are timed either by begin()/end() around the code itself or,
+ * for parts of a single solver call, by add() with times observed from
+ * callbacks.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PHASEPROFILER_H
+#define PHASEPROFILER_H
+
+#include<string>
+#include<vector>
+#include<iostream>
+
+/// Usage:
+///   PhaseProfiler profiler;
+///   profiler.begin("open");  ... open the file
+///   profiler.begin("import");  ... read it (ends "open")
+///   profiler.end();
+///   profiler.print(out);  // phase_open, phase_open_cpu, phase_import, ...
+/// A phase that is begun again accumulates time. Processor times are those
+/// of the whole process (see ClockTimer); when other runs share the process
+/// they mean nothing for this one, and cpu_times = false leaves them out.
+class PhaseProfiler {
+public:
+  explicit PhaseProfiler( bool cpu_times = true ):
+    my_cpu( cpu_times ), my_current( NO_PHASE ) {}
+
+  /// ends the current phase, if any, and starts the given one
+  void begin( const std::string & phase );
+  /// ends the current phase, if any
+  void end();
+  /// adds time measured elsewhere to a phase
+  void add( const std::string & phase, double wall_time, double cpu_time );
+
+  size_t numberOfPhases() const { return my_names.size(); }
+  const std::string & name( size_t i ) const { return my_names[i]; }
+  double wallTime( size_t i ) const { return my_wall_times[i]; }
+  double cpuTime( size_t i ) const { return my_cpu_times[i]; }
+  /// true if the processor times are reported
+  bool cpuTimes() const { return my_cpu; }
+
+  /// prints phase_NAME and phase_NAME_cpu (if cpuTimes()) for each phase,
+  /// in the order in which they first occurred
+  void print( std::ostream & out ) const;
+
+private:
+  static const size_t NO_PHASE = static_cast<size_t>( -1 );
+
+  size_t index( const std::string & phase );
+
+  std::vector<std::string> my_names;
+  std::vector<double> my_wall_times;
+  std::vector<double> my_cpu_times;
+  bool my_cpu;
+  size_t my_current;
+  double my_wall_start;
+  double my_cpu_start;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 09:26:40 GMT]
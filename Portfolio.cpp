@@ -0,0 +1,421 @@
+/// @file Portfolio.cpp
+/// @brief racing portfolio of parameter configurations
+
+#include "Portfolio.h"
+#include "LpParser.h"
+#include "CnfParser.h"
+#include "ClockTimer.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <thread>
+
+ILOSTLBEGIN
+
+/// built-in configurations, roughly in order of usefulness on the covering
+/// and partitioning instances in Examples
+static const char * const BUILTIN_CONFIGS[][3] = {
+  // name, flag, value (flag 0 = no flag)
+  { "default",     0,          0 },
+  { "nsel=d",      "nsel",     "d" },
+  { "vsel=s",      "vsel",     "s" },
+  { "feasible=3",  "feasible", "3" },
+  { "feasible=1",  "feasible", "1" },
+  { "vsel=p",      "vsel",     "p" },
+  { "nsel=e",      "nsel",     "e" },
+  { "lp=p",        "lp",       "p" },
+};
+static const unsigned NUMBER_OF_BUILTIN_CONFIGS
+  = sizeof( BUILTIN_CONFIGS ) / sizeof( BUILTIN_CONFIGS[0] );
+
+/// number of configurations for a plain -portfolio
+static const unsigned DEFAULT_PORTFOLIO_SIZE = 4;
+
+void builtinPortfolioConfigs( unsigned number_of_configs,
+                              vector<PortfolioConfig> & configs )
+{
+  if ( number_of_configs > NUMBER_OF_BUILTIN_CONFIGS ) {
+    number_of_configs = NUMBER_OF_BUILTIN_CONFIGS;
+  }
+  for ( unsigned i = 0; i < number_of_configs; ++i ) {
+    PortfolioConfig config;
+    config.name = BUILTIN_CONFIGS[i][0];
+    if ( BUILTIN_CONFIGS[i][1] ) {
+      config.flags.push_back( make_pair( string( BUILTIN_CONFIGS[i][1] ),
+                                         string( BUILTIN_CONFIGS[i][2] ) ) );
+    }
+    configs.push_back( config );
+  }
+}
+
+bool readPortfolioConfigs( const string & config_file_name,
+                           vector<PortfolioConfig> & configs )
+{
+  ifstream config_stream( config_file_name.c_str() );
+  if ( ! config_stream ) return false;
+  string line;
+  while ( getline( config_stream, line ) ) {
+    istringstream line_stream( line );
+    PortfolioConfig config;
+    string word;
+    while ( line_stream >> word ) {
+      if ( config.flags.empty() && word[0] == '#' ) break;
+      if ( word.size() < 2 || word[0] != '-' ) {
+        cerr << "Portfolio configuration: " << word << " is not a flag."
+             << endl;
+        return false;
+      }
+      string::size_type equals = word.find( '=' );
+      string flag = word.substr( 1, equals == string::npos ? string::npos
+                                                             : equals - 1 );
+      // a flag without = has value 0, as on the command line
+      string value = equals == string::npos ? "0" : word.substr( equals + 1 );
+      config.flags.push_back( make_pair( flag, value ) );
+      if ( ! config.name.empty() ) config.name += " ";
+      config.name += word.substr( 1 );
+    }
+    if ( config.flags.empty() ) continue;
+    configs.push_back( config );
+  }
+  return true;
+}
+
+PortfolioRace::PortfolioRace( unsigned number_of_racers ):
+  my_minimize( true ),
+  my_over( false ),
+  my_proved_winner( -1 ),
+  my_aborters( number_of_racers ),
+  my_attached( number_of_racers, false ),
+  my_solution_found( number_of_racers, false ),
+  my_values( number_of_racers, 0 ),
+  my_have_incumbent( false ),
+  my_incumbent_value( 0 ),
+  my_incumbent_source( 0 ),
+  my_incumbent_version( 0 )
+{
+}
+
+bool
+PortfolioRace::better( double value, double other ) const
+{
+  return my_minimize ? value < other : value > other;
+}
+
+bool
+PortfolioRace::isOver() const
+{
+  lock_guard<mutex> guard( my_mutex );
+  return my_over;
+}
+
+bool
+PortfolioRace::improves( double value ) const
+{
+  lock_guard<mutex> guard( my_mutex );
+  return ! my_have_incumbent || better( value, my_incumbent_value );
+}
+
+bool
+PortfolioRace::offerIncumbent( unsigned racer, double value,
+                               const vector<double> & values )
+{
+  lock_guard<mutex> guard( my_mutex );
+  if ( my_have_incumbent && ! better( value, my_incumbent_value ) ) {
+    return false;
+  }
+  my_have_incumbent = true;
+  my_incumbent_value = value;
+  my_incumbent = values;
+  my_incumbent_source = racer;
+  ++my_incumbent_version;
+  return true;
+}
+
+bool
+PortfolioRace::takeIncumbent( unsigned racer, unsigned & seen_version,
+                              double & value, vector<double> & values )
+{
+  lock_guard<mutex> guard( my_mutex );
+  if ( ! my_have_incumbent || my_incumbent_version == seen_version ) {
+    return false;
+  }
+  seen_version = my_incumbent_version;
+  if ( my_incumbent_source == racer ) return false;
+  value = my_incumbent_value;
+  values = my_incumbent;
+  return true;
+}
+
+unsigned
+PortfolioRace::sharedIncumbents() const
+{
+  lock_guard<mutex> guard( my_mutex );
+  return my_incumbent_version;
+}
+
+/// publishes the racer's improving incumbents and stops it once the race
+/// is over (the aborter may miss a racer that is between optimizations)
+class PortfolioInfoCallbackI: public IloCplex::MIPInfoCallbackI {
+public:
+  PortfolioInfoCallbackI( IloEnv env, PortfolioRace * race, unsigned racer,
+                          IloNumVarArray var ):
+    IloCplex::MIPInfoCallbackI( env ), my_race( race ), my_racer( racer ),
+    my_var( var ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const {
+    return (new (getEnv()) PortfolioInfoCallbackI( *this ));
+  }
+private:
+  PortfolioRace * my_race;
+  unsigned my_racer;
+  IloNumVarArray my_var;
+};
+
+void
+PortfolioInfoCallbackI::main()
+{
+  if ( my_race->isOver() ) {
+    abort();
+    return;
+  }
+  if ( ! hasIncumbent() ) return;
+  double value = getIncumbentObjValue();
+  if ( ! my_race->improves( value ) ) return;
+  IloNumArray incumbent( getEnv() );
+  getIncumbentValues( incumbent, my_var );
+  vector<double> values( incumbent.getSize() );
+  for ( IloInt i = 0; i < incumbent.getSize(); ++i ) values[i] = incumbent[i];
+  incumbent.end();
+  my_race->offerIncumbent( my_racer, value, values );
+}
+
+/// hands the best incumbent found by another racer to this one; CPLEX
+/// checks its feasibility and ignores it unless it is an improvement
+class PortfolioHeuristicCallbackI: public IloCplex::HeuristicCallbackI {
+public:
+  PortfolioHeuristicCallbackI( IloEnv env, PortfolioRace * race,
+                               unsigned racer, IloNumVarArray var ):
+    IloCplex::HeuristicCallbackI( env ), my_race( race ), my_racer( racer ),
+    my_var( var ), my_seen_version( 0 ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const {
+    return (new (getEnv()) PortfolioHeuristicCallbackI( *this ));
+  }
+private:
+  PortfolioRace * my_race;
+  unsigned my_racer;
+  IloNumVarArray my_var;
+  unsigned my_seen_version;
+};
+
+void
+PortfolioHeuristicCallbackI::main()
+{
+  double value;
+  vector<double> values;
+  if ( ! my_race->takeIncumbent( my_racer, my_seen_version, value, values ) ) {
+    return;
+  }
+  IloNumArray solution( getEnv(), values.size() );
+  for ( size_t i = 0; i < values.size(); ++i ) solution[i] = values[i];
+  setSolution( my_var, solution, value );
+  solution.end();
+}
+
+void
+PortfolioRace::attach( unsigned racer, IloCplex cplex, IloNumVarArray var,
+                       IloObjective obj )
+{
+  IloEnv env = var.getEnv();
+  cplex.use( IloCplex::Callback( new (env)
+                                 PortfolioInfoCallbackI( env, this, racer,
+                                                         var ) ) );
+  cplex.use( IloCplex::Callback( new (env)
+                                 PortfolioHeuristicCallbackI( env, this,
+                                                              racer, var ) ) );
+  IloCplex::Aborter aborter( env );
+  cplex.use( aborter );
+  lock_guard<mutex> guard( my_mutex );
+  // all racers solve the same model
+  my_minimize = obj.getSense() == IloObjective::Minimize;
+  my_aborters[racer] = aborter;
+  my_attached[racer] = true;
+  if ( my_over ) aborter.abort();
+}
+
+void
+PortfolioRace::finish( unsigned racer, bool proved_optimal,
+                       bool solution_found, double value )
+{
+  lock_guard<mutex> guard( my_mutex );
+  my_solution_found[racer] = solution_found;
+  my_values[racer] = value;
+  if ( ! proved_optimal || my_over ) return;
+  my_over = true;
+  my_proved_winner = racer;
+  for ( size_t other = 0; other < my_aborters.size(); ++other ) {
+    if ( other != racer && my_attached[other] ) my_aborters[other].abort();
+  }
+}
+
+void
+PortfolioRace::detach( unsigned racer )
+{
+  lock_guard<mutex> guard( my_mutex );
+  if ( ! my_attached[racer] ) return;
+  my_attached[racer] = false;
+  my_aborters[racer].end();
+}
+
+int
+PortfolioRace::winner() const
+{
+  lock_guard<mutex> guard( my_mutex );
+  if ( my_proved_winner >= 0 ) return my_proved_winner;
+  int best = -1;
+  for ( size_t racer = 0; racer < my_values.size(); ++racer ) {
+    if ( ! my_solution_found[racer] ) continue;
+    if ( best < 0 || better( my_values[racer], my_values[best] ) ) {
+      best = racer;
+    }
+  }
+  return best;
+}
+
+/// everything a racer thread needs
+struct RacerTask {
+  const CmdLine * command_line;
+  InstanceSolver solve_instance;
+  string file_name;
+  const LpModel * shared_model;
+  const PortfolioConfig * config;
+  string threads;
+  PortfolioRacer racer;
+  string output;
+  int status;
+};
+
+static void run_racer( RacerTask * task )
+{
+  IloEnv env;
+  CmdLine options( *task->command_line );
+  options.setFlag( "threads", task->threads );
+  for ( size_t i = 0; i < task->config->flags.size(); ++i ) {
+    options.setFlag( task->config->flags[i].first,
+                     task->config->flags[i].second );
+  }
+  ostringstream output;
+  task->status = EXIT_FAILURE;
+  try {
+    task->status = task->solve_instance( env, options, task->file_name,
+                                         task->shared_model, &task->racer,
+                                         output );
+  }
+  catch ( IloException & e ) {
+    output << "ERROR\t" << e.getMessage() << endl;
+    e.end();
+  }
+  catch ( ... ) {
+    output << "ERROR\tunexpected exception" << endl;
+  }
+  // in case the solver did not get as far as detaching
+  task->racer.race->detach( task->racer.index );
+  task->output = output.str();
+  env.end();
+}
+
+int runPortfolio( const CmdLine & command_line,
+                  InstanceSolver solve_instance, ostream & out )
+{
+  vector<PortfolioConfig> configs;
+  string portfolio = command_line.stringFlag( "portfolio" );
+  if ( portfolio.find_first_not_of( "0123456789" ) == string::npos ) {
+    unsigned size = atoi( portfolio.c_str() );
+    if ( size == 0 ) size = DEFAULT_PORTFOLIO_SIZE; // plain -portfolio
+    builtinPortfolioConfigs( size, configs );
+  }
+  else if ( ! readPortfolioConfigs( portfolio, configs ) ) {
+    cerr << "Unable to read portfolio configurations " << portfolio << endl;
+    return EXIT_FAILURE;
+  }
+  if ( configs.empty() ) {
+    cerr << "Portfolio: no configurations given." << endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned racers = configs.size();
+
+  // the cores are split evenly unless -threads says otherwise
+  unsigned threads_per_racer = 0;
+  if ( command_line.flagPresent( "threads" ) ) {
+    int requested = command_line.intFlag( "threads" );
+    if ( requested > 0 ) threads_per_racer = requested;
+  }
+  if ( threads_per_racer == 0 ) {
+    threads_per_racer = thread::hardware_concurrency() / racers;
+  }
+  if ( threads_per_racer == 0 ) threads_per_racer = 1;
+  ostringstream threads_value;
+  threads_value << threads_per_racer;
+
+  string file_name = command_line.getFiles()[1]; // [0] is the command
+  LpModel lp_model;
+  bool parsed = false;
+  if ( CnfParser::isCnfFile( file_name ) ) {
+    CnfParser parser;
+    parsed = parser.parse( file_name, lp_model );
+    if ( ! parsed ) {
+      cerr << "CNF reader: " << parser.errorMessage() << endl;
+    }
+  }
+  else if ( ! command_line.flagPresent( "cplex_reader" )
+            && LpParser::isLpFile( file_name ) ) {
+    LpParser parser;
+    parsed = parser.parse( file_name, lp_model );
+    if ( ! parsed ) {
+      cerr << "Native LP reader: " << parser.errorMessage() << endl;
+    }
+  }
+
+  PortfolioRace race( racers );
+  vector<RacerTask> tasks( racers );
+  for ( unsigned r = 0; r < racers; ++r ) {
+    tasks[r].command_line = &command_line;
+    tasks[r].solve_instance = solve_instance;
+    tasks[r].file_name = file_name;
+    tasks[r].shared_model = parsed ? &lp_model : 0;
+    tasks[r].config = &configs[r];
+    tasks[r].threads = threads_value.str();
+    tasks[r].racer.race = &race;
+    tasks[r].racer.index = r;
+    tasks[r].status = EXIT_FAILURE;
+  }
+
+  ClockTimer portfolio_timer = ClockTimer();
+  portfolio_timer.start();
+  vector<thread> threads;
+  for ( unsigned r = 0; r < racers; ++r ) {
+    threads.push_back( thread( run_racer, &tasks[r] ) );
+  }
+  for ( size_t t = 0; t < threads.size(); ++t ) threads[t].join();
+  portfolio_timer.stop();
+
+  int winner = race.winner();
+  bool proved = race.isOver();
+  // without any solution, report the first configuration
+  unsigned reported = winner >= 0 ? winner : 0;
+  out << tasks[reported].output;
+  out << "PortfolioConfigs\t" << racers << endl;
+  out << "PortfolioThreadsPerConfig\t" << threads_per_racer << endl;
+  out << "PortfolioWinner\t"
+      << (winner >= 0 ? configs[winner].name : "none") << endl;
+  out << "PortfolioProved\t" << proved << endl;
+  out << "PortfolioSharedIncumbents\t" << race.sharedIncumbents() << endl;
+  out << "PortfolioWallTime\t" << portfolio_timer.getTotalTime() << endl;
+  for ( unsigned r = 0; r < racers; ++r ) {
+    out << "PortfolioConfig_" << r << "\t" << configs[r].name << "\t"
+        << tasks[r].status << endl;
+  }
+  return tasks[reported].status;
+}
+
+//  [Last modified: 2026 10 18 at 02:33:50 GMT]
@@ -0,0 +1,126 @@
+/**
+ * @file Portfolio.h
+ * @brief Racing portfolio: solves one instance with several parameter
+ * configurations at the same time and stops as soon as one of them proves
+ * optimality (or infeasibility)
+ *
+ * Each racer runs in its own thread with its own IloEnv and IloCplex and
+ * its share of the cores. The file is parsed once; every racer loads the
+ * parsed model into its own environment, so variable i is the same in
+ * all of them. Incumbents are shared through a PortfolioRace: an info
+ * callback publishes each racer's improving incumbents and a heuristic
+ * callback hands the best published one to the other racers. The first
+ * racer to prove optimality aborts all others.
+ *
+ * Configurations are either the first N of a built-in list (-portfolio=N)
+ * or the lines of a file (-portfolio=FILE), each line a set of cplex_ilp
+ * flags, e.g.
+ *     -nsel=d -vsel=s
+ *     -feasible=3 -lp=p
+ * Blank lines and lines starting with # are ignored.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <mutex>
+#include <ilcplex/ilocplex.h>
+#include "Batch.h"
+
+/// a named set of flags that override those on the command line
+struct PortfolioConfig {
+  std::string name;
+  std::vector< std::pair<std::string, std::string> > flags;
+};
+
+/// reads one configuration per line from a file
+/// @return true if the file could be read and every flag is of the form
+/// -flag or -flag=value
+bool readPortfolioConfigs( const std::string & config_file_name,
+                           std::vector<PortfolioConfig> & configs );
+
+/// the first number_of_configs (at most the size of the built-in list)
+/// built-in configurations, which vary NodeSel, VarSel, MIPEmphasis and
+/// NodeAlg
+void builtinPortfolioConfigs( unsigned number_of_configs,
+                              std::vector<PortfolioConfig> & configs );
+
+/// State shared by the racers of one portfolio run: the best incumbent so
+/// far, the aborters of the running racers, and the winner once there is
+/// one. All methods may be called from any thread.
+class PortfolioRace {
+public:
+  explicit PortfolioRace( unsigned number_of_racers );
+
+  /// installs the callbacks and an aborter for racer in cplex; var must
+  /// contain all variables of the model, in the order of the input
+  void attach( unsigned racer, IloCplex cplex, IloNumVarArray var,
+               IloObjective obj );
+  /// records the outcome of racer's solve; if it proved optimality and
+  /// nobody did before, it becomes the winner and all others are aborted
+  void finish( unsigned racer, bool proved_optimal, bool solution_found,
+               double value );
+  /// must be called before racer's IloCplex is ended
+  void detach( unsigned racer );
+
+  bool isOver() const;
+  /// the racer that proved optimality, or, if none did, the one with the
+  /// best solution (lowest index among ties); -1 if no racer found one
+  int winner() const;
+  /// number of incumbents published that improved on all earlier ones
+  unsigned sharedIncumbents() const;
+
+  /// called from the info callback: publishes an incumbent if it improves
+  /// on the best one so far
+  /// @return true if it did
+  bool offerIncumbent( unsigned racer, double value,
+                       const std::vector<double> & values );
+  /// called from the heuristic callback: if the best incumbent was found
+  /// by another racer and is newer than seen_version, copies it into
+  /// values and updates seen_version
+  /// @return true if values was updated
+  bool takeIncumbent( unsigned racer, unsigned & seen_version,
+                      double & value, std::vector<double> & values );
+  /// @return true if value is better than the best published incumbent
+  bool improves( double value ) const;
+
+private:
+  bool better( double value, double other ) const;
+
+  mutable std::mutex my_mutex;
+  bool my_minimize;
+  bool my_over;
+  int my_proved_winner;
+  std::vector<IloCplex::Aborter> my_aborters;
+  std::vector<bool> my_attached;
+  std::vector<bool> my_solution_found;
+  std::vector<double> my_values;
+  bool my_have_incumbent;
+  double my_incumbent_value;
+  std::vector<double> my_incumbent;
+  unsigned my_incumbent_source;
+  unsigned my_incumbent_version;
+};
+
+/// a racer's handle on its race, passed to the instance solver
+struct PortfolioRacer {
+  PortfolioRace * race;
+  unsigned index;
+};
+
+/// Solves the single instance on the command line with the configurations
+/// given by -portfolio=N or -portfolio=FILE. Prints the output of the
+/// winning racer followed by Portfolio* tags naming the winner and giving
+/// the outcome of every racer.
+/// @return the exit status of the winner
+int runPortfolio( const CmdLine & command_line,
+                  InstanceSolver solve_instance, std::ostream & out );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 18:05:41 GMT]
@@ -0,0 +1,35 @@
+/// @file ProgressCallback.cpp
+/// @brief sampling of the progress of a MIP solve
+
+#include "ProgressCallback.h"
+#include <cmath>
+
+void
+ProgressCallbackI::main()
+{
+  double incumbent = hasIncumbent() ? getIncumbentObjValue() : NAN;
+  if ( ! my_trace->due( incumbent ) ) return;
+  ProgressSample sample;
+  sample.time = my_trace->elapsed();
+  sample.best_bound = getBestObjValue();
+  sample.incumbent = incumbent;
+  sample.gap = std::isnan( incumbent ) ? NAN : getMIPRelativeGap();
+  sample.nodes = getNnodes();
+  sample.open_nodes = getNremainingNodes();
+  sample.iterations = getNiterations();
+  my_trace->record( sample );
+}
+
+IloCplex::CallbackI *
+ProgressCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) ProgressCallbackI( *this ));
+}
+
+IloCplex::Callback
+progressCallback( IloEnv env, ProgressTrace * trace )
+{
+  return IloCplex::Callback( new (env) ProgressCallbackI( env, trace ) );
+}
+
+//  [Last modified: 2026 10 17 at 18:52:40 GMT]
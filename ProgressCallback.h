@@ -0,0 +1,34 @@
+/**
+ * @file ProgressCallback.h
+ * @brief Informational callback that feeds a ProgressTrace during a MIP
+ * solve
+ *
+ * An informational callback does not change the search (CPLEX keeps
+ * dynamic search), and main() returns right away unless a sample is due,
+ * so the overhead is a clock read per call.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PROGRESSCALLBACK_H
+#define PROGRESSCALLBACK_H
+
+#include <ilcplex/ilocplex.h>
+#include "ProgressTrace.h"
+
+class ProgressCallbackI: public IloCplex::MIPInfoCallbackI {
+public:
+  ProgressCallbackI( IloEnv env, ProgressTrace * trace ):
+    IloCplex::MIPInfoCallbackI( env ), my_trace( trace ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  ProgressTrace * my_trace;
+};
+
+/// @return a callback for IloCplex::use() that samples into trace
+IloCplex::Callback progressCallback( IloEnv env, ProgressTrace * trace );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 18:52:40 GMT]
@@ -0,0 +1,86 @@
+/// @file ProgressMetrics.cpp
+/// @brief primal/dual integrals and time-to-X measures
+
+#include"ProgressMetrics.h"
+#include<cmath>
+#include<algorithm>
+
+ProgressMetrics::ProgressMetrics( bool minimize, double target,
+                                  const std::vector<double> & gap_thresholds ):
+  my_minimize( minimize ),
+  my_target( target ),
+  my_thresholds( gap_thresholds ),
+  my_gap_times( gap_thresholds.size(), NAN ),
+  my_first_incumbent_time( NAN ),
+  my_target_time( NAN ),
+  my_primal_integral( NAN ),
+  my_dual_integral( NAN )
+{
+}
+
+double
+ProgressMetrics::relativeGap( double value, double reference )
+{
+  if ( std::isnan( value ) || std::isnan( reference ) ) return 1;
+  if ( value == 0 && reference == 0 ) return 0;
+  if ( value * reference < 0 ) return 1;
+  return std::fabs( value - reference )
+    / std::max( std::fabs( value ), std::fabs( reference ) );
+}
+
+void
+ProgressMetrics::add( const ProgressSample & sample )
+{
+  if ( ! std::isnan( sample.incumbent ) ) {
+    if ( std::isnan( my_first_incumbent_time ) ) {
+      my_first_incumbent_time = sample.time;
+    }
+    if ( ! std::isnan( my_target ) && std::isnan( my_target_time )
+         && (my_minimize ? sample.incumbent <= my_target
+                         : sample.incumbent >= my_target) ) {
+      my_target_time = sample.time;
+    }
+    if ( my_incumbents.empty()
+         || my_incumbents.back().second != sample.incumbent ) {
+      my_incumbents.push_back( std::make_pair( sample.time,
+                                               sample.incumbent ) );
+    }
+  }
+  if ( ! std::isnan( sample.gap ) ) {
+    for ( size_t i = 0; i < my_thresholds.size(); ++i ) {
+      if ( std::isnan( my_gap_times[i] ) && sample.gap <= my_thresholds[i] ) {
+        my_gap_times[i] = sample.time;
+      }
+    }
+  }
+  if ( ! std::isnan( sample.best_bound )
+       && (my_bounds.empty() || my_bounds.back().second != sample.best_bound) ) {
+    my_bounds.push_back( std::make_pair( sample.time, sample.best_bound ) );
+  }
+}
+
+double
+ProgressMetrics::integrate( const History & history, double end_time,
+                            double reference )
+{
+  // the gap is 1 until the first entry
+  double integral = history.empty() ? end_time : history[0].first;
+  for ( size_t i = 0; i < history.size(); ++i ) {
+    double until = i + 1 < history.size() ? history[i + 1].first : end_time;
+    if ( until > end_time ) until = end_time;
+    if ( until > history[i].first ) {
+      integral += (until - history[i].first)
+        * relativeGap( history[i].second, reference );
+    }
+  }
+  return integral;
+}
+
+void
+ProgressMetrics::finish( double end_time, double reference )
+{
+  my_primal_integral = integrate( my_incumbents, end_time, reference );
+  my_dual_integral = integrate( my_bounds, end_time, reference );
+}
+
+//  [Last modified: 2026 10 17 at 19:14:22 GMT]
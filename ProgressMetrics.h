@@ -0,0 +1,77 @@
+/**
+ * @file ProgressMetrics.h
+ * @brief Measures of how fast a solve closes the gap, computed from the
+ * samples of a ProgressTrace as they arrive: primal and dual integrals,
+ * time to first incumbent, time to a target cost and time to reach given
+ * relative gaps
+ *
+ * The integrals are those of Berthold (2013): the primal gap of an
+ * incumbent x against a reference value r is
+ *     0 if x = r = 0, 1 if there is no incumbent or x r < 0,
+ *     |x - r| / max(|x|, |r|) otherwise,
+ * and the primal integral is the integral of the primal gap over the solve
+ * (in seconds); the dual integral does the same for the best bound. The
+ * reference is normally the best solution found, known only at the end,
+ * so the incumbent and bound histories are kept (one entry per change of
+ * value, which the sampling interval keeps small) and integrated then.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PROGRESSMETRICS_H
+#define PROGRESSMETRICS_H
+
+#include<vector>
+#include<utility>
+#include"ProgressTrace.h"
+
+/// Usage:
+///   ProgressMetrics metrics(minimize, target, gap_thresholds);
+///   trace.setMetrics(&metrics);   ... solve ...
+///   metrics.finish(end_time, reference);
+///   metrics.primalIntegral(), ...
+/// Times that were never reached are NaN.
+class ProgressMetrics {
+public:
+  /// target is NaN if there is none
+  ProgressMetrics( bool minimize, double target,
+                   const std::vector<double> & gap_thresholds );
+
+  /// not thread safe (ProgressTrace calls it while holding its lock)
+  void add( const ProgressSample & sample );
+  /// computes the integrals over [0, end_time] against reference (NaN if
+  /// no solution is known, in which case the primal integral is end_time)
+  void finish( double end_time, double reference );
+
+  double timeToFirstIncumbent() const { return my_first_incumbent_time; }
+  double timeToTarget() const { return my_target_time; }
+  const std::vector<double> & gapThresholds() const { return my_thresholds; }
+  /// time at which the gap first was at most gapThresholds()[i]
+  double timeToGap( size_t i ) const { return my_gap_times[i]; }
+  double primalIntegral() const { return my_primal_integral; }
+  double dualIntegral() const { return my_dual_integral; }
+
+  /// the primal (or dual) gap function defined above
+  static double relativeGap( double value, double reference );
+
+private:
+  typedef std::vector< std::pair<double, double> > History;
+
+  static double integrate( const History & history, double end_time,
+                           double reference );
+
+  bool my_minimize;
+  double my_target;
+  std::vector<double> my_thresholds;
+  std::vector<double> my_gap_times;
+  double my_first_incumbent_time;
+  double my_target_time;
+  History my_incumbents;        // (time, value) at each change
+  History my_bounds;
+  double my_primal_integral;
+  double my_dual_integral;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 19:14:22 GMT]
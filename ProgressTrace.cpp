@@ -0,0 +1,165 @@
+/// @file ProgressTrace.cpp
+/// @brief ring buffer of progress samples and its CSV/binary output
+
+#include"ProgressTrace.h"
+#include"ProgressMetrics.h"
+#include<cstdio>
+#include<cstring>
+#include<cmath>
+
+static const char MAGIC[8] = { 'C', 'P', 'X', 'T', 'R', 'A', 'C', 'E' };
+
+ProgressTrace::ProgressTrace( size_t capacity, double interval ):
+  my_buffer( capacity > 0 ? capacity : 1 ),
+  my_next( 0 ),
+  my_count( 0 ),
+  my_interval( interval ),
+  my_start( Clock::now() ),
+  my_next_due( 0 ),
+  my_last_incumbent( NAN ),
+  my_metrics( 0 )
+{
+}
+
+void
+ProgressTrace::start()
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  my_start = Clock::now();
+  my_next = 0;
+  my_count = 0;
+  my_next_due = 0;
+  my_last_incumbent = NAN;
+}
+
+double
+ProgressTrace::elapsed() const
+{
+  return std::chrono::duration<double>( Clock::now() - my_start ).count();
+}
+
+bool
+ProgressTrace::due( double incumbent ) const
+{
+  if ( elapsed() >= my_next_due.load( std::memory_order_relaxed ) ) {
+    return true;
+  }
+  if ( std::isnan( incumbent ) ) return false;
+  double last = my_last_incumbent.load( std::memory_order_relaxed );
+  return std::isnan( last ) || incumbent != last;
+}
+
+void
+ProgressTrace::record( const ProgressSample & sample )
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  my_buffer[ my_next ] = sample;
+  my_next = (my_next + 1) % my_buffer.size();
+  ++my_count;
+  my_next_due = sample.time + my_interval;
+  if ( ! std::isnan( sample.incumbent ) ) my_last_incumbent = sample.incumbent;
+  if ( my_metrics ) my_metrics->add( sample );
+}
+
+size_t
+ProgressTrace::size() const
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  return my_count < my_buffer.size() ? my_count : my_buffer.size();
+}
+
+size_t
+ProgressTrace::dropped() const
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  return my_count < my_buffer.size() ? 0 : my_count - my_buffer.size();
+}
+
+std::vector<ProgressSample>
+ProgressTrace::samples() const
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  std::vector<ProgressSample> ordered;
+  if ( my_count < my_buffer.size() ) {
+    ordered.assign( my_buffer.begin(), my_buffer.begin() + my_count );
+  }
+  else {
+    // the oldest sample is the one that will be overwritten next
+    ordered.assign( my_buffer.begin() + my_next, my_buffer.end() );
+    ordered.insert( ordered.end(), my_buffer.begin(),
+                    my_buffer.begin() + my_next );
+  }
+  return ordered;
+}
+
+bool
+ProgressTrace::write( const std::string & file_name )
+{
+  my_error_message = "";
+  if ( file_name.size() > 4
+       && file_name.compare( file_name.size() - 4, 4, ".bin" ) == 0 ) {
+    return writeBinary( file_name );
+  }
+  return writeCsv( file_name );
+}
+
+bool
+ProgressTrace::writeCsv( const std::string & file_name )
+{
+  FILE * out = fopen( file_name.c_str(), "w" );
+  if ( ! out ) {
+    my_error_message = "unable to open " + file_name;
+    return false;
+  }
+  std::vector<ProgressSample> ordered = samples();
+  fprintf( out, "time,best_bound,incumbent,gap,nodes,open_nodes,iterations\n" );
+  for ( size_t i = 0; i < ordered.size(); ++i ) {
+    const ProgressSample & sample = ordered[i];
+    // no incumbent (NaN) is an empty field
+    fprintf( out, "%.6f,%.15g,", sample.time, sample.best_bound );
+    if ( ! std::isnan( sample.incumbent ) ) {
+      fprintf( out, "%.15g", sample.incumbent );
+    }
+    fprintf( out, "," );
+    if ( ! std::isnan( sample.gap ) ) fprintf( out, "%.6g", sample.gap );
+    fprintf( out, ",%lld,%lld,%lld\n",
+             static_cast<long long>( sample.nodes ),
+             static_cast<long long>( sample.open_nodes ),
+             static_cast<long long>( sample.iterations ) );
+  }
+  if ( fclose( out ) != 0 ) {
+    my_error_message = "error writing " + file_name;
+    return false;
+  }
+  return true;
+}
+
+bool
+ProgressTrace::writeBinary( const std::string & file_name )
+{
+  FILE * out = fopen( file_name.c_str(), "wb" );
+  if ( ! out ) {
+    my_error_message = "unable to open " + file_name;
+    return false;
+  }
+  std::vector<ProgressSample> ordered = samples();
+  ProgressTraceHeader header;
+  memset( &header, 0, sizeof(header) );
+  memcpy( header.magic, MAGIC, sizeof(MAGIC) );
+  header.version = FORMAT_VERSION;
+  header.sample_size = sizeof(ProgressSample);
+  header.samples = ordered.size();
+  header.dropped = dropped();
+  bool ok = fwrite( &header, sizeof(header), 1, out ) == 1;
+  if ( ok && ! ordered.empty() ) {
+    ok = fwrite( &ordered[0], sizeof(ProgressSample), ordered.size(), out )
+      == ordered.size();
+  }
+  if ( fclose( out ) != 0 || ! ok ) {
+    my_error_message = "error writing " + file_name;
+    return false;
+  }
+  return true;
+}
+
+//  [Last modified: 2026 10 17 at 19:14:22 GMT]
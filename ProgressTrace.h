@@ -0,0 +1,111 @@
+/**
+ * @file ProgressTrace.h
+ * @brief Time series of the progress of a solve (best bound, incumbent,
+ * gap, nodes, open nodes, iterations against elapsed wall time), kept in a
+ * preallocated ring buffer and written out when the solve is over
+ *
+ * Samples are taken at most once per interval, and in addition whenever
+ * the incumbent improves, so that the primal side of the series is exact.
+ * When the buffer is full the oldest samples are overwritten; dropped()
+ * says how many. Nothing is allocated or written while the solver runs.
+ *
+ * A trace file is CSV unless its name ends in .bin, in which case it is
+ * the fixed header below followed by the samples as ProgressSample
+ * records (native byte order).
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef PROGRESSTRACE_H
+#define PROGRESSTRACE_H
+
+#include<string>
+#include<vector>
+#include<mutex>
+#include<atomic>
+#include<chrono>
+#include<stdint.h>
+
+class ProgressMetrics;
+
+/// one point of a trace; incumbent and gap are NaN while there is no
+/// incumbent
+struct ProgressSample {
+  double time;                  // seconds since ProgressTrace::start()
+  double best_bound;
+  double incumbent;
+  double gap;
+  int64_t nodes;
+  int64_t open_nodes;
+  int64_t iterations;
+};
+
+/// start of a binary trace file
+struct ProgressTraceHeader {
+  char magic[8];                // "CPXTRACE"
+  uint32_t version;
+  uint32_t sample_size;         // sizeof(ProgressSample)
+  uint64_t samples;
+  uint64_t dropped;
+};
+
+/// Usage:
+///   ProgressTrace trace(capacity, interval);
+///   trace.start();
+///   ... from any thread, as often as convenient:
+///   if ( trace.due(incumbent) ) trace.record(sample);  // time = elapsed()
+///   trace.write(file_name);
+class ProgressTrace {
+public:
+  static const uint32_t FORMAT_VERSION = 1;
+
+  ProgressTrace( size_t capacity, double interval );
+
+  /// starts the clock; also clears the samples
+  void start();
+  /// @return seconds since start()
+  double elapsed() const;
+  /// cheap test, safe without locking: true if the interval has passed
+  /// since the last sample or incumbent (NaN if none) differs from the
+  /// last one recorded
+  bool due( double incumbent ) const;
+  /// adds a sample (thread safe); samples arriving out of time order
+  /// because of a race between threads are kept in arrival order
+  void record( const ProgressSample & sample );
+  /// every sample recorded from now on is also passed to metrics (which
+  /// see all samples, even those later dropped from the buffer)
+  void setMetrics( ProgressMetrics * metrics ) { my_metrics = metrics; }
+
+  size_t size() const;
+  size_t dropped() const;
+  double interval() const { return my_interval; }
+  /// @return the samples in the buffer, oldest first
+  std::vector<ProgressSample> samples() const;
+
+  /// writes the samples to a CSV file, or a binary one if file_name ends
+  /// in .bin
+  /// @return true if successful, otherwise see errorMessage()
+  bool write( const std::string & file_name );
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  bool writeCsv( const std::string & file_name );
+  bool writeBinary( const std::string & file_name );
+
+  typedef std::chrono::steady_clock Clock;
+
+  mutable std::mutex my_mutex;
+  std::vector<ProgressSample> my_buffer;
+  size_t my_next;               // position of the next sample in my_buffer
+  size_t my_count;              // total number of samples recorded
+  double my_interval;
+  Clock::time_point my_start;
+  std::atomic<double> my_next_due;
+  std::atomic<double> my_last_incumbent;
+  ProgressMetrics * my_metrics;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 19:14:22 GMT]
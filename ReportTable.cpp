@@ -0,0 +1,357 @@
+/// @file ReportTable.cpp
+/// @brief reading of JSON and CSV run reports into a table
+
+#include"ReportTable.h"
+#include<fstream>
+#include<algorithm>
+#include<cstdlib>
+#include<dirent.h>
+#include<sys/stat.h>
+#include"MappedFile.h"
+
+using namespace std;
+
+void
+ReportTable::set( const string & column, const string & value )
+{
+  map<string, size_t>::iterator found = my_index.find( column );
+  size_t index;
+  if ( found == my_index.end() ) {
+    index = my_names.size();
+    my_index[ column ] = index;
+    my_names.push_back( column );
+    // earlier rows don't have this column
+    my_columns.push_back( vector<string>( my_rows - 1 ) );
+  }
+  else index = found->second;
+  vector<string> & cells = my_columns[index];
+  if ( cells.size() == my_rows ) cells.back() = value; // repeated member
+  else cells.push_back( value );
+}
+
+void
+ReportTable::endRow()
+{
+  for ( size_t c = 0; c < my_columns.size(); ++c ) {
+    my_columns[c].resize( my_rows );
+  }
+}
+
+int
+ReportTable::column( const string & name ) const
+{
+  map<string, size_t>::const_iterator found = my_index.find( name );
+  return found == my_index.end() ? -1 : static_cast<int>( found->second );
+}
+
+const string &
+ReportTable::cell( size_t r, int c ) const
+{
+  static const string empty;
+  return c < 0 ? empty : my_columns[c][r];
+}
+
+static string csv_field( const string & value, char delimiter )
+{
+  if ( value.find_first_of( string( 1, delimiter ) + "\"\n" ) == string::npos ) {
+    return value;
+  }
+  string quoted = "\"";
+  for ( size_t i = 0; i < value.size(); ++i ) {
+    if ( value[i] == '"' ) quoted += '"';
+    quoted += value[i];
+  }
+  return quoted + "\"";
+}
+
+void
+ReportTable::writeCsv( ostream & out, char delimiter ) const
+{
+  for ( size_t c = 0; c < my_names.size(); ++c ) {
+    if ( c > 0 ) out << delimiter;
+    out << csv_field( my_names[c], delimiter );
+  }
+  out << '\n';
+  for ( size_t r = 0; r < my_rows; ++r ) {
+    for ( size_t c = 0; c < my_columns.size(); ++c ) {
+      if ( c > 0 ) out << delimiter;
+      out << csv_field( my_columns[c][r], delimiter );
+    }
+    out << '\n';
+  }
+}
+
+bool
+ReportTable::writeColumns( const string & directory ) const
+{
+  mkdir( directory.c_str(), 0777 );
+  ofstream list( (directory + "/_columns").c_str() );
+  if ( ! list ) return false;
+  list << my_rows << '\n';
+  for ( size_t c = 0; c < my_names.size(); ++c ) {
+    list << my_names[c] << '\n';
+    ofstream column( (directory + "/" + my_names[c] + ".col").c_str() );
+    if ( ! column ) return false;
+    for ( size_t r = 0; r < my_rows; ++r ) {
+      // values are one per line, so newlines inside them are escaped
+      const string & value = my_columns[c][r];
+      for ( size_t i = 0; i < value.size(); ++i ) {
+        if ( value[i] == '\n' ) column << "\\n";
+        else column << value[i];
+      }
+      column << '\n';
+    }
+  }
+  return true;
+}
+
+bool
+ReportReader::fail( const string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+void
+ReportReader::skipSpace()
+{
+  while ( my_next != my_end
+          && (*my_next == ' ' || *my_next == '\t' || *my_next == '\r') ) {
+    ++my_next;
+  }
+}
+
+bool
+ReportReader::readString( string & value )
+{
+  // the opening quote has been seen
+  ++my_next;
+  value.clear();
+  while ( my_next != my_end && *my_next != '"' ) {
+    if ( *my_next != '\\' ) {
+      value += *my_next++;
+      continue;
+    }
+    if ( ++my_next == my_end ) break;
+    char escaped = *my_next++;
+    switch ( escaped ) {
+    case 'n': value += '\n'; break;
+    case 'r': value += '\r'; break;
+    case 't': value += '\t'; break;
+    case 'b': value += '\b'; break;
+    case 'f': value += '\f'; break;
+    case 'u': {
+      if ( my_end - my_next < 4 ) return fail( "bad \\u escape" );
+      unsigned code = strtoul( string( my_next, 4 ).c_str(), 0, 16 );
+      my_next += 4;
+      // only control characters are escaped this way by RunReport
+      if ( code < 0x80 ) value += static_cast<char>( code );
+      else value += '?';
+      break;
+    }
+    default: value += escaped;  // " \ /
+    }
+  }
+  if ( my_next == my_end ) return fail( "unterminated string" );
+  ++my_next;
+  return true;
+}
+
+bool
+ReportReader::readValue( const string & column )
+{
+  skipSpace();
+  if ( my_next == my_end ) return fail( "missing value" );
+  if ( *my_next == '{' ) return readObject( column + "." );
+  if ( *my_next == '"' ) {
+    string value;
+    if ( ! readString( value ) ) return false;
+    my_members.push_back( make_pair( column, value ) );
+    return true;
+  }
+  if ( *my_next == '[' ) {
+    // arrays are kept as JSON text
+    const char * start = my_next;
+    int depth = 0;
+    bool in_string = false;
+    for ( ; my_next != my_end; ++my_next ) {
+      if ( in_string ) {
+        if ( *my_next == '\\' && my_next + 1 != my_end ) ++my_next;
+        else if ( *my_next == '"' ) in_string = false;
+      }
+      else if ( *my_next == '"' ) in_string = true;
+      else if ( *my_next == '[' ) ++depth;
+      else if ( *my_next == ']' && --depth == 0 ) break;
+    }
+    if ( my_next == my_end ) return fail( "unterminated array" );
+    ++my_next;
+    my_members.push_back( make_pair( column, string( start, my_next ) ) );
+    return true;
+  }
+  const char * start = my_next;
+  while ( my_next != my_end && *my_next != ',' && *my_next != '}'
+          && *my_next != ' ' && *my_next != '\t' && *my_next != '\r' ) {
+    ++my_next;
+  }
+  string literal( start, my_next );
+  if ( literal.empty() ) return fail( "missing value" );
+  if ( literal == "true" ) literal = "1";
+  else if ( literal == "false" ) literal = "0";
+  else if ( literal == "null" ) literal = "";
+  my_members.push_back( make_pair( column, literal ) );
+  return true;
+}
+
+bool
+ReportReader::readObject( const string & prefix )
+{
+  // the opening brace has been seen
+  ++my_next;
+  skipSpace();
+  if ( my_next != my_end && *my_next == '}' ) {
+    ++my_next;
+    return true;
+  }
+  while ( true ) {
+    skipSpace();
+    if ( my_next == my_end || *my_next != '"' ) return fail( "expected a name" );
+    string name;
+    if ( ! readString( name ) ) return false;
+    skipSpace();
+    if ( my_next == my_end || *my_next != ':' ) return fail( "expected :" );
+    ++my_next;
+    if ( ! readValue( prefix + name ) ) return false;
+    skipSpace();
+    if ( my_next == my_end ) return fail( "unterminated object" );
+    if ( *my_next == '}' ) {
+      ++my_next;
+      return true;
+    }
+    if ( *my_next != ',' ) return fail( "expected , or }" );
+    ++my_next;
+  }
+}
+
+bool
+ReportReader::readReport( const char * begin, const char * end )
+{
+  my_next = begin;
+  my_end = end;
+  my_error_message = "";
+  my_members.clear();
+  if ( ! readObject( "" ) ) return false;
+  my_table.beginRow();
+  for ( size_t m = 0; m < my_members.size(); ++m ) {
+    my_table.set( my_members[m].first, my_members[m].second );
+  }
+  my_table.endRow();
+  return true;
+}
+
+int
+readReportFile( const string & file_name, ReportReader & reader )
+{
+  MappedFile input;
+  if ( ! input.open( file_name ) ) {
+    cerr << file_name << ": " << input.errorMessage() << endl;
+    return -1;
+  }
+  int bad_reports = 0;
+  int line_number = 0;
+  const char * line = input.begin();
+  while ( line != input.end() ) {
+    const char * line_end = std::find( line, input.end(), '\n' );
+    ++line_number;
+    if ( line != line_end && *line == '{' ) {
+      if ( ! reader.readReport( line, line_end ) ) {
+        cerr << file_name << ", line " << line_number << ": "
+             << reader.errorMessage() << endl;
+        ++bad_reports;
+      }
+    }
+    line = line_end == input.end() ? line_end : line_end + 1;
+  }
+  return bad_reports;
+}
+
+bool
+listReports( const string & directory, vector<string> & file_names )
+{
+  DIR * dir = opendir( directory.c_str() );
+  if ( ! dir ) return false;
+  vector<string> names;
+  while ( struct dirent * entry = readdir( dir ) ) {
+    string name = entry->d_name;
+    if ( name.size() > 5 && name.compare( name.size() - 5, 5, ".json" ) == 0 ) {
+      names.push_back( directory + "/" + name );
+    }
+  }
+  closedir( dir );
+  sort( names.begin(), names.end() );
+  file_names.insert( file_names.end(), names.begin(), names.end() );
+  return true;
+}
+
+/// splits a CSV line into fields, undoing the quoting of csv_field()
+/// @return false if a quoted field is not terminated
+static bool split_csv( const string & line, vector<string> & fields )
+{
+  fields.clear();
+  string field;
+  size_t i = 0;
+  while ( true ) {
+    field.clear();
+    if ( i < line.size() && line[i] == '"' ) {
+      for ( ++i; ; ++i ) {
+        if ( i >= line.size() ) return false;
+        if ( line[i] != '"' ) field += line[i];
+        else if ( i + 1 < line.size() && line[i + 1] == '"' ) field += line[++i];
+        else break;
+      }
+      ++i;
+    }
+    while ( i < line.size() && line[i] != ',' ) field += line[i++];
+    fields.push_back( field );
+    if ( i >= line.size() ) return true;
+    ++i;
+  }
+}
+
+int
+readCsvFile( const string & file_name, ReportTable & table )
+{
+  ifstream in( file_name.c_str() );
+  if ( ! in ) {
+    cerr << file_name << ": unable to open" << endl;
+    return -1;
+  }
+  string line;
+  vector<string> header, fields;
+  if ( ! getline( in, line ) || ! split_csv( line, header ) ) {
+    cerr << file_name << ": no header line" << endl;
+    return -1;
+  }
+  int bad_lines = 0;
+  int line_number = 1;
+  while ( getline( in, line ) ) {
+    ++line_number;
+    if ( ! line.empty() && line[ line.size() - 1 ] == '\r' ) {
+      line.erase( line.size() - 1 );
+    }
+    if ( line.empty() ) continue;
+    if ( ! split_csv( line, fields ) || fields.size() != header.size() ) {
+      cerr << file_name << ", line " << line_number << ": expected "
+           << header.size() << " fields" << endl;
+      ++bad_lines;
+      continue;
+    }
+    table.beginRow();
+    for ( size_t f = 0; f < fields.size(); ++f ) {
+      table.set( header[f], fields[f] );
+    }
+    table.endRow();
+  }
+  return bad_lines;
+}
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]
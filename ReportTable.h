@@ -0,0 +1,94 @@
+/**
+ * @file ReportTable.h
+ * @brief Tables of run reports: the JSON objects written by cplex_ilp with
+ * -report=json or -report_dir=DIR, and CSV tables such as those of
+ * report2csv and -sweep, read into one set of named columns
+ *
+ * Nested members of a JSON report become columns named section.key, in
+ * order of first appearance; true/false become 1/0, as in the tag/value
+ * output, and members missing from a report are left empty. A CSV file
+ * has a header line naming the columns, which are used as they are.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef REPORTTABLE_H
+#define REPORTTABLE_H
+
+#include<string>
+#include<vector>
+#include<map>
+#include<utility>
+#include<iostream>
+#include<cstddef>
+
+/// the reports read so far, stored by column
+class ReportTable {
+public:
+  ReportTable(): my_rows( 0 ) {}
+
+  void beginRow() { ++my_rows; }
+  void set( const std::string & column, const std::string & value );
+  void endRow();
+
+  size_t numberOfRows() const { return my_rows; }
+  size_t numberOfColumns() const { return my_names.size(); }
+  const std::string & columnName( size_t c ) const { return my_names[c]; }
+  /// @return the index of the named column, -1 if there is none
+  int column( const std::string & name ) const;
+  /// @return the value in row r of column c, empty if c is -1
+  const std::string & cell( size_t r, int c ) const;
+
+  void writeCsv( std::ostream & out, char delimiter ) const;
+  bool writeColumns( const std::string & directory ) const;
+
+private:
+  size_t my_rows;
+  std::vector<std::string> my_names;
+  std::map<std::string, size_t> my_index;
+  std::vector< std::vector<std::string> > my_columns;
+};
+
+/// Parses the JSON objects written by RunReport (and any other JSON object
+/// that fits on one line) into rows of a ReportTable.
+class ReportReader {
+public:
+  explicit ReportReader( ReportTable & table ): my_table( table ) {}
+
+  /// reads one report from [begin, end), which holds a single line
+  /// @return true if it was a well-formed object
+  bool readReport( const char * begin, const char * end );
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  void skipSpace();
+  bool readObject( const std::string & prefix );
+  bool readValue( const std::string & column );
+  bool readString( std::string & value );
+  bool fail( const std::string & message );
+
+  ReportTable & my_table;
+  /// members of the report being read, added to the table only if the
+  /// whole report is well formed
+  std::vector< std::pair<std::string, std::string> > my_members;
+  const char * my_next;
+  const char * my_end;
+  std::string my_error_message;
+};
+
+/// reads every report in a file, i.e., every line that starts with {
+/// @return the number of malformed reports, or -1 if it can't be read
+int readReportFile( const std::string & file_name, ReportReader & reader );
+
+/// reads a CSV file with a header line into table, one row per line
+/// @return the number of malformed lines, or -1 if it can't be read
+int readCsvFile( const std::string & file_name, ReportTable & table );
+
+/// appends the .json files in directory, in name order, to file_names
+/// @return false if directory is not a directory
+bool listReports( const std::string & directory,
+                  std::vector<std::string> & file_names );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]
@@ -0,0 +1,181 @@
+/// @file RootLpRace.cpp
+/// @brief race of the LP algorithms for -root_lp=race
+
+#include "RootLpRace.h"
+#include "CplexLoader.h"
+#include "ClockTimer.h"
+#include <sstream>
+#include <thread>
+
+ILOSTLBEGIN
+
+/// the algorithms that race: name, value of RootAlg
+static const struct { const char * name; int root_algorithm; }
+RACING_ALGORITHMS[] = {
+  { "primal", 1 },
+  { "dual", 2 },
+  { "barrier", 4 },
+};
+static const unsigned NUMBER_OF_RACERS
+  = sizeof( RACING_ALGORITHMS ) / sizeof( RACING_ALGORITHMS[0] );
+
+/// root_algorithm of the barrier racer
+static const int BARRIER = 4;
+
+const char *
+RootLpRace::algorithmName( IloCplex::Algorithm algorithm )
+{
+  switch ( algorithm ) {
+  case IloCplex::NoAlg: return "none";
+  case IloCplex::AutoAlg: return "auto";
+  case IloCplex::Primal: return "primal";
+  case IloCplex::Dual: return "dual";
+  case IloCplex::Network: return "network";
+  case IloCplex::Barrier: return "barrier";
+  case IloCplex::Sifting: return "sifting";
+  case IloCplex::Concurrent: return "concurrent";
+  default: return "unknown";
+  }
+}
+
+RootLpRace::RootLpRace( const LpModel & lp_model ):
+  my_lp_model( lp_model ),
+  my_threads( 0 ),
+  my_time_limit( 3600 ),
+  my_crossover( 0 ),
+  my_threads_used( 0 ),
+  my_time( 0 ),
+  my_aborters( NUMBER_OF_RACERS ),
+  my_attached( NUMBER_OF_RACERS, false ),
+  my_winner( -1 )
+{
+  for ( unsigned r = 0; r < NUMBER_OF_RACERS; ++r ) {
+    Racer racer;
+    racer.algorithm = RACING_ALGORITHMS[r].name;
+    racer.root_algorithm = RACING_ALGORITHMS[r].root_algorithm;
+    racer.time = 0;
+    racer.iterations = 0;
+    racer.status = "none";
+    racer.optimal = false;
+    my_racers.push_back( racer );
+  }
+}
+
+bool
+RootLpRace::run()
+{
+  my_threads_used = my_threads;
+  if ( my_threads_used == 0 ) {
+    my_threads_used = thread::hardware_concurrency() / NUMBER_OF_RACERS;
+  }
+  if ( my_threads_used == 0 ) my_threads_used = 1;
+
+  ClockTimer race_timer = ClockTimer();
+  race_timer.start();
+  vector<thread> threads;
+  for ( unsigned r = 0; r < NUMBER_OF_RACERS; ++r ) {
+    threads.push_back( thread( &RootLpRace::runRacer, this, r ) );
+  }
+  for ( size_t t = 0; t < threads.size(); ++t ) threads[t].join();
+  race_timer.stop();
+  my_time = race_timer.getTotalTime();
+  return my_winner >= 0;
+}
+
+void
+RootLpRace::runRacer( unsigned r )
+{
+  Racer & racer = my_racers[r];
+  IloEnv env;
+  try {
+    IloModel model( env );
+    IloObjective obj;
+    IloNumVarArray var( env );
+    IloRangeArray rng( env );
+    loadModel( env, my_lp_model, model, obj, var, rng );
+    model.add( IloConversion( env, var, ILOFLOAT ) );
+    IloCplex cplex( model );
+    cplex.setOut( env.getNullStream() );
+    cplex.setWarning( env.getNullStream() );
+    cplex.setParam( IloCplex::RootAlg, racer.root_algorithm );
+    cplex.setParam( IloCplex::Threads, (int) my_threads_used );
+    cplex.setParam( IloCplex::TiLim, my_time_limit );
+    if ( racer.root_algorithm == BARRIER ) {
+      cplex.setParam( IloCplex::BarCrossAlg, my_crossover );
+    }
+    IloCplex::Aborter aborter( env );
+    cplex.use( aborter );
+    {
+      lock_guard<mutex> guard( my_mutex );
+      my_aborters[r] = aborter;
+      my_attached[r] = true;
+      if ( my_winner >= 0 ) aborter.abort();
+    }
+
+    ClockTimer racer_timer = ClockTimer();
+    racer_timer.start();
+    cplex.solve();
+    racer_timer.stop();
+    racer.time = racer_timer.getTotalTime();
+    racer.iterations = cplex.getNiterations();
+    ostringstream status;
+    status << cplex.getCplexStatus();
+    racer.status = status.str();
+    racer.optimal = cplex.getCplexStatus() == IloCplex::Optimal;
+
+    // barrier without crossover leaves no basis
+    bool basic = racer.optimal
+      && ( racer.root_algorithm != BARRIER || my_crossover != -1 );
+    vector<int> column_statuses, row_statuses;
+    if ( basic ) {
+      IloCplex::BasisStatusArray cstat( env ), rstat( env );
+      cplex.getBasisStatuses( cstat, var, rstat, rng );
+      for ( IloInt j = 0; j < cstat.getSize(); ++j ) {
+        column_statuses.push_back( cstat[j] );
+      }
+      for ( IloInt i = 0; i < rstat.getSize(); ++i ) {
+        row_statuses.push_back( rstat[i] );
+      }
+      cstat.end();
+      rstat.end();
+    }
+
+    lock_guard<mutex> guard( my_mutex );
+    my_attached[r] = false;
+    if ( racer.optimal && my_winner < 0 ) {
+      my_winner = r;
+      my_column_statuses.swap( column_statuses );
+      my_row_statuses.swap( row_statuses );
+      for ( unsigned other = 0; other < NUMBER_OF_RACERS; ++other ) {
+        if ( my_attached[other] ) my_aborters[other].abort();
+      }
+    }
+    aborter.end();
+  }
+  catch ( IloException & e ) {
+    lock_guard<mutex> guard( my_mutex );
+    my_attached[r] = false;
+    racer.status = "ERROR";
+    e.end();
+  }
+  env.end();
+}
+
+void
+RootLpRace::setBasis( IloCplex cplex, IloNumVarArray var,
+                      IloRangeArray rng ) const
+{
+  IloEnv env = cplex.getEnv();
+  IloCplex::BasisStatusArray cstat( env ), rstat( env );
+  for ( size_t j = 0; j < my_column_statuses.size(); ++j ) {
+    cstat.add( IloCplex::BasisStatus( my_column_statuses[j] ) );
+  }
+  for ( size_t i = 0; i < my_row_statuses.size(); ++i ) {
+    rstat.add( IloCplex::BasisStatus( my_row_statuses[i] ) );
+  }
+  cplex.setBasisStatuses( cstat, var, rstat, rng );
+  cstat.end();
+  rstat.end();
+}
+
+//  [Last modified: 2026 10 18 at 06:14:35 GMT]
@@ -0,0 +1,92 @@
+/**
+ * @file RootLpRace.h
+ * @brief Race of primal simplex, dual simplex and barrier on the LP
+ * relaxation of a model (-root_lp=race with -lp_only), with the time each
+ * of them took
+ *
+ * CPLEX's concurrent optimizer (-root_lp=c) also races the algorithms, but
+ * only tells which one won. Here each algorithm runs in its own thread with
+ * its own IloEnv and IloCplex and its share of the cores, on the parsed
+ * model loaded into its environment (so that column i is the same in all
+ * of them); the first to solve the LP aborts the others, as in a
+ * portfolio race. The optimal basis of the winner, if it has one, is then
+ * given to the main solve, which needs no more iterations.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef ROOTLPRACE_H
+#define ROOTLPRACE_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <ilcplex/ilocplex.h>
+#include "LpModel.h"
+
+/// Usage:
+///   RootLpRace race( lp_model );
+///   race.setThreadsPerRacer( 2 );  race.setTimeLimit( 3600 );
+///   if ( race.run() && race.hasBasis() ) race.setBasis( cplex, var, rng );
+///   ... race.racers()[r].time, race.winner()
+class RootLpRace {
+public:
+  struct Racer {
+    std::string algorithm;
+    int root_algorithm;                 // value of the RootAlg parameter
+    double time;
+    long iterations;
+    std::string status;
+    bool optimal;
+  };
+
+  /// name of an algorithm CPLEX reports, e.g., for getAlgorithm()
+  static const char * algorithmName( IloCplex::Algorithm algorithm );
+
+  explicit RootLpRace( const LpModel & lp_model );
+
+  /// 0 = an equal share of the cores
+  void setThreadsPerRacer( unsigned threads ) { my_threads = threads; }
+  void setTimeLimit( double seconds ) { my_time_limit = seconds; }
+  /// BarCrossAlg of the barrier racer: -1 none, 0 automatic, 1 primal, 2
+  /// dual; without crossover barrier leaves no basis
+  void setCrossover( int crossover ) { my_crossover = crossover; }
+
+  /// @return true if one of the algorithms solved the LP to optimality
+  bool run();
+
+  /// index of the first racer to solve the LP, -1 if none did
+  int winner() const { return my_winner; }
+  const std::vector<Racer> & racers() const { return my_racers; }
+  unsigned threadsPerRacer() const { return my_threads_used; }
+  double time() const { return my_time; }
+
+  /// true if the winner left an optimal basis
+  bool hasBasis() const { return ! my_column_statuses.empty(); }
+  /// starts cplex from the basis of the winner; var and rng must have been
+  /// loaded from the same model (loadModel())
+  void setBasis( IloCplex cplex, IloNumVarArray var, IloRangeArray rng ) const;
+
+private:
+  /// solves the LP with the algorithm of racer, in a thread of its own
+  void runRacer( unsigned racer );
+
+  const LpModel & my_lp_model;
+  unsigned my_threads;
+  double my_time_limit;
+  int my_crossover;
+  std::vector<Racer> my_racers;
+  unsigned my_threads_used;
+  double my_time;
+
+  std::mutex my_mutex;                  // for the state of the race
+  std::vector<IloCplex::Aborter> my_aborters;
+  std::vector<bool> my_attached;
+  int my_winner;
+  std::vector<int> my_column_statuses;  // IloCplex::BasisStatus values
+  std::vector<int> my_row_statuses;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 06:14:35 GMT]
@@ -0,0 +1,156 @@
+/// @file RunReport.cpp
+/// @brief JSON run reports
+
+#include"RunReport.h"
+#include<fstream>
+#include<sstream>
+#include<cstdio>
+#include<cmath>
+#include<atomic>
+#include<unistd.h>
+
+/// distinguishes the reports of the runs of one process (batch mode)
+static std::atomic<unsigned> report_sequence( 0 );
+
+std::string
+RunReport::quote( const std::string & s )
+{
+  std::string quoted = "\"";
+  for ( size_t i = 0; i < s.size(); ++i ) {
+    unsigned char c = s[i];
+    switch ( c ) {
+    case '"':  quoted += "\\\""; break;
+    case '\\': quoted += "\\\\"; break;
+    case '\n': quoted += "\\n"; break;
+    case '\r': quoted += "\\r"; break;
+    case '\t': quoted += "\\t"; break;
+    default:
+      if ( c < 0x20 ) {
+        char escape[8];
+        snprintf( escape, sizeof(escape), "\\u%04x", c );
+        quoted += escape;
+      }
+      else quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+void
+RunReport::setJson( const std::string & section, const std::string & key,
+                    const std::string & json_value )
+{
+  size_t s = 0;
+  while ( s < my_section_names.size() && my_section_names[s] != section ) ++s;
+  if ( s == my_section_names.size() ) {
+    my_section_names.push_back( section );
+    my_sections.push_back( Members() );
+  }
+  Members & members = my_sections[s];
+  for ( size_t m = 0; m < members.size(); ++m ) {
+    if ( members[m].first == key ) {
+      members[m].second = json_value;
+      return;
+    }
+  }
+  members.push_back( std::make_pair( key, json_value ) );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                const std::string & value )
+{
+  setJson( section, key, quote( value ) );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                const char * value )
+{
+  setJson( section, key, quote( value ) );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                double value )
+{
+  // JSON has no infinities or NaN
+  if ( ! std::isfinite( value ) ) {
+    setJson( section, key, "null" );
+    return;
+  }
+  char buffer[32];
+  snprintf( buffer, sizeof(buffer), "%.15g", value );
+  setJson( section, key, buffer );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                long value )
+{
+  std::ostringstream json_value;
+  json_value << value;
+  setJson( section, key, json_value.str() );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                int value )
+{
+  set( section, key, static_cast<long>( value ) );
+}
+
+void
+RunReport::set( const std::string & section, const std::string & key,
+                bool value )
+{
+  setJson( section, key, value ? "true" : "false" );
+}
+
+std::string
+RunReport::toJson() const
+{
+  std::string json = "{";
+  for ( size_t s = 0; s < my_sections.size(); ++s ) {
+    if ( s > 0 ) json += ",";
+    json += quote( my_section_names[s] ) + ":{";
+    const Members & members = my_sections[s];
+    for ( size_t m = 0; m < members.size(); ++m ) {
+      if ( m > 0 ) json += ",";
+      json += quote( members[m].first ) + ":" + members[m].second;
+    }
+    json += "}";
+  }
+  return json + "}";
+}
+
+bool
+RunReport::writeToDirectory( const std::string & directory,
+                             const std::string & base_name )
+{
+  std::ostringstream file_name;
+  file_name << directory << "/" << base_name << "." << getpid() << "."
+            << report_sequence++ << ".json";
+  std::string temporary_name = file_name.str() + ".tmp";
+  std::ofstream out( temporary_name.c_str(), std::ios::out | std::ios::trunc );
+  if ( ! out ) {
+    my_error_message = "unable to create " + temporary_name;
+    return false;
+  }
+  out << toJson() << std::endl;
+  out.close();
+  if ( ! out ) {
+    unlink( temporary_name.c_str() );
+    my_error_message = "error writing " + temporary_name;
+    return false;
+  }
+  if ( rename( temporary_name.c_str(), file_name.str().c_str() ) != 0 ) {
+    unlink( temporary_name.c_str() );
+    my_error_message = "unable to rename " + temporary_name + " to "
+      + file_name.str();
+    return false;
+  }
+  return true;
+}
+
+//  [Last modified: 2026 10 17 at 18:31:07 GMT]
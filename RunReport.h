@@ -0,0 +1,72 @@
+/**
+ * @file RunReport.h
+ * @brief Machine-readable report of one run: a JSON object whose members
+ * are grouped into sections (run, parameters, dimensions, status,
+ * timings, counts, cuts, bounds)
+ *
+ * The whole object is built in memory and written with a single write,
+ * either as one line of output (-report=json) or as a file of its own in
+ * a directory (-report_dir=DIR), created under a temporary name and
+ * renamed, so that a reader never sees half a report. A run that crashes
+ * leaves no report instead of a truncated one. report2csv turns
+ * a directory of reports into a table.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef RUNREPORT_H
+#define RUNREPORT_H
+
+#include<string>
+#include<vector>
+#include<utility>
+
+/// Usage:
+///   RunReport report;
+///   report.set("status", "code", "Optimal");
+///   report.set("timings", "runtime", 1.25);
+///   cout << report.toJson() << endl;
+/// Members appear in the order in which they are first set; setting a
+/// member again replaces its value.
+class RunReport {
+public:
+  void set( const std::string & section, const std::string & key,
+            const std::string & value );
+  void set( const std::string & section, const std::string & key,
+            const char * value );
+  void set( const std::string & section, const std::string & key,
+            double value );
+  void set( const std::string & section, const std::string & key,
+            long value );
+  void set( const std::string & section, const std::string & key,
+            int value );
+  void set( const std::string & section, const std::string & key,
+            bool value );
+
+  /// @return the report as a JSON object on a single line
+  std::string toJson() const;
+
+  /// writes the report to a new file in directory, named after base_name
+  /// @return true if successful, otherwise see errorMessage()
+  bool writeToDirectory( const std::string & directory,
+                         const std::string & base_name );
+  std::string errorMessage() const { return my_error_message; }
+
+  /// @return s as a JSON string literal, with quotes
+  static std::string quote( const std::string & s );
+
+private:
+  typedef std::vector< std::pair<std::string, std::string> > Members;
+
+  /// stores a value that is already in JSON form
+  void setJson( const std::string & section, const std::string & key,
+                const std::string & json_value );
+
+  std::vector<std::string> my_section_names;
+  std::vector<Members> my_sections;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 18:31:07 GMT]
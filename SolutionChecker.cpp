@@ -0,0 +1,206 @@
+/// @file SolutionChecker.cpp
+/// @brief evaluation of rows, bounds and objective for a given solution
+
+#include"SolutionChecker.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<cmath>
+#include<string>
+
+/// integers up to this magnitude are used as such in exact arithmetic
+static const double MAX_EXACT_INTEGER = 2147483648.0;  // 2^31
+
+/// bound on |activity| that keeps 64-bit sums from overflowing
+static const double MAX_EXACT_ACTIVITY = 4611686018427387904.0;  // 2^62
+
+static bool is_small_integer( double value )
+{
+  return std::fabs( value ) <= MAX_EXACT_INTEGER && value == std::floor( value );
+}
+
+/// sum of coefficients[k] * x[columns[k]], begin <= k < end, exactly
+static int64_t integer_activity( const int64_t * __restrict coefficients,
+                                 const int * __restrict columns,
+                                 const int64_t * __restrict x,
+                                 int begin, int end )
+{
+  int64_t sum = 0;
+  for ( int k = begin; k < end; ++k ) {
+    sum += coefficients[k] * x[ columns[k] ];
+  }
+  return sum;
+}
+
+/// adds term to sum, keeping the lost low-order part in compensation
+static inline void neumaier_add( long double & sum, long double & compensation,
+                                 long double term )
+{
+  long double total = sum + term;
+  if ( fabsl( sum ) >= fabsl( term ) ) compensation += (sum - total) + term;
+  else compensation += (term - total) + sum;
+  sum = total;
+}
+
+/// sum of coefficients[k] * x[columns[k]], begin <= k < end, compensated
+static long double compensated_activity( const double * coefficients,
+                                         const int * columns, const double * x,
+                                         int begin, int end )
+{
+  long double sum = 0, compensation = 0;
+  for ( int k = begin; k < end; ++k ) {
+    neumaier_add( sum, compensation,
+                  static_cast<long double>( coefficients[k] ) * x[ columns[k] ] );
+  }
+  return sum + compensation;
+}
+
+SolutionChecker::SolutionChecker( const LpModel & model ):
+  my_model( model ),
+  my_integral_rows( true ),
+  my_max_coefficient( 0 ),
+  my_max_row_length( 0 ),
+  my_max_violation( 0 ),
+  my_worst_row( -1 ),
+  my_violated_rows( 0 ),
+  my_bound_violations( 0 ),
+  my_max_bound_violation( 0 ),
+  my_integrality_violations( 0 ),
+  my_max_integrality_violation( 0 ),
+  my_objective( 0 ),
+  my_exact( false ),
+  my_time( 0 )
+{
+  const std::vector<double> & values = model.rowValues();
+  for ( size_t k = 0; k < values.size() && my_integral_rows; ++k ) {
+    my_integral_rows = is_small_integer( values[k] );
+    my_max_coefficient = std::max( my_max_coefficient, std::fabs( values[k] ) );
+  }
+  for ( int i = 0; i < model.numberOfRows() && my_integral_rows; ++i ) {
+    my_integral_rows = is_small_integer( model.rightHandSide( i ) );
+    my_max_row_length = std::max( my_max_row_length,
+                                  model.rowEnd( i ) - model.rowBegin( i ) );
+  }
+  if ( ! my_integral_rows ) return;
+  my_coefficients.assign( values.begin(), values.end() );
+  my_rhs.assign( model.rightHandSides().begin(), model.rightHandSides().end() );
+}
+
+std::vector<double>
+SolutionChecker::columnValues( const LpModel & model,
+                               const StoredSolution & solution,
+                               size_t & unknown_names, size_t & missing_names )
+{
+  std::vector<double> values( model.numberOfColumns(), 0 );
+  std::vector<char> present( model.numberOfColumns(), 0 );
+  unknown_names = 0;
+  for ( size_t n = 0; n < solution.values.size(); ++n ) {
+    int j = model.findColumn( solution.values[n].first );
+    if ( j < 0 ) {
+      ++unknown_names;
+      continue;
+    }
+    values[j] = solution.values[n].second;
+    present[j] = 1;
+  }
+  missing_names = std::count( present.begin(), present.end(), 0 );
+  return values;
+}
+
+void
+SolutionChecker::recordRow( int i, double violation, double tolerance )
+{
+  if ( violation > tolerance ) ++my_violated_rows;
+  if ( violation > my_max_violation ) {
+    my_max_violation = violation;
+    my_worst_row = i;
+  }
+}
+
+void
+SolutionChecker::check( const std::vector<double> & values, double tolerance,
+                        bool relaxed )
+{
+  double start = ClockTimer::wallClock();
+  int number_of_columns = my_model.numberOfColumns();
+  my_max_violation = 0;
+  my_worst_row = -1;
+  my_violated_rows = 0;
+  my_bound_violations = 0;
+  my_max_bound_violation = 0;
+  my_integrality_violations = 0;
+  my_max_integrality_violation = 0;
+
+  // bounds, integrality and objective
+  long double objective = my_model.objectiveOffset(), compensation = 0;
+  bool integral_values = true;
+  double max_value = 0;
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    double x = values[j];
+    double lower = my_model.lowerBound( j );
+    double upper = my_model.upperBound( j );
+    double below = lower > -LP_INFINITY ? lower - x : 0;
+    double above = upper < LP_INFINITY ? x - upper : 0;
+    double violation = std::max( 0.0, std::max( below, above ) );
+    if ( my_model.columnType( j ) == LpModel::SEMICONTINUOUS && x == 0 ) {
+      violation = 0;
+    }
+    if ( violation > tolerance ) ++my_bound_violations;
+    my_max_bound_violation = std::max( my_max_bound_violation, violation );
+    if ( my_model.isInteger( j ) && ! relaxed ) {
+      double fraction = std::fabs( x - std::floor( x + 0.5 ) );
+      if ( fraction > tolerance ) ++my_integrality_violations;
+      my_max_integrality_violation = std::max( my_max_integrality_violation,
+                                               fraction );
+    }
+    integral_values = integral_values && is_small_integer( x );
+    max_value = std::max( max_value, std::fabs( x ) );
+    neumaier_add( objective, compensation,
+                  static_cast<long double>( my_model.objectiveCoefficient( j ) )
+                  * x );
+  }
+  my_objective = static_cast<double>( objective + compensation );
+
+  // rows
+  const int * columns = my_model.rowColumns().empty() ? 0
+    : &my_model.rowColumns()[0];
+  my_exact = my_integral_rows && integral_values
+    && my_max_coefficient * max_value * my_max_row_length < MAX_EXACT_ACTIVITY;
+  if ( my_exact ) {
+    std::vector<int64_t> x( values.begin(), values.end() );
+    const int64_t * coefficients = my_coefficients.empty() ? 0
+      : &my_coefficients[0];
+    for ( int i = 0; i < my_model.numberOfRows(); ++i ) {
+      int64_t difference = integer_activity( coefficients, columns,
+                                             x.empty() ? 0 : &x[0],
+                                             my_model.rowBegin( i ),
+                                             my_model.rowEnd( i ) )
+        - my_rhs[i];
+      char sense = my_model.rowSense( i );
+      if ( sense == LpModel::GREATER_EQUAL ) difference = -difference;
+      else if ( sense == LpModel::EQUAL && difference < 0 ) {
+        difference = -difference;
+      }
+      recordRow( i, difference > 0 ? static_cast<double>( difference ) : 0,
+                 tolerance );
+    }
+  }
+  else {
+    const double * coefficients = my_model.rowValues().empty() ? 0
+      : &my_model.rowValues()[0];
+    for ( int i = 0; i < my_model.numberOfRows(); ++i ) {
+      long double difference
+        = compensated_activity( coefficients, columns,
+                                values.empty() ? 0 : &values[0],
+                                my_model.rowBegin( i ), my_model.rowEnd( i ) )
+        - my_model.rightHandSide( i );
+      char sense = my_model.rowSense( i );
+      if ( sense == LpModel::GREATER_EQUAL ) difference = -difference;
+      else if ( sense == LpModel::EQUAL ) difference = fabsl( difference );
+      recordRow( i, difference > 0 ? static_cast<double>( difference ) : 0,
+                 tolerance );
+    }
+  }
+  my_time = ClockTimer::wallClock() - start;
+}
+
+//  [Last modified: 2026 10 17 at 22:24:05 GMT]
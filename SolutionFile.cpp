@@ -0,0 +1,148 @@
+/// @file SolutionFile.cpp
+/// @brief reading and writing of solution files
+
+#include"SolutionFile.h"
+#include<fstream>
+#include<sstream>
+#include<cstdio>
+#include<cstdlib>
+#include<unistd.h>
+
+/// splits line into its first two whitespace-separated fields
+/// @return the number of fields found (at most 3, meaning "more than 2")
+static int split_line( const std::string & line,
+                       std::string & first, std::string & second )
+{
+  std::istringstream fields( line );
+  std::string rest;
+  if ( ! (fields >> first) ) return 0;
+  if ( ! (fields >> second) ) return 1;
+  if ( fields >> rest ) return 3;
+  return 2;
+}
+
+/// @return true if text is a complete number, stored in value
+static bool parse_number( const std::string & text, double & value )
+{
+  char * end = 0;
+  value = strtod( text.c_str(), &end );
+  return end != text.c_str() && *end == '\0';
+}
+
+std::string
+SolutionFile::instanceFileName( const std::string & pattern,
+                                const std::string & instance_name )
+{
+  std::string file_name;
+  for ( size_t i = 0; i < pattern.size(); ++i ) {
+    if ( pattern[i] == '%' ) file_name += instance_name;
+    else file_name += pattern[i];
+  }
+  return file_name;
+}
+
+bool
+SolutionFile::read( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ifstream in( file_name.c_str() );
+  if ( ! in ) return fail( "unable to open " + file_name );
+  return read( in, file_name );
+}
+
+bool
+SolutionFile::read( std::istream & in, const std::string & file_name )
+{
+  my_error_message = "";
+  std::vector<std::string> lines;
+  std::string line;
+  bool has_blocks = false;
+  while ( getline( in, line ) ) {
+    std::string first, second;
+    if ( split_line( line, first, second ) == 1 && first == "BeginSolution" ) {
+      has_blocks = true;
+    }
+    lines.push_back( line );
+  }
+
+  StoredSolution solution;
+  bool in_block = ! has_blocks;
+  for ( size_t i = 0; i < lines.size(); ++i ) {
+    std::string first, second;
+    int fields = split_line( lines[i], first, second );
+    std::ostringstream where;
+    where << file_name << ", line " << i + 1;
+    if ( ! in_block ) {
+      double value;
+      if ( fields == 1 && first == "BeginSolution" ) {
+        in_block = true;
+      }
+      else if ( fields == 2 && first == "value"
+                && parse_number( second, value ) ) {
+        solution.has_value = true;
+        solution.value = value;
+      }
+      continue;
+    }
+    if ( fields == 0 || first[0] == '#' ) continue;
+    if ( has_blocks && fields == 1 && first == "EndSolution" ) {
+      my_solutions.push_back( solution );
+      solution = StoredSolution();
+      in_block = false;
+      continue;
+    }
+    double value;
+    if ( fields != 2 || ! parse_number( second, value ) ) {
+      return fail( where.str() + ": expected a variable name and a value" );
+    }
+    solution.values.push_back( std::make_pair( first, value ) );
+  }
+  if ( has_blocks && in_block ) {
+    return fail( file_name + ": BeginSolution without EndSolution" );
+  }
+  if ( ! has_blocks ) {
+    if ( solution.values.empty() ) return fail( file_name + ": no solution" );
+    my_solutions.push_back( solution );
+  }
+  return true;
+}
+
+bool
+SolutionFile::write( const std::string & file_name )
+{
+  my_error_message = "";
+  std::ostringstream temporary_name;
+  temporary_name << file_name << ".tmp." << getpid();
+  FILE * out = fopen( temporary_name.str().c_str(), "w" );
+  if ( ! out ) return fail( "unable to create " + temporary_name.str() );
+  fputs( my_header.c_str(), out );
+  for ( size_t s = 0; s < my_solutions.size(); ++s ) {
+    const StoredSolution & solution = my_solutions[s];
+    if ( solution.has_value ) fprintf( out, "value\t%.17g\n", solution.value );
+    fprintf( out, "BeginSolution\n" );
+    for ( size_t i = 0; i < solution.values.size(); ++i ) {
+      fprintf( out, "%s\t%.17g\n", solution.values[i].first.c_str(),
+               solution.values[i].second );
+    }
+    fprintf( out, "EndSolution\n" );
+  }
+  if ( fclose( out ) != 0 ) {
+    unlink( temporary_name.str().c_str() );
+    return fail( "error writing " + temporary_name.str() );
+  }
+  if ( rename( temporary_name.str().c_str(), file_name.c_str() ) != 0 ) {
+    unlink( temporary_name.str().c_str() );
+    return fail( "unable to rename " + temporary_name.str() + " to "
+                 + file_name );
+  }
+  return true;
+}
+
+bool
+SolutionFile::fail( const std::string & message )
+{
+  my_error_message = message;
+  return false;
+}
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
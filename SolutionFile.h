@@ -0,0 +1,81 @@
+/**
+ * @file SolutionFile.h
+ * @brief Reading and writing of solutions as lists of variable/value
+ * pairs, in the format cplex_ilp prints with -solution, so that the
+ * solutions of one run can be the MIP starts of the next
+ *
+ * A solution file has one or more blocks
+ *     value<TAB>COST            (optional)
+ *     BeginSolution
+ *     NAME<TAB>VALUE            (one line per variable)
+ *     ...
+ *     EndSolution
+ * and anything outside the blocks is ignored, so the complete output of a
+ * run with -solution can be used as is. A file without any BeginSolution
+ * line is taken to be a single solution of NAME VALUE lines, one per line
+ * (blank lines and lines starting with # are skipped). Names and values
+ * may be separated by tabs or blanks. Other information can precede the
+ * blocks as a header (see Checkpoint).
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef SOLUTIONFILE_H
+#define SOLUTIONFILE_H
+
+#include<string>
+#include<vector>
+#include<istream>
+#include<utility>
+
+/// one solution: the values of (some of) the variables, by name
+struct StoredSolution {
+  StoredSolution(): has_value( false ), value( 0 ) {}
+  bool has_value;               // the objective value is known
+  double value;
+  std::vector< std::pair<std::string, double> > values;
+};
+
+/// Usage:
+///   SolutionFile solutions;
+///   if ( ! solutions.read(file_name) ) error(solutions.errorMessage());
+///   for each solutions.solution(i) ...
+///   solutions.add(solution);  solutions.write(other_file_name);
+class SolutionFile {
+public:
+  /// @return pattern with each % replaced by instance_name, so that one
+  /// flag value serves all instances of a batch
+  static std::string instanceFileName( const std::string & pattern,
+                                       const std::string & instance_name );
+
+  /// appends the solutions in file_name
+  /// @return true if successful, otherwise see errorMessage()
+  bool read( const std::string & file_name );
+  /// appends the solutions in in, e.g. the captured output of a run;
+  /// source names it in error messages
+  bool read( std::istream & in, const std::string & source );
+  /// writes all solutions, in order; the file is replaced atomically (it
+  /// is written under a temporary name and renamed), so that an earlier
+  /// version survives a crash during the write
+  bool write( const std::string & file_name );
+
+  void add( const StoredSolution & solution ) { my_solutions.push_back( solution ); }
+  void clear() { my_solutions.clear(); }
+  /// lines written before the solutions; they must not contain a line
+  /// BeginSolution
+  void setHeader( const std::string & header ) { my_header = header; }
+  size_t numberOfSolutions() const { return my_solutions.size(); }
+  const StoredSolution & solution( size_t i ) const { return my_solutions[i]; }
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  bool fail( const std::string & message );
+
+  std::vector<StoredSolution> my_solutions;
+  std::string my_header;
+  std::string my_error_message;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 23:52:10 GMT]
@@ -0,0 +1,91 @@
+/// @file SolvePhases.cpp
+/// @brief phase boundaries inside IloCplex::solve()
+
+#include "SolvePhases.h"
+#include "ClockTimer.h"
+
+/// marks the start of the root LP
+class PhaseLpCallbackI: public IloCplex::ContinuousCallbackI {
+public:
+  PhaseLpCallbackI( IloEnv env, SolvePhases * phases ):
+    IloCplex::ContinuousCallbackI( env ), my_phases( phases ) {}
+  virtual void main() {
+    if ( ! my_phases->lpSeen() ) my_phases->markLp();
+  }
+  virtual IloCplex::CallbackI * duplicateCallback() const {
+    return (new (getEnv()) PhaseLpCallbackI( *this ));
+  }
+private:
+  SolvePhases * my_phases;
+};
+
+/// marks the start of branching
+class PhaseNodeCallbackI: public IloCplex::MIPInfoCallbackI {
+public:
+  PhaseNodeCallbackI( IloEnv env, SolvePhases * phases ):
+    IloCplex::MIPInfoCallbackI( env ), my_phases( phases ) {}
+  virtual void main() {
+    if ( my_phases->nodeSeen() ) return;
+    if ( ! my_phases->lpSeen() ) my_phases->markLp();
+    if ( getNnodes() > 0 ) my_phases->markNode();
+  }
+  virtual IloCplex::CallbackI * duplicateCallback() const {
+    return (new (getEnv()) PhaseNodeCallbackI( *this ));
+  }
+private:
+  SolvePhases * my_phases;
+};
+
+void
+SolvePhases::use( IloEnv env, IloCplex cplex )
+{
+  cplex.use( IloCplex::Callback( new (env) PhaseLpCallbackI( env, this ) ) );
+  cplex.use( IloCplex::Callback( new (env) PhaseNodeCallbackI( env, this ) ) );
+}
+
+void
+SolvePhases::start()
+{
+  my_lp_seen = false;
+  my_node_seen = false;
+  my_start_wall = ClockTimer::wallClock();
+  my_start_cpu = ClockTimer::cpuClock();
+}
+
+void
+SolvePhases::markLp()
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  if ( my_lp_seen ) return;
+  my_lp_wall = ClockTimer::wallClock();
+  my_lp_cpu = ClockTimer::cpuClock();
+  my_lp_seen = true;
+}
+
+void
+SolvePhases::markNode()
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  if ( my_node_seen ) return;
+  my_node_wall = ClockTimer::wallClock();
+  my_node_cpu = ClockTimer::cpuClock();
+  my_node_seen = true;
+}
+
+void
+SolvePhases::stop( PhaseProfiler & profiler )
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  double end_wall = ClockTimer::wallClock();
+  double end_cpu = ClockTimer::cpuClock();
+  // a phase that was never reached ends where the previous one does
+  double lp_wall = my_lp_seen ? my_lp_wall : end_wall;
+  double lp_cpu = my_lp_seen ? my_lp_cpu : end_cpu;
+  double node_wall = my_node_seen ? my_node_wall : end_wall;
+  double node_cpu = my_node_seen ? my_node_cpu : end_cpu;
+  profiler.add( "presolve", lp_wall - my_start_wall, lp_cpu - my_start_cpu );
+  profiler.add( "root", node_wall - lp_wall, node_cpu - lp_cpu );
+  profiler.add( "branch", end_wall - node_wall, end_cpu - node_cpu );
+}
+
+//  [Last modified: 2026 10 17 at 19:36:50 GMT]
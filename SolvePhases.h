@@ -0,0 +1,59 @@
+/**
+ * @file SolvePhases.h
+ * @brief Splits the time of IloCplex::solve() into presolve, root LP and
+ * branch and bound, using callbacks to see where one ends and the next
+ * begins
+ *
+ * The root LP is taken to start at the first call of a continuous
+ * (simplex) callback or MIP info callback, and branch and bound at the
+ * first MIP info callback with at least one node processed. Both
+ * callbacks only compare an atomic flag after the first call. The
+ * boundaries are those the callbacks can observe; e.g., presolve includes
+ * the setup of the root LP, and the root phase includes root cuts and
+ * heuristics.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef SOLVEPHASES_H
+#define SOLVEPHASES_H
+
+#include <atomic>
+#include <mutex>
+#include <ilcplex/ilocplex.h>
+#include "PhaseProfiler.h"
+
+/// Usage:
+///   SolvePhases phases;
+///   phases.use(env, cplex);
+///   phases.start(); cplex.solve(); phases.stop(profiler);
+class SolvePhases {
+public:
+  SolvePhases(): my_lp_seen( false ), my_node_seen( false ) {}
+
+  /// installs the callbacks
+  void use( IloEnv env, IloCplex cplex );
+  void start();
+  /// adds phases presolve, root and branch to profiler
+  void stop( PhaseProfiler & profiler );
+
+  /// called from the callbacks
+  void markLp();
+  void markNode();
+  bool lpSeen() const { return my_lp_seen.load( std::memory_order_relaxed ); }
+  bool nodeSeen() const {
+    return my_node_seen.load( std::memory_order_relaxed );
+  }
+
+private:
+  std::mutex my_mutex;
+  std::atomic<bool> my_lp_seen;
+  std::atomic<bool> my_node_seen;
+  double my_start_wall, my_start_cpu;
+  double my_lp_wall, my_lp_cpu;
+  double my_node_wall, my_node_cpu;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 19:36:50 GMT]
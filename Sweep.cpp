@@ -0,0 +1,244 @@
+/// @file Sweep.cpp
+/// @brief parameter sweep over a grid of flag values
+
+#include "Sweep.h"
+#include "LpParser.h"
+#include "CnfParser.h"
+#include "WorkStealingPool.h"
+#include "ClockTimer.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+ILOSTLBEGIN
+
+/// tags harvested from the output of each run, in CSV column order
+static const char * const RESULT_TAGS[] = {
+  "StatusCode", "value", "runtime", "CPXtime", "TimedOut", "ProvedOptimal",
+  "num_branches", "iterations", 0
+};
+
+/// an instance and the model shared by all runs on it
+struct SweepInstance {
+  mutex lock;
+  bool read_attempted;
+  bool parsed;
+  LpModel model;
+  atomic<int> runs_left;
+};
+
+bool readParameterGrid( const string & grid_file_name,
+                        vector<GridParameter> & grid )
+{
+  ifstream grid_stream( grid_file_name.c_str() );
+  if ( ! grid_stream ) return false;
+  string line;
+  while ( getline( grid_stream, line ) ) {
+    istringstream line_stream( line );
+    GridParameter parameter;
+    if ( ! (line_stream >> parameter.flag) ) continue;
+    if ( parameter.flag[0] == '#' ) continue;
+    if ( parameter.flag[0] == '-' ) parameter.flag.erase( 0, 1 );
+    string value;
+    while ( line_stream >> value ) parameter.values.push_back( value );
+    if ( parameter.values.empty() ) {
+      cerr << "Grid flag " << parameter.flag << " has no values." << endl;
+      return false;
+    }
+    grid.push_back( parameter );
+  }
+  return true;
+}
+
+static string csv_field( const string & value )
+{
+  if ( value.find_first_of( ",\"" ) == string::npos ) return value;
+  string quoted = "\"";
+  for ( size_t i = 0; i < value.size(); ++i ) {
+    if ( value[i] == '"' ) quoted += '"';
+    quoted += value[i];
+  }
+  return quoted + "\"";
+}
+
+int runSweep( const CmdLine & command_line, InstanceSolver solve_instance,
+              ostream & out )
+{
+  vector<GridParameter> grid;
+  string grid_file_name = command_line.stringFlag( "sweep" );
+  if ( ! readParameterGrid( grid_file_name, grid ) ) {
+    cerr << "Unable to read parameter grid " << grid_file_name << endl;
+    return EXIT_FAILURE;
+  }
+  vector<BatchEntry> entries;
+  if ( ! collectBatchEntries( command_line, entries ) ) return EXIT_FAILURE;
+  if ( entries.empty() ) {
+    cerr << "Sweep: no instances given." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // the last flag in the grid varies fastest
+  size_t combinations = 1;
+  vector<size_t> strides( grid.size(), 1 );
+  for ( size_t p = grid.size(); p-- > 0; ) {
+    strides[p] = combinations;
+    combinations *= grid[p].values.size();
+  }
+  const size_t number_of_runs = entries.size() * combinations;
+
+  unsigned workers = 1;
+  unsigned threads_per_instance = 1;
+  batchResources( command_line, number_of_runs, workers,
+                  threads_per_instance );
+  ostringstream threads_value;
+  threads_value << threads_per_instance;
+
+  vector< unique_ptr<SweepInstance> > instances;
+  for ( size_t i = 0; i < entries.size(); ++i ) {
+    instances.push_back( unique_ptr<SweepInstance>( new SweepInstance ) );
+    instances[i]->read_attempted = false;
+    instances[i]->parsed = false;
+    instances[i]->runs_left = combinations;
+  }
+  const bool native_reader = ! command_line.flagPresent( "cplex_reader" );
+
+  ofstream log_stream;
+  if ( command_line.flagPresent( "sweep_log" ) ) {
+    string log_file_name = command_line.stringFlag( "sweep_log" );
+    log_stream.open( log_file_name.c_str() );
+    if ( ! log_stream ) {
+      cerr << "Unable to open sweep log " << log_file_name << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  out << "instance";
+  for ( size_t p = 0; p < grid.size(); ++p ) out << "," << grid[p].flag;
+  for ( const char * const * tag = RESULT_TAGS; *tag; ++tag ) {
+    out << "," << *tag;
+  }
+  out << ",exit_status" << endl;
+
+  // results are printed in run order by whichever worker completes the
+  // next run in sequence
+  mutex output_mutex;
+  vector<string> csv_lines( number_of_runs );
+  vector<string> logs( number_of_runs );
+  vector<bool> done( number_of_runs, false );
+  size_t next_to_print = 0;
+  unsigned failures = 0;
+
+  // one environment per worker
+  vector<IloEnv> envs;
+  for ( unsigned w = 0; w < workers; ++w ) envs.push_back( IloEnv() );
+
+  WorkStealingPool pool( workers );
+  // consecutive runs (mostly on the same instance) go to the same worker
+  for ( size_t run = 0; run < number_of_runs; ++run ) {
+    pool.addTask( run * workers / number_of_runs, run );
+  }
+
+  ClockTimer sweep_timer = ClockTimer();
+  sweep_timer.start();
+  pool.run( [&]( unsigned worker, size_t run ) {
+      size_t instance_index = run / combinations;
+      size_t combination = run % combinations;
+      const BatchEntry & entry = entries[instance_index];
+      SweepInstance & instance = *instances[instance_index];
+
+      const LpModel * shared_model = 0;
+      {
+        lock_guard<mutex> guard( instance.lock );
+        if ( ! instance.read_attempted ) {
+          instance.read_attempted = true;
+          if ( CnfParser::isCnfFile( entry.file_name ) ) {
+            CnfParser parser;
+            instance.parsed = parser.parse( entry.file_name, instance.model );
+          }
+          else if ( native_reader && LpParser::isLpFile( entry.file_name ) ) {
+            LpParser parser;
+            instance.parsed = parser.parse( entry.file_name, instance.model );
+          }
+        }
+        if ( instance.parsed ) shared_model = &instance.model;
+      }
+
+      CmdLine options( command_line );
+      options.setFlag( "threads", threads_value.str() );
+      if ( ! entry.upper_bound.empty()
+           && atof( entry.upper_bound.c_str() ) > 0 ) {
+        options.setFlag( "UB", entry.upper_bound );
+      }
+      string csv_line = csv_field( entry.file_name );
+      for ( size_t p = 0; p < grid.size(); ++p ) {
+        const string & value
+          = grid[p].values[ (combination / strides[p]) % grid[p].values.size() ];
+        if ( value != "_" ) options.setFlag( grid[p].flag, value );
+        csv_line += "," + csv_field( value );
+      }
+
+      ostringstream output;
+      int status = EXIT_FAILURE;
+      try {
+        status = solve_instance( envs[worker], options, entry.file_name,
+                                 shared_model, 0, output );
+      }
+      catch ( IloException & e ) {
+        output << "ERROR\t" << e.getMessage() << endl;
+        e.end();
+      }
+      catch ( ... ) {
+        output << "ERROR\tunexpected exception" << endl;
+      }
+      if ( --instance.runs_left == 0 ) {
+        // last run on this instance: release the model
+        lock_guard<mutex> guard( instance.lock );
+        instance.model = LpModel();
+      }
+
+      string text = output.str();
+      for ( const char * const * tag = RESULT_TAGS; *tag; ++tag ) {
+        string value = outputTagValue( text, *tag );
+        // the status is printed after a placeholder _ (see solveInstance)
+        if ( ! value.empty() && value[0] == '_' ) value.erase( 0, 1 );
+        csv_line += "," + csv_field( value );
+      }
+      ostringstream status_field;
+      status_field << status;
+      csv_line += "," + status_field.str();
+
+      lock_guard<mutex> guard( output_mutex );
+      if ( status != 0 ) ++failures;
+      csv_lines[run] = csv_line;
+      if ( log_stream.is_open() ) logs[run] = text;
+      done[run] = true;
+      while ( next_to_print < number_of_runs && done[next_to_print] ) {
+        out << csv_lines[next_to_print] << endl;
+        if ( log_stream.is_open() ) {
+          log_stream << "===== cplex_ilp " << csv_lines[next_to_print]
+                     << " =====" << endl
+                     << logs[next_to_print]
+                     << "===================================================="
+                     << endl << endl;
+          logs[next_to_print].clear();
+        }
+        csv_lines[next_to_print].clear();
+        ++next_to_print;
+      }
+    } );
+  sweep_timer.stop();
+  for ( unsigned w = 0; w < workers; ++w ) envs[w].end();
+
+  // summary goes to stderr so that stdout remains a valid CSV file
+  cerr << "Sweep: " << number_of_runs << " runs (" << entries.size()
+       << " instances x " << combinations << " combinations), "
+       << failures << " failed, " << workers << " workers x "
+       << threads_per_instance << " threads, " << pool.tasksStolen()
+       << " runs stolen, wall time " << sweep_timer.getTotalTime() << endl;
+  return failures == 0 ? 0 : EXIT_FAILURE;
+}
+
+//  [Last modified: 2026 10 18 at 02:33:50 GMT]
@@ -0,0 +1,51 @@
+/**
+ * @file Sweep.h
+ * @brief Parameter sweep: runs every combination of a grid of flag values
+ * on every instance and reports the results as one CSV table
+ *
+ * The grid file has one line per flag: the flag name (without -) followed
+ * by the values it should take, e.g.
+ *     nsel b e f
+ *     feasible 0 2 3
+ * A value of _ leaves the flag as it is on the command line (absent unless
+ * given there). Blank lines and lines starting with # are ignored.
+ *
+ * Each instance is read once; all runs on it load the same parsed model
+ * into their own environment instead of reading the file again. Runs are
+ * scheduled on a WorkStealingPool, with the runs on each instance given to
+ * the same worker initially.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Batch.h"
+
+/// a flag and the values it takes in a sweep
+struct GridParameter {
+  std::string flag;
+  std::vector<std::string> values;
+};
+
+/// @return true if the grid file could be read and every line has a flag
+/// and at least one value
+bool readParameterGrid( const std::string & grid_file_name,
+                        std::vector<GridParameter> & grid );
+
+/// Runs the grid given by -sweep=GRIDFILE on the instances given as in
+/// batch mode (command line files and -batch=LISTFILE). Prints a CSV line
+/// per run, ordered by instance and then by parameter tuple (the last flag
+/// in the grid varies fastest). With -sweep_log=FILE the full tag/value
+/// output of every run goes to FILE, in the same order.
+/// @return 0 if every run finished without error
+int runSweep( const CmdLine & command_line, InstanceSolver solve_instance,
+              std::ostream & out );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 17:22:03 GMT]
@@ -0,0 +1,439 @@
+/// @file SymmetryDetector.cpp
+/// @brief automorphisms of a model by individualization and refinement
+
+#include"SymmetryDetector.h"
+#include"ClockTimer.h"
+#include"DisjointSets.h"
+#include<algorithm>
+#include<map>
+#include<cmath>
+#include<cstring>
+
+/// refinements allowed below each candidate image of a base column
+static const size_t NODES_PER_CANDIDATE = 256;
+/// the partitions kept along the first path may take at most this many
+/// integers; beyond that the search is not attempted
+static const size_t MAX_STORED_COLORS = size_t( 1 ) << 25;
+
+static uint64_t mix( uint64_t x )
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+static uint64_t bits( double x )
+{
+  if ( x == 0 ) x = 0;          // -0 and 0 are the same value
+  uint64_t result;
+  std::memcpy( &result, &x, sizeof( result ) );
+  return result;
+}
+
+static uint64_t combine( uint64_t seed, uint64_t value )
+{
+  return mix( seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6)) );
+}
+
+SymmetryDetector::SymmetryDetector( const LpModel & model ):
+  my_model( model ), my_columns( model.numberOfColumns() ),
+  my_vertices( model.numberOfColumns() + model.numberOfRows() ),
+  my_group_size_log10( 0 ), my_orbits( 0 ), my_columns_in_orbits( 0 ),
+  my_complete( false ), my_nodes( 0 ), my_deadline( 0 ), my_time( 0 )
+{
+  int number_of_rows = model.numberOfRows();
+  const std::vector<int> & row_columns = model.rowColumns();
+  const std::vector<double> & row_values = model.rowValues();
+
+  // edge colors: the distinct coefficient values, in increasing order
+  std::map<double, int> value_colors;
+  for ( size_t k = 0; k < row_values.size(); ++k ) value_colors[ row_values[k] ];
+  int next_color = 0;
+  for ( std::map<double, int>::iterator entry = value_colors.begin();
+        entry != value_colors.end(); ++entry ) {
+    entry->second = next_color++;
+  }
+
+  // adjacency: columns (via the transpose), then rows
+  std::vector<int> degree( my_vertices, 0 );
+  for ( size_t k = 0; k < row_columns.size(); ++k ) ++degree[ row_columns[k] ];
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    degree[ my_columns + i ] = model.rowEnd( i ) - model.rowBegin( i );
+  }
+  my_starts.assign( my_vertices + 1, 0 );
+  for ( int v = 0; v < my_vertices; ++v ) {
+    my_starts[v + 1] = my_starts[v] + degree[v];
+  }
+  my_neighbors.resize( my_starts[ my_vertices ] );
+  my_edge_colors.resize( my_starts[ my_vertices ] );
+  std::vector<int> next( my_starts.begin(), my_starts.end() - 1 );
+  my_rows.resize( number_of_rows );
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    for ( int k = model.rowBegin( i ); k < model.rowEnd( i ); ++k ) {
+      int j = row_columns[k];
+      int color = value_colors[ row_values[k] ];
+      my_neighbors[ next[j] ] = my_columns + i;
+      my_edge_colors[ next[j]++ ] = color;
+      my_neighbors[ next[ my_columns + i ] ] = j;
+      my_edge_colors[ next[ my_columns + i ]++ ] = color;
+      my_rows[i].push_back( std::make_pair( j, row_values[k] ) );
+    }
+    std::sort( my_rows[i].begin(), my_rows[i].end() );
+  }
+
+  // initial colors: columns by attributes, rows by sense and right hand side
+  my_initial_keys.resize( my_vertices );
+  for ( int j = 0; j < my_columns; ++j ) {
+    uint64_t key = combine( model.columnType( j ), bits( model.lowerBound( j ) ) );
+    key = combine( key, bits( model.upperBound( j ) ) );
+    my_initial_keys[j] = combine( key, bits( model.objectiveCoefficient( j ) ) );
+  }
+  std::vector<int> identity( my_columns );
+  for ( int j = 0; j < my_columns; ++j ) identity[j] = j;
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    my_initial_keys[ my_columns + i ]
+      = combine( model.rowSense( i ), bits( model.rightHandSide( i ) ) );
+    my_row_keys.push_back( std::make_pair( rowKey( i, identity ), i ) );
+  }
+  std::sort( my_row_keys.begin(), my_row_keys.end() );
+  my_scratch.resize( my_vertices );
+}
+
+bool
+SymmetryDetector::detect( double time_limit )
+{
+  double start = ClockTimer::wallClock();
+  my_deadline = start + time_limit;
+  my_levels.clear();
+  my_generators.clear();
+  my_generator_levels.clear();
+  my_bases.clear();
+  my_inequalities.clear();
+  my_group_size_log10 = 0;
+  my_orbits = 0;
+  my_columns_in_orbits = 0;
+  my_complete = true;
+  my_nodes = 0;
+
+  // initial partition: columns (all before rows), then rows, by key
+  Partition partition;
+  partition.order.resize( my_vertices );
+  for ( int v = 0; v < my_vertices; ++v ) partition.order[v] = v;
+  std::sort( partition.order.begin(), partition.order.end(),
+             [this]( int a, int b ) {
+               bool a_row = a >= my_columns, b_row = b >= my_columns;
+               if ( a_row != b_row ) return b_row;
+               return my_initial_keys[a] < my_initial_keys[b];
+             } );
+  partition.colors.resize( my_vertices );
+  partition.cells = 0;
+  for ( int p = 0; p < my_vertices; ++p ) {
+    int v = partition.order[p];
+    int previous = p > 0 ? partition.order[p - 1] : -1;
+    if ( p == 0 || (previous >= my_columns) != (v >= my_columns)
+         || my_initial_keys[previous] != my_initial_keys[v] ) {
+      partition.colors[v] = p;
+      ++partition.cells;
+    }
+    else partition.colors[v] = partition.colors[previous];
+  }
+  refine( partition );
+
+  // first path: individualize the first column of the first nontrivial
+  // cell until every column is in a cell of its own
+  int size = 0;
+  for ( int target = targetCell( partition, size ); target >= 0;
+        target = targetCell( partition, size ) ) {
+    if ( outOfTime()
+         || (my_levels.size() + 1) * 2 * my_vertices > MAX_STORED_COLORS ) {
+      my_complete = false;
+      my_levels.clear();
+      my_bases.clear();
+      my_time = ClockTimer::wallClock() - start;
+      return false;
+    }
+    Level level;
+    level.partition = partition;
+    level.target = target;
+    level.target_size = size;
+    my_levels.push_back( level );
+    my_bases.push_back( partition.order[ target ] );
+    individualize( partition, partition.order[ target ] );
+  }
+  my_first_leaf.assign( partition.order.begin(),
+                        partition.order.begin() + my_columns );
+
+  // deepest level first, so that the generators found at a level fix the
+  // bases above it
+  DisjointSets orbits( my_columns );
+  bool timed_out = false;
+  for ( size_t l = my_levels.size(); l-- > 0; ) {
+    const Level & level = my_levels[l];
+    int base = level.partition.order[ level.target ];
+    std::vector<int> failed;
+    for ( int k = level.target; k < level.target + level.target_size
+            && ! timed_out; ++k ) {
+      int candidate = level.partition.order[k];
+      if ( orbits.find( candidate ) == orbits.find( base ) ) continue;
+      bool known_failure = false;
+      for ( size_t f = 0; f < failed.size() && ! known_failure; ++f ) {
+        known_failure = orbits.find( failed[f] ) == orbits.find( candidate );
+      }
+      if ( known_failure ) continue;
+      if ( outOfTime() ) {
+        timed_out = true;
+        my_complete = false;
+        break;
+      }
+      Partition image = level.partition;
+      individualize( image, candidate );
+      size_t budget = NODES_PER_CANDIDATE;
+      if ( search( image, l + 1, budget ) ) {
+        const std::vector<int> & generator = my_generators.back();
+        my_generator_levels.push_back( l );
+        for ( int j = 0; j < my_columns; ++j ) orbits.unite( j, generator[j] );
+      }
+      else {
+        if ( budget == 0 ) my_complete = false;
+        failed.push_back( candidate );
+      }
+    }
+    // valid even if the search stopped: the orbit is that of the group
+    // generated so far, whose generators all fix the bases above l
+    int orbit_size = orbits.setSize( base );
+    my_group_size_log10 += std::log10( static_cast<double>( orbit_size ) );
+    if ( orbit_size > 1 ) {
+      for ( int j = 0; j < my_columns; ++j ) {
+        if ( j != base && orbits.find( j ) == orbits.find( base ) ) {
+          my_inequalities.push_back( std::make_pair( base, j ) );
+        }
+      }
+    }
+  }
+  for ( int j = 0; j < my_columns; ++j ) {
+    if ( orbits.find( j ) == j && orbits.setSize( j ) > 1 ) {
+      ++my_orbits;
+      my_columns_in_orbits += orbits.setSize( j );
+    }
+  }
+  my_time = ClockTimer::wallClock() - start;
+  return my_complete;
+}
+
+bool
+SymmetryDetector::representative( std::vector<double> & x ) const
+{
+  std::vector<double> y( x );
+  std::vector<double> permuted( my_columns );
+  std::vector<int> parent( my_columns );
+  std::vector<int> via( my_columns );     // generator that reached a column
+  std::vector<int> orbit;
+  for ( size_t l = 0; l < my_bases.size(); ++l ) {
+    // the orbit of the base under the generators found at l or deeper, as
+    // a tree of the generators that reach each column
+    int base = my_bases[l];
+    std::fill( parent.begin(), parent.end(), -1 );
+    parent[base] = base;
+    orbit.assign( 1, base );
+    for ( size_t k = 0; k < orbit.size(); ++k ) {
+      for ( size_t g = 0; g < my_generators.size(); ++g ) {
+        if ( my_generator_levels[g] < l ) continue;
+        int image = my_generators[g][ orbit[k] ];
+        if ( parent[image] >= 0 ) continue;
+        parent[image] = orbit[k];
+        via[image] = g;
+        orbit.push_back( image );
+      }
+    }
+    if ( orbit.size() == 1 ) continue;
+    int largest = base;
+    for ( size_t k = 0; k < orbit.size(); ++k ) {
+      if ( std::isnan( y[ orbit[k] ] ) ) return false;
+      if ( y[ orbit[k] ] > y[largest] ) largest = orbit[k];
+    }
+    // largest = g_k(...g_1(base)): y_i = y_{g(i)} for g = g_k, ..., g_1
+    // moves its value to the base
+    for ( int c = largest; c != base; c = parent[c] ) {
+      const std::vector<int> & generator = my_generators[ via[c] ];
+      for ( int j = 0; j < my_columns; ++j ) permuted[j] = y[ generator[j] ];
+      y.swap( permuted );
+    }
+  }
+  x.swap( y );
+  return true;
+}
+
+void
+SymmetryDetector::refine( Partition & partition )
+{
+  ++my_nodes;
+  std::vector<int> & colors = partition.colors;
+  std::vector<int> & order = partition.order;
+  while ( true ) {
+    for ( int v = 0; v < my_vertices; ++v ) {
+      uint64_t sum = 0;
+      for ( int k = my_starts[v]; k < my_starts[v + 1]; ++k ) {
+        sum += mix( (static_cast<uint64_t>( colors[ my_neighbors[k] ] ) << 24)
+                    + my_edge_colors[k] + 1 );
+      }
+      my_scratch[v] = sum;
+    }
+    // split each cell by the sums; the new cells take consecutive colors
+    int cells = 0;
+    for ( int start = 0; start < my_vertices; ) {
+      int color = colors[ order[start] ];
+      int end = start + 1;
+      while ( end < my_vertices && colors[ order[end] ] == color ) ++end;
+      std::sort( order.begin() + start, order.begin() + end,
+                 [this]( int a, int b ) {
+                   return my_scratch[a] < my_scratch[b];
+                 } );
+      start = end;
+    }
+    std::vector<int> old_colors( colors );
+    for ( int p = 0; p < my_vertices; ++p ) {
+      int v = order[p];
+      int previous = p > 0 ? order[p - 1] : -1;
+      if ( p == 0 || old_colors[previous] != old_colors[v]
+           || my_scratch[previous] != my_scratch[v] ) {
+        colors[v] = p;
+        ++cells;
+      }
+      else colors[v] = colors[previous];
+    }
+    if ( cells == partition.cells ) break;
+    partition.cells = cells;
+  }
+}
+
+void
+SymmetryDetector::individualize( Partition & partition, int vertex )
+{
+  int color = partition.colors[vertex];
+  int end = color;
+  while ( end < my_vertices && partition.colors[ partition.order[end] ] == color ) {
+    if ( partition.order[end] == vertex ) {
+      std::swap( partition.order[end], partition.order[color] );
+    }
+    ++end;
+  }
+  for ( int p = color + 1; p < end; ++p ) {
+    partition.colors[ partition.order[p] ] = color + 1;
+  }
+  ++partition.cells;
+  refine( partition );
+}
+
+int
+SymmetryDetector::targetCell( const Partition & partition, int & size ) const
+{
+  // columns are at positions 0 .. my_columns - 1
+  for ( int start = 0; start < my_columns; ) {
+    int color = partition.colors[ partition.order[start] ];
+    int end = start + 1;
+    while ( end < my_columns && partition.colors[ partition.order[end] ] == color ) {
+      ++end;
+    }
+    if ( end - start > 1 ) {
+      size = end - start;
+      return color;
+    }
+    start = end;
+  }
+  size = 1;
+  return -1;
+}
+
+bool
+SymmetryDetector::search( const Partition & partition, size_t depth,
+                          size_t & budget )
+{
+  int size = 0;
+  int target = targetCell( partition, size );
+  if ( depth == my_levels.size() ) {
+    if ( target >= 0 ) return false;
+    std::vector<int> permutation( my_columns );
+    for ( int p = 0; p < my_columns; ++p ) {
+      permutation[ my_first_leaf[p] ] = partition.order[p];
+    }
+    if ( ! isAutomorphism( permutation ) ) return false;
+    my_generators.push_back( permutation );
+    return true;
+  }
+  const Level & level = my_levels[depth];
+  if ( partition.cells != level.partition.cells || target != level.target
+       || size != level.target_size ) {
+    return false;
+  }
+  for ( int k = target; k < target + size; ++k ) {
+    if ( budget == 0 || outOfTime() ) return false;
+    --budget;
+    Partition next = partition;
+    individualize( next, partition.order[k] );
+    if ( search( next, depth + 1, budget ) ) return true;
+  }
+  return false;
+}
+
+bool
+SymmetryDetector::isAutomorphism( const std::vector<int> & permutation )
+{
+  for ( int j = 0; j < my_columns; ++j ) {
+    int image = permutation[j];
+    if ( my_model.columnType( j ) != my_model.columnType( image )
+         || my_model.lowerBound( j ) != my_model.lowerBound( image )
+         || my_model.upperBound( j ) != my_model.upperBound( image )
+         || my_model.objectiveCoefficient( j )
+            != my_model.objectiveCoefficient( image ) ) {
+      return false;
+    }
+  }
+  // every row must be mapped onto a row of the model
+  for ( int i = 0; i < my_model.numberOfRows(); ++i ) {
+    uint64_t key = rowKey( i, permutation );
+    std::vector< std::pair<uint64_t, int> >::const_iterator candidate
+      = std::lower_bound( my_row_keys.begin(), my_row_keys.end(),
+                          std::make_pair( key, -1 ) );
+    bool found = false;
+    for ( ; candidate != my_row_keys.end() && candidate->first == key
+            && ! found; ++candidate ) {
+      int r = candidate->second;
+      found = my_model.rowSense( r ) == my_model.rowSense( i )
+        && my_model.rightHandSide( r ) == my_model.rightHandSide( i )
+        && my_rows[r] == my_image;
+    }
+    if ( ! found ) return false;
+  }
+  return true;
+}
+
+/// @return a hash of the image of row under permutation, which is left in
+/// my_image
+uint64_t
+SymmetryDetector::rowKey( int row, const std::vector<int> & permutation )
+{
+  my_image.clear();
+  for ( size_t k = 0; k < my_rows[row].size(); ++k ) {
+    my_image.push_back( std::make_pair( permutation[ my_rows[row][k].first ],
+                                        my_rows[row][k].second ) );
+  }
+  std::sort( my_image.begin(), my_image.end() );
+  uint64_t key = combine( my_model.rowSense( row ),
+                          bits( my_model.rightHandSide( row ) ) );
+  for ( size_t k = 0; k < my_image.size(); ++k ) {
+    key = combine( key, my_image[k].first );
+    key = combine( key, bits( my_image[k].second ) );
+  }
+  return key;
+}
+
+bool
+SymmetryDetector::outOfTime()
+{
+  return ClockTimer::wallClock() > my_deadline;
+}
+
+//  [Last modified: 2026 10 18 at 09:02:15 GMT]
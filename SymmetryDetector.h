@@ -0,0 +1,145 @@
+/**
+ * @file SymmetryDetector.h
+ * @brief Permutations of the columns of a model that map it onto itself
+ * (-symmetry), and symmetry-breaking inequalities derived from them
+ *
+ * The model is seen as a bipartite graph: a vertex per column, colored by
+ * type, bounds and objective coefficient, a vertex per row, colored by
+ * sense and right hand side, and an edge per nonzero, colored by its
+ * value. Automorphisms are found by individualization and refinement, as
+ * in nauty: colors are refined (each vertex is told apart by the colors
+ * of its neighbors, over the colors of its edges) until they are stable,
+ * and a column of the first cell with more than one column is given a
+ * color of its own, over and over until every column has its own color.
+ * That first path fixes a base b_0, b_1, ... of columns. Then, deepest
+ * level first, each other column w of the cell of b_l is individualized
+ * instead and the tree below it is searched for a leaf that matches the
+ * first one; the permutation from one leaf to the other is kept as a
+ * generator if it really maps the model onto itself. Columns in the same
+ * orbit as one already tried are skipped. The search below each w is
+ * bounded, so some generators can be missed; those found are always
+ * automorphisms.
+ *
+ * The generators found at level l or deeper fix b_0, ..., b_{l-1}; if O_l
+ * is the orbit of b_l under the group they generate, every feasible
+ * solution can be permuted so that x_{b_l} >= x_j for all j in O_l, for
+ * all l at once. These inequalities (orbital symmetry breaking, as in the
+ * schemes of Liberti for stabilizer chains) are what the solver is given.
+ * The product of the orbit sizes |O_l| is the order of the group found;
+ * it is the order of the automorphism group if the search completed.
+ *
+ * A given solution (a MIP start) generally violates these inequalities;
+ * representative() permutes it into one that satisfies them, level by
+ * level from the top: the largest value of O_l is moved to b_l by the
+ * generators found at l or deeper, which fix the bases above it and map
+ * each orbit above onto itself.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef SYMMETRYDETECTOR_H
+#define SYMMETRYDETECTOR_H
+
+#include<vector>
+#include<utility>
+#include<cstddef>
+#include<stdint.h>
+#include"LpModel.h"
+
+/// Usage:
+///   SymmetryDetector symmetry( model );
+///   symmetry.detect( time_limit );
+///   for each pair (i, j) in symmetry.inequalities(): add x_i >= x_j
+///   for each start x: symmetry.representative( x ), then add x
+class SymmetryDetector {
+public:
+  explicit SymmetryDetector( const LpModel & model );
+
+  /// searches for generators for at most time_limit seconds
+  /// @return true if the search completed
+  bool detect( double time_limit );
+
+  size_t numberOfGenerators() const { return my_generators.size(); }
+  /// image of each column under generator g
+  const std::vector<int> & generator( size_t g ) const {
+    return my_generators[g];
+  }
+  /// log10 of the order of the group generated
+  double groupSizeLog10() const { return my_group_size_log10; }
+  /// number of orbits with more than one column, and columns in them
+  int numberOfOrbits() const { return my_orbits; }
+  int columnsInOrbits() const { return my_columns_in_orbits; }
+  /// pairs (i, j) such that x_i >= x_j can be imposed
+  const std::vector< std::pair<int, int> > & inequalities() const {
+    return my_inequalities;
+  }
+  bool complete() const { return my_complete; }
+
+  /// permutes x (a value per column, NaN where unknown), which may be a
+  /// solution, into an equivalent one that satisfies inequalities()
+  /// @return false, with x unchanged, if a value of an orbit is unknown
+  bool representative( std::vector<double> & x ) const;
+  /// search tree nodes (refinements) visited
+  size_t nodes() const { return my_nodes; }
+  double time() const { return my_time; }
+
+private:
+  /// colors of all vertices (columns, then rows) and the vertices sorted
+  /// by color; the color of a vertex is the position of its cell in order
+  struct Partition {
+    std::vector<int> colors;
+    std::vector<int> order;
+    int cells;
+  };
+  /// a level of the first path: the partition before individualizing
+  /// its base, the cell (color and size) the base is taken from
+  struct Level {
+    Partition partition;
+    int target;
+    int target_size;
+  };
+
+  void refine( Partition & partition );
+  void individualize( Partition & partition, int vertex );
+  /// @return the color of the first cell of columns with more than one
+  /// column, -1 if there is none
+  int targetCell( const Partition & partition, int & size ) const;
+  /// searches the tree below partition, at depth, for a leaf matching the
+  /// first; adds its permutation if found
+  bool search( const Partition & partition, size_t depth, size_t & budget );
+  bool isAutomorphism( const std::vector<int> & permutation );
+  uint64_t rowKey( int row, const std::vector<int> & permutation );
+  bool outOfTime();
+
+  const LpModel & my_model;
+  int my_columns;
+  int my_vertices;
+  /// adjacency of all vertices, with edge colors
+  std::vector<int> my_starts;
+  std::vector<int> my_neighbors;
+  std::vector<int> my_edge_colors;
+  std::vector<uint64_t> my_initial_keys;
+  /// rows as sorted (column, value) lists, and rows by key
+  std::vector< std::vector< std::pair<int, double> > > my_rows;
+  std::vector< std::pair<uint64_t, int> > my_row_keys;
+
+  std::vector<Level> my_levels;
+  std::vector<int> my_first_leaf;
+  std::vector< std::vector<int> > my_generators;
+  std::vector<size_t> my_generator_levels;  // level each was found at
+  std::vector<int> my_bases;                // base of each level
+  std::vector< std::pair<int, int> > my_inequalities;
+  double my_group_size_log10;
+  int my_orbits;
+  int my_columns_in_orbits;
+  bool my_complete;
+  size_t my_nodes;
+  double my_deadline;
+  double my_time;
+  std::vector<uint64_t> my_scratch;
+  std::vector< std::pair<int, double> > my_image;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 09:02:15 GMT]
@@ -0,0 +1,90 @@
+/**
+ * @file ThreadTeam.h
+ * @brief A fixed team of threads that run a function on their part of the
+ * work, pass after pass, without starting threads at every pass
+ *
+ * For iterative methods whose passes are short (a subgradient step, a
+ * round of local search): the threads wait on a condition variable between
+ * passes, and the calling thread does part 0.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef THREADTEAM_H
+#define THREADTEAM_H
+
+#include<vector>
+#include<functional>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+
+/// Usage:
+///   ThreadTeam team(size);
+///   while ( ... ) team.run([&](unsigned part) { ... });
+class ThreadTeam {
+public:
+  explicit ThreadTeam( unsigned size ):
+    my_part( 0 ), my_pass( 0 ), my_pending( 0 ), my_stop( false )
+  {
+    for ( unsigned p = 1; p < size; ++p ) {
+      my_threads.push_back( std::thread( &ThreadTeam::work, this, p ) );
+    }
+  }
+
+  ~ThreadTeam() {
+    {
+      std::lock_guard<std::mutex> guard( my_lock );
+      my_stop = true;
+    }
+    my_wake.notify_all();
+    for ( size_t t = 0; t < my_threads.size(); ++t ) my_threads[t].join();
+  }
+
+  unsigned size() const { return my_threads.size() + 1; }
+
+  /// calls part(p) for every part p, returns when all are done
+  void run( const std::function<void (unsigned)> & part ) {
+    {
+      std::lock_guard<std::mutex> guard( my_lock );
+      my_part = &part;
+      my_pending = my_threads.size();
+      ++my_pass;
+    }
+    my_wake.notify_all();
+    part( 0 );
+    std::unique_lock<std::mutex> guard( my_lock );
+    my_done.wait( guard, [this]() { return my_pending == 0; } );
+  }
+
+private:
+  void work( unsigned p ) {
+    unsigned long pass_done = 0;
+    while ( true ) {
+      const std::function<void (unsigned)> * part;
+      {
+        std::unique_lock<std::mutex> guard( my_lock );
+        my_wake.wait( guard, [&]() { return my_stop || my_pass != pass_done; } );
+        if ( my_stop ) return;
+        pass_done = my_pass;
+        part = my_part;
+      }
+      (*part)( p );
+      std::lock_guard<std::mutex> guard( my_lock );
+      if ( --my_pending == 0 ) my_done.notify_one();
+    }
+  }
+
+  std::vector<std::thread> my_threads;
+  std::mutex my_lock;
+  std::condition_variable my_wake;
+  std::condition_variable my_done;
+  const std::function<void (unsigned)> * my_part;
+  unsigned long my_pass;
+  size_t my_pending;
+  bool my_stop;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:40:05 GMT]
@@ -0,0 +1,93 @@
+/// @file TransitivityCallback.cpp
+/// @brief adding back the 3-cycle rows left out by -lazy_transitivity
+
+#include "TransitivityCallback.h"
+#include "CplexLoader.h"
+
+ILOSTLBEGIN
+
+/// violation that counts for a lazy constraint, as CPLEX's default
+/// feasibility tolerance
+static const double LAZY_TOLERANCE = 1e-6;
+
+/// violation that counts for a user cut: smaller ones hardly move the bound
+static const double CUT_TOLERANCE = 1e-3;
+
+/// rows added per call, at most; a cut round is kept small so that the
+/// LP doesn't grow faster than it helps
+static const size_t MAX_LAZY_PER_CALL = 1000;
+static const size_t MAX_CUTS_PER_CALL = 100;
+
+/// copies values into a vector
+static vector<double> to_vector( IloNumArray values )
+{
+  vector<double> x( values.getSize() );
+  for ( IloInt j = 0; j < values.getSize(); ++j ) x[j] = values[j];
+  values.end();
+  return x;
+}
+
+void
+TransitivityLazyCallbackI::main()
+{
+  IloNumArray values( getEnv() );
+  getValues( values, my_var );
+  vector<double> x = to_vector( values );
+  vector<int> rows;
+  my_separator->separate( x, LAZY_TOLERANCE, MAX_LAZY_PER_CALL, true, rows );
+  for ( size_t r = 0; r < rows.size(); ++r ) {
+    add( rowRange( getEnv(), my_lp_model, rows[r], my_var ) ).end();
+  }
+}
+
+IloCplex::CallbackI *
+TransitivityLazyCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) TransitivityLazyCallbackI( *this ));
+}
+
+void
+TransitivityCutCallbackI::main()
+{
+  // separate only during the cut loop, not once it is over for the node
+  if ( isAfterCutLoop() ) return;
+  IloNumArray values( getEnv() );
+  getValues( values, my_var );
+  vector<double> x = to_vector( values );
+  vector<int> rows;
+  my_separator->separate( x, CUT_TOLERANCE, MAX_CUTS_PER_CALL, false, rows );
+  for ( size_t r = 0; r < rows.size(); ++r ) {
+    add( rowRange( getEnv(), my_lp_model, rows[r], my_var ),
+         IloCplex::UseCutPurge ).end();
+  }
+}
+
+IloCplex::CallbackI *
+TransitivityCutCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) TransitivityCutCallbackI( *this ));
+}
+
+IloCplex::Callback
+transitivityLazyCallback( IloEnv env, const LpModel & lp_model,
+                          const IloNumVarArray var,
+                          TransitivitySeparator * separator )
+{
+  return IloCplex::Callback( new (env) TransitivityLazyCallbackI( env,
+                                                                  lp_model,
+                                                                  var,
+                                                                  separator ) );
+}
+
+IloCplex::Callback
+transitivityCutCallback( IloEnv env, const LpModel & lp_model,
+                         const IloNumVarArray var,
+                         TransitivitySeparator * separator )
+{
+  return IloCplex::Callback( new (env) TransitivityCutCallbackI( env,
+                                                                 lp_model,
+                                                                 var,
+                                                                 separator ) );
+}
+
+//  [Last modified: 2026 10 18 at 09:33:05 GMT]
@@ -0,0 +1,69 @@
+/**
+ * @file TransitivityCallback.h
+ * @brief Lazy constraint and user cut callbacks that add back the 3-cycle
+ * rows of ordering models a TransitivitySeparator left out
+ * (-lazy_transitivity)
+ *
+ * The lazy constraint callback keeps integer solutions transitive; the
+ * user cut callback adds the rows most violated by fractional solutions,
+ * so that the LP bound stays as strong as with all rows loaded. The rows
+ * are added as the model has them. Lazy constraints are global; user cuts
+ * may be purged again by CPLEX.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef TRANSITIVITYCALLBACK_H
+#define TRANSITIVITYCALLBACK_H
+
+#include <ilcplex/ilocplex.h>
+#include "LpModel.h"
+#include "TransitivitySeparator.h"
+
+class TransitivityLazyCallbackI: public IloCplex::LazyConstraintCallbackI {
+public:
+  TransitivityLazyCallbackI( IloEnv env, const LpModel & lp_model,
+                             const IloNumVarArray var,
+                             TransitivitySeparator * separator ):
+    IloCplex::LazyConstraintCallbackI( env ), my_lp_model( lp_model ),
+    my_var( var ), my_separator( separator ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  const LpModel & my_lp_model;
+  IloNumVarArray my_var;
+  TransitivitySeparator * my_separator;
+};
+
+class TransitivityCutCallbackI: public IloCplex::UserCutCallbackI {
+public:
+  TransitivityCutCallbackI( IloEnv env, const LpModel & lp_model,
+                            const IloNumVarArray var,
+                            TransitivitySeparator * separator ):
+    IloCplex::UserCutCallbackI( env ), my_lp_model( lp_model ),
+    my_var( var ), my_separator( separator ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  const LpModel & my_lp_model;
+  IloNumVarArray my_var;
+  TransitivitySeparator * my_separator;
+};
+
+/// @return a callback for IloCplex::use() that adds the left out rows of
+/// lp_model an integer solution violates (var are its columns)
+IloCplex::Callback transitivityLazyCallback( IloEnv env,
+                                             const LpModel & lp_model,
+                                             const IloNumVarArray var,
+                                             TransitivitySeparator * separator );
+
+/// @return a callback for IloCplex::use() that adds the left out rows most
+/// violated by fractional solutions
+IloCplex::Callback transitivityCutCallback( IloEnv env,
+                                            const LpModel & lp_model,
+                                            const IloNumVarArray var,
+                                            TransitivitySeparator * separator );
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:05:40 GMT]
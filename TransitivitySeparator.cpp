@@ -0,0 +1,221 @@
+/// @file TransitivitySeparator.cpp
+/// @brief layers of ordering variables and separation of their
+/// transitivity rows
+
+#include"TransitivitySeparator.h"
+#include"DisjointSets.h"
+#include"ClockTimer.h"
+#include<algorithm>
+#include<cstdlib>
+#include<map>
+#include<utility>
+
+/// @return true if name is x_I_J for integers I and J, which are put in i
+/// and j
+static bool ordering_name( const std::string & name, long & i, long & j )
+{
+  if ( name.size() < 5 || name[0] != 'x' || name[1] != '_' ) return false;
+  const char * start = name.c_str() + 2;
+  char * end;
+  i = std::strtol( start, &end, 10 );
+  if ( end == start || *end != '_' ) return false;
+  start = end + 1;
+  j = std::strtol( start, &end, 10 );
+  return end != start && *end == '\0' && i != j;
+}
+
+/// compares rows by their violation, most violated first
+struct MoreViolated {
+  const std::vector<double> & violation;
+  explicit MoreViolated( const std::vector<double> & v ): violation( v ) {}
+  bool operator()( int a, int b ) const { return violation[a] > violation[b]; }
+};
+
+TransitivitySeparator::TransitivitySeparator( const LpModel & model ):
+  my_model( model ),
+  my_ordering_columns( 0 ),
+  my_triples( 0 ),
+  my_number_of_rows( 0 ),
+  my_separations( 0 ),
+  my_lazy_rows( 0 ),
+  my_user_rows( 0 ),
+  my_separation_time( 0 )
+{
+}
+
+bool
+TransitivitySeparator::detect()
+{
+  const int number_of_columns = my_model.numberOfColumns();
+  std::map< std::pair<long, long>, int > column_of_arc;
+  for ( int j = 0; j < number_of_columns; ++j ) {
+    long from, to;
+    if ( ordering_name( my_model.columnName( j ), from, to ) ) {
+      column_of_arc[ std::make_pair( from, to ) ] = j;
+    }
+  }
+
+  // nodes with an arc both ways, numbered in order, and their layers
+  std::map<long, int> node_index;
+  std::vector< std::pair<long, long> > pairs;
+  for ( std::map< std::pair<long, long>, int >::const_iterator arc
+          = column_of_arc.begin(); arc != column_of_arc.end(); ++arc ) {
+    long from = arc->first.first;
+    long to = arc->first.second;
+    if ( from > to || column_of_arc.count( std::make_pair( to, from ) ) == 0 ) {
+      continue;
+    }
+    if ( node_index.count( from ) == 0 ) {
+      int index = node_index.size();
+      node_index[from] = index;
+    }
+    if ( node_index.count( to ) == 0 ) {
+      int index = node_index.size();
+      node_index[to] = index;
+    }
+    pairs.push_back( std::make_pair( from, to ) );
+  }
+  const int number_of_nodes = node_index.size();
+  DisjointSets components( number_of_nodes );
+  for ( size_t p = 0; p < pairs.size(); ++p ) {
+    components.unite( node_index[ pairs[p].first ],
+                      node_index[ pairs[p].second ] );
+  }
+  std::vector<int> layer_of_root( number_of_nodes, -1 );
+  std::vector<int> layer( number_of_nodes );
+  my_layers.clear();
+  for ( int v = 0; v < number_of_nodes; ++v ) {
+    int root = components.find( v );
+    if ( layer_of_root[root] < 0 ) {
+      layer_of_root[root] = my_layers.size();
+      my_layers.push_back( 0 );
+    }
+    layer[v] = layer_of_root[root];
+    ++my_layers[ layer[v] ];
+  }
+  my_triples = 0;
+  for ( size_t l = 0; l < my_layers.size(); ++l ) {
+    long m = my_layers[l];
+    my_triples += m * (m - 1) * (m - 2) / 6;
+  }
+
+  // the arc of each ordering column, as nodes
+  std::vector< std::pair<int, int> > arc_of_column( number_of_columns,
+                                                    std::make_pair( -1, -1 ) );
+  my_ordering_columns = 0;
+  for ( size_t p = 0; p < pairs.size(); ++p ) {
+    long from = pairs[p].first;
+    long to = pairs[p].second;
+    int u = node_index[from];
+    int v = node_index[to];
+    int forward = column_of_arc[ std::make_pair( from, to ) ];
+    int backward = column_of_arc[ std::make_pair( to, from ) ];
+    arc_of_column[forward] = std::make_pair( u, v );
+    arc_of_column[backward] = std::make_pair( v, u );
+    my_ordering_columns += 2;
+  }
+
+  // rows x_a_c - x_a_b - x_b_c >= -1, or x_a_b + x_b_c + x_c_a <= 2
+  const int number_of_rows = my_model.numberOfRows();
+  const std::vector<int> & row_columns = my_model.rowColumns();
+  const std::vector<double> & row_values = my_model.rowValues();
+  my_transitivity_rows.assign( number_of_rows, 0 );
+  my_number_of_rows = 0;
+  my_rows.clear();
+  my_row_columns.clear();
+  my_row_coefficients.clear();
+  my_row_bounds.clear();
+  for ( int i = 0; i < number_of_rows; ++i ) {
+    int begin = my_model.rowBegin( i );
+    if ( my_model.rowEnd( i ) - begin != 3 ) continue;
+    std::pair<int, int> arcs[3];
+    bool ordering = true;
+    for ( int t = 0; t < 3; ++t ) {
+      arcs[t] = arc_of_column[ row_columns[begin + t] ];
+      ordering = ordering && arcs[t].first >= 0;
+    }
+    if ( ! ordering ) continue;
+    bool cycle = false;
+    if ( my_model.rowSense( i ) == LpModel::GREATER_EQUAL
+         && my_model.rightHandSide( i ) == -1 ) {
+      for ( int t = 0; t < 3 && ! cycle; ++t ) {
+        // arcs[t] is a->c, the others a->b and b->c in either order
+        const std::pair<int, int> & ac = arcs[t];
+        const std::pair<int, int> & other1 = arcs[(t + 1) % 3];
+        const std::pair<int, int> & other2 = arcs[(t + 2) % 3];
+        if ( row_values[begin + t] != 1 || row_values[begin + (t + 1) % 3] != -1
+             || row_values[begin + (t + 2) % 3] != -1 ) {
+          continue;
+        }
+        cycle = ( other1.first == ac.first && other1.second == other2.first
+                  && other2.second == ac.second )
+          || ( other2.first == ac.first && other2.second == other1.first
+               && other1.second == ac.second );
+      }
+    }
+    else if ( my_model.rowSense( i ) == LpModel::LESS_EQUAL
+              && my_model.rightHandSide( i ) == 2
+              && row_values[begin] == 1 && row_values[begin + 1] == 1
+              && row_values[begin + 2] == 1 ) {
+      cycle = ( arcs[0].second == arcs[1].first
+                && arcs[1].second == arcs[2].first
+                && arcs[2].second == arcs[0].first )
+        || ( arcs[0].second == arcs[2].first
+             && arcs[2].second == arcs[1].first
+             && arcs[1].second == arcs[0].first );
+    }
+    if ( ! cycle ) continue;
+    my_transitivity_rows[i] = 1;
+    ++my_number_of_rows;
+    // kept as a <= row
+    double sign = my_model.rowSense( i ) == LpModel::GREATER_EQUAL ? -1 : 1;
+    my_rows.push_back( i );
+    for ( int t = 0; t < 3; ++t ) {
+      my_row_columns.push_back( row_columns[begin + t] );
+      my_row_coefficients.push_back( sign * row_values[begin + t] );
+    }
+    my_row_bounds.push_back( sign * my_model.rightHandSide( i ) );
+  }
+  return my_number_of_rows > 0;
+}
+
+size_t
+TransitivitySeparator::separate( const std::vector<double> & x,
+                                 double tolerance, size_t limit, bool lazy,
+                                 std::vector<int> & rows )
+{
+  double start_time = ClockTimer::wallClock();
+  rows.clear();
+  const int n = my_rows.size();
+  std::vector<double> violation( n );
+  const int * columns = my_row_columns.empty() ? 0 : &my_row_columns[0];
+  const double * coefficients
+    = my_row_coefficients.empty() ? 0 : &my_row_coefficients[0];
+  for ( int r = 0; r < n; ++r ) {
+    violation[r] = coefficients[3 * r] * x[ columns[3 * r] ]
+      + coefficients[3 * r + 1] * x[ columns[3 * r + 1] ]
+      + coefficients[3 * r + 2] * x[ columns[3 * r + 2] ]
+      - my_row_bounds[r];
+  }
+  std::vector<int> violated;
+  for ( int r = 0; r < n; ++r ) {
+    if ( violation[r] > tolerance ) violated.push_back( r );
+  }
+  if ( limit > 0 && violated.size() > limit ) {
+    std::partial_sort( violated.begin(), violated.begin() + limit,
+                       violated.end(), MoreViolated( violation ) );
+    violated.resize( limit );
+  }
+  for ( size_t k = 0; k < violated.size(); ++k ) {
+    rows.push_back( my_rows[ violated[k] ] );
+  }
+
+  std::lock_guard<std::mutex> guard( my_lock );
+  ++my_separations;
+  if ( lazy ) my_lazy_rows += rows.size();
+  else my_user_rows += rows.size();
+  my_separation_time += ClockTimer::wallClock() - start_time;
+  return rows.size();
+}
+
+//  [Last modified: 2026 10 18 at 07:05:40 GMT]
@@ -0,0 +1,92 @@
+/**
+ * @file TransitivitySeparator.h
+ * @brief Ordering variables of a linear ordering model, such as the
+ * crossing minimization (pyramid) models, and separation of the 3-cycle
+ * inequalities that make the orders transitive (-lazy_transitivity)
+ *
+ * Columns x_i_j and x_j_i (i, j integers), both present, order nodes i and
+ * j: x_i_j = 1 if i precedes j. The nodes that are ordered against each
+ * other this way form the layers (the connected components of the pairs).
+ * An order on a layer is transitive if it has no 3-cycle; the models say
+ * so with two rows per triple of nodes, x_a_c - x_a_b - x_b_c >= -1 (or
+ * x_a_b + x_b_c + x_c_a <= 2). Those rows are recognized so that they can
+ * be left out of the model and added back when violated.
+ *
+ * Only the rows that are in the model are separated, as they are written:
+ * a cycle inequality is valid only where the model makes it so (e.g., with
+ * x_a_c + x_c_a = 1), which is not for the separator to assume. The rows
+ * left out have three terms each and are kept in flat arrays, columns and
+ * coefficients side by side, so that a scan is one pass over them.
+ *
+ * @date 2026/10/18
+ */
+
+#ifndef TRANSITIVITYSEPARATOR_H
+#define TRANSITIVITYSEPARATOR_H
+
+#include<vector>
+#include<mutex>
+#include<cstddef>
+#include"LpModel.h"
+
+/// Usage:
+///   TransitivitySeparator separator( model );
+///   if ( separator.detect() ) {
+///     ... load the rows i without separator.transitivityRows()[i]
+///     at each candidate x: separator.separate( x, tolerance, limit, lazy,
+///       rows ), and add the rows of the model listed in rows
+///   }
+class TransitivitySeparator {
+public:
+  explicit TransitivitySeparator( const LpModel & model );
+
+  /// finds the ordering columns, the layers and the transitivity rows
+  /// @return true if there is a transitivity row to leave out
+  bool detect();
+
+  int numberOfLayers() const { return my_layers.size(); }
+  int orderingColumns() const { return my_ordering_columns; }
+  /// triples of nodes on the same layer
+  long triples() const { return my_triples; }
+  /// per row, nonzero if it is a 3-cycle inequality
+  const std::vector<char> & transitivityRows() const {
+    return my_transitivity_rows;
+  }
+  int numberOfTransitivityRows() const { return my_number_of_rows; }
+
+  /// finds the transitivity rows x (a value per column) violates by more
+  /// than tolerance, the limit most violated of them (0 = all); lazy says
+  /// whether they are for a lazy constraint or a user cut (for the counts)
+  /// @return the number of rows found, whose indices are put in rows
+  size_t separate( const std::vector<double> & x, double tolerance,
+                   size_t limit, bool lazy, std::vector<int> & rows );
+
+  long separations() const { return my_separations; }
+  long lazyRows() const { return my_lazy_rows; }
+  long userRows() const { return my_user_rows; }
+  double separationTime() const { return my_separation_time; }
+
+private:
+  const LpModel & my_model;
+  std::vector<int> my_layers;                   // nodes of each layer
+  int my_ordering_columns;
+  long my_triples;
+  std::vector<char> my_transitivity_rows;
+  int my_number_of_rows;
+  // the rows left out, as sum of coefficients x <= bound: index, and three
+  // columns and coefficients each
+  std::vector<int> my_rows;
+  std::vector<int> my_row_columns;
+  std::vector<double> my_row_coefficients;
+  std::vector<double> my_row_bounds;
+
+  std::mutex my_lock;
+  long my_separations;
+  long my_lazy_rows;
+  long my_user_rows;
+  double my_separation_time;
+};
+
+#endif
+
+//  [Last modified: 2026 10 18 at 07:05:40 GMT]
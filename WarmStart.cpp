@@ -0,0 +1,267 @@
+/// @file WarmStart.cpp
+/// @brief MIP starts from solution files and solution files from solves
+
+#include "WarmStart.h"
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+
+/// @return value rounded to the nearest integer if the variable is
+/// integer (CPLEX reports values such as 0.9999999 for those)
+static double clean_value( double value, bool integer )
+{
+  return integer ? std::floor( value + 0.5 ) : value;
+}
+
+static bool is_integer( const IloNumVar variable )
+{
+  return variable.getType() == ILOBOOL || variable.getType() == ILOINT;
+}
+
+StoredSolution
+makeSolution( const IloNumVarArray var, const IloNumArray values,
+              double value )
+{
+  StoredSolution solution;
+  solution.has_value = true;
+  solution.value = value;
+  for ( IloInt j = 0; j < var.getSize(); ++j ) {
+    const char * name = var[j].getName();
+    if ( ! name ) continue;
+    solution.values.push_back( std::make_pair( std::string( name ),
+                                               clean_value( values[j],
+                                                            is_integer( var[j] ) ) ) );
+  }
+  return solution;
+}
+
+int
+addMipStarts( IloEnv env, IloCplex cplex, const IloNumVarArray var,
+              const SolutionFile & solutions, size_t & unknown_names )
+{
+  std::map<std::string, IloInt> index;
+  for ( IloInt j = 0; j < var.getSize(); ++j ) {
+    if ( var[j].getName() ) index[ var[j].getName() ] = j;
+  }
+  unknown_names = 0;
+  int added = 0;
+  IloNumVarArray start_vars( env );
+  IloNumArray start_values( env );
+  for ( size_t s = 0; s < solutions.numberOfSolutions(); ++s ) {
+    const StoredSolution & solution = solutions.solution( s );
+    start_vars.clear();
+    start_values.clear();
+    for ( size_t i = 0; i < solution.values.size(); ++i ) {
+      std::map<std::string, IloInt>::const_iterator variable
+        = index.find( solution.values[i].first );
+      if ( variable == index.end() ) {
+        ++unknown_names;
+        continue;
+      }
+      start_vars.add( var[ variable->second ] );
+      start_values.add( solution.values[i].second );
+    }
+    if ( start_vars.getSize() == 0 ) continue;
+    cplex.addMIPStart( start_vars, start_values );
+    ++added;
+  }
+  start_vars.end();
+  start_values.end();
+  return added;
+}
+
+void
+storeSolutions( IloEnv env, IloCplex cplex, const IloNumVarArray var,
+                bool minimize, size_t max_solutions, SolutionFile & solutions )
+{
+  solutions.clear();
+  IloNumArray values( env );
+  int pool_size = cplex.isMIP() ? cplex.getSolnPoolNsolns() : 0;
+  if ( pool_size == 0 ) {
+    cplex.getValues( values, var );
+    solutions.add( makeSolution( var, values, cplex.getObjValue() ) );
+    values.end();
+    return;
+  }
+  std::vector< std::pair<double, int> > order;
+  for ( int i = 0; i < pool_size; ++i ) {
+    double value = cplex.getObjValue( i );
+    order.push_back( std::make_pair( minimize ? value : -value, i ) );
+  }
+  std::sort( order.begin(), order.end() );
+  for ( size_t k = 0; k < order.size() && k < max_solutions; ++k ) {
+    int i = order[k].second;
+    cplex.getValues( values, var, i );
+    solutions.add( makeSolution( var, values, cplex.getObjValue( i ) ) );
+  }
+  values.end();
+}
+
+IncumbentSaver::IncumbentSaver( const std::string & file_name,
+                                const IloNumVarArray var, bool minimize ):
+  my_file_name( file_name ),
+  my_minimize( minimize ),
+  my_has_value( false ),
+  my_value( 0 ),
+  my_saved( 0 )
+{
+  for ( IloInt j = 0; j < var.getSize(); ++j ) {
+    const char * name = var[j].getName();
+    my_names.push_back( name ? name : "" );
+    my_integer.push_back( is_integer( var[j] ) );
+  }
+}
+
+bool
+IncumbentSaver::improves( double value )
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  return ! my_has_value || (my_minimize ? value < my_value : value > my_value);
+}
+
+void
+IncumbentSaver::save( double value, const IloNumArray values )
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  if ( my_has_value && ! (my_minimize ? value < my_value : value > my_value) ) {
+    return;
+  }
+  StoredSolution solution;
+  solution.has_value = true;
+  solution.value = value;
+  for ( size_t j = 0; j < my_names.size(); ++j ) {
+    if ( my_names[j].empty() ) continue;
+    solution.values.push_back( std::make_pair( my_names[j],
+                                               clean_value( values[j],
+                                                            my_integer[j] ) ) );
+  }
+  SolutionFile file;
+  file.add( solution );
+  if ( ! file.write( my_file_name ) ) {
+    my_error_message = file.errorMessage();
+    return;
+  }
+  my_has_value = true;
+  my_value = value;
+  ++my_saved;
+}
+
+void
+IncumbentSaverCallbackI::main()
+{
+  if ( ! hasIncumbent() ) return;
+  double value = getIncumbentObjValue();
+  if ( ! my_saver->improves( value ) ) return;
+  IloNumArray values( getEnv() );
+  getIncumbentValues( values, my_var );
+  my_saver->save( value, values );
+  values.end();
+}
+
+IloCplex::CallbackI *
+IncumbentSaverCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) IncumbentSaverCallbackI( *this ));
+}
+
+IloCplex::Callback
+incumbentSaverCallback( IloEnv env, const IloNumVarArray var,
+                        IncumbentSaver * saver )
+{
+  return IloCplex::Callback( new (env) IncumbentSaverCallbackI( env, var,
+                                                                saver ) );
+}
+
+/// set by the signal handler; a plain flag, since that's all a handler
+/// may safely touch
+static volatile sig_atomic_t signal_caught = 0;
+
+static void catch_signal( int )
+{
+  signal_caught = 1;
+}
+
+Checkpointer::Checkpointer( const std::string & file_name, double interval,
+                            const Checkpoint & previous ):
+  my_file_name( file_name ),
+  my_interval( interval ),
+  my_previous( previous ),
+  my_last( previous ),
+  my_next_due( interval ),
+  my_written( 0 )
+{
+}
+
+bool
+Checkpointer::due( double elapsed ) const
+{
+  return elapsed >= my_next_due.load( std::memory_order_relaxed );
+}
+
+void
+Checkpointer::save( double elapsed, int64_t nodes, bool has_bound,
+                    double bound, bool proved_optimal,
+                    const SolutionFile & solutions )
+{
+  std::lock_guard<std::mutex> guard( my_mutex );
+  my_next_due = elapsed + my_interval;
+  Checkpoint next = my_previous.advance( elapsed, nodes, has_bound, bound,
+                                         proved_optimal, solutions,
+                                         SOLUTIONS_KEPT );
+  if ( ! next.write( my_file_name ) ) {
+    my_error_message = next.errorMessage();
+    return;
+  }
+  my_last = next;
+  ++my_written;
+}
+
+void
+Checkpointer::catchSignals()
+{
+  signal( SIGTERM, catch_signal );
+  signal( SIGUSR1, catch_signal );
+}
+
+bool
+Checkpointer::interrupted()
+{
+  return signal_caught != 0;
+}
+
+void
+CheckpointCallbackI::main()
+{
+  if ( Checkpointer::interrupted() ) {
+    abort();
+    return;
+  }
+  double elapsed = getCplexTime() - getStartTime();
+  if ( ! my_checkpointer->due( elapsed ) ) return;
+  SolutionFile solutions;
+  if ( hasIncumbent() ) {
+    IloNumArray values( getEnv() );
+    getIncumbentValues( values, my_var );
+    solutions.add( makeSolution( my_var, values, getIncumbentObjValue() ) );
+    values.end();
+  }
+  my_checkpointer->save( elapsed, getNnodes(), true, getBestObjValue(), false,
+                         solutions );
+}
+
+IloCplex::CallbackI *
+CheckpointCallbackI::duplicateCallback() const
+{
+  return (new (getEnv()) CheckpointCallbackI( *this ));
+}
+
+IloCplex::Callback
+checkpointCallback( IloEnv env, const IloNumVarArray var,
+                    Checkpointer * checkpointer )
+{
+  return IloCplex::Callback( new (env) CheckpointCallbackI( env, var,
+                                                            checkpointer ) );
+}
+
+//  [Last modified: 2026 10 17 at 20:31:40 GMT]
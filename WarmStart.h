@@ -0,0 +1,161 @@
+/**
+ * @file WarmStart.h
+ * @brief Solutions carried from one run to the next: solution files are
+ * added to IloCplex as MIP starts (-mipstart=FILE), and the best
+ * solutions of a run are written to a solution file (-write_sol=FILE)
+ *
+ * While the solve runs, an informational callback rewrites the file each
+ * time the incumbent improves, so that a run that crashes or is killed
+ * still leaves its best solution behind; at the end the file is replaced
+ * by the best solutions in the solution pool.
+ *
+ * A Checkpointer does the same for a Checkpoint (-checkpoint=PATH): it is
+ * written every so often during the solve and once more at the end.
+ * SIGTERM and SIGUSR1 (what batch systems send before preempting or
+ * killing a job) stop the solve, so that the last checkpoint is written
+ * before the process exits.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef WARMSTART_H
+#define WARMSTART_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ilcplex/ilocplex.h>
+#include "SolutionFile.h"
+#include "Checkpoint.h"
+
+/// Adds each solution of solutions as a MIP start for var (matched by
+/// name; the starts may be partial, CPLEX completes them).
+/// @return the number of starts added; unknown_names is the number of
+/// names that do not belong to any variable
+int addMipStarts( IloEnv env, IloCplex cplex, const IloNumVarArray var,
+                  const SolutionFile & solutions, size_t & unknown_names );
+
+/// @return the named variables of var with the given values; values of
+/// integer variables are rounded
+StoredSolution makeSolution( const IloNumVarArray var,
+                             const IloNumArray values, double value );
+
+/// Replaces the contents of solutions with the best (at most
+/// max_solutions) solutions of the pool after a solve, best first, or with
+/// the single solution of an LP.
+void storeSolutions( IloEnv env, IloCplex cplex, const IloNumVarArray var,
+                     bool minimize, size_t max_solutions,
+                     SolutionFile & solutions );
+
+/// Usage:
+///   IncumbentSaver saver(file_name, var, minimize);
+///   cplex.use(incumbentSaverCallback(env, var, &saver));
+///   ... solve ...  saver.numberSaved(), saver.errorMessage()
+class IncumbentSaver {
+public:
+  IncumbentSaver( const std::string & file_name, const IloNumVarArray var,
+                  bool minimize );
+
+  /// @return true if value is better than the last solution saved
+  bool improves( double value );
+  /// writes the solution with the given values of var (in order) unless a
+  /// better one has been saved in the meantime (thread safe)
+  void save( double value, const IloNumArray values );
+
+  int numberSaved() const { return my_saved; }
+  /// the last write error, if any
+  const std::string & errorMessage() const { return my_error_message; }
+
+private:
+  std::mutex my_mutex;
+  std::string my_file_name;
+  std::vector<std::string> my_names;
+  std::vector<bool> my_integer;
+  bool my_minimize;
+  bool my_has_value;
+  double my_value;
+  int my_saved;
+  std::string my_error_message;
+};
+
+class IncumbentSaverCallbackI: public IloCplex::MIPInfoCallbackI {
+public:
+  IncumbentSaverCallbackI( IloEnv env, const IloNumVarArray var,
+                           IncumbentSaver * saver ):
+    IloCplex::MIPInfoCallbackI( env ), my_var( var ), my_saver( saver ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  IloNumVarArray my_var;
+  IncumbentSaver * my_saver;
+};
+
+/// @return a callback for IloCplex::use() that saves improving incumbents
+IloCplex::Callback incumbentSaverCallback( IloEnv env,
+                                           const IloNumVarArray var,
+                                           IncumbentSaver * saver );
+
+/// Usage:
+///   Checkpointer checkpointer(file_name, interval, previous);
+///   cplex.use(checkpointCallback(env, var, &checkpointer));
+///   Checkpointer::catchSignals();
+///   ... solve ...
+///   checkpointer.save(elapsed, nodes, ..., pool_solutions);
+class Checkpointer {
+public:
+  /// solutions kept in a checkpoint
+  static const size_t SOLUTIONS_KEPT = 10;
+
+  /// previous is the checkpoint of the earlier runs (empty if none)
+  Checkpointer( const std::string & file_name, double interval,
+                const Checkpoint & previous );
+
+  /// @return true if interval seconds have passed since the last save
+  bool due( double elapsed ) const;
+  /// writes previous advanced by this run so far (thread safe)
+  void save( double elapsed, int64_t nodes, bool has_bound, double bound,
+             bool proved_optimal, const SolutionFile & solutions );
+
+  /// the checkpoint as last written (or previous)
+  const Checkpoint & last() const { return my_last; }
+  int numberWritten() const { return my_written; }
+  const std::string & errorMessage() const { return my_error_message; }
+
+  /// from now on, SIGTERM and SIGUSR1 make interrupted() true
+  static void catchSignals();
+  static bool interrupted();
+
+private:
+  std::mutex my_mutex;
+  std::string my_file_name;
+  double my_interval;
+  Checkpoint my_previous;
+  Checkpoint my_last;
+  std::atomic<double> my_next_due;
+  int my_written;
+  std::string my_error_message;
+};
+
+/// saves a checkpoint when one is due and stops the solve when a signal
+/// has been caught
+class CheckpointCallbackI: public IloCplex::MIPInfoCallbackI {
+public:
+  CheckpointCallbackI( IloEnv env, const IloNumVarArray var,
+                       Checkpointer * checkpointer ):
+    IloCplex::MIPInfoCallbackI( env ), my_var( var ),
+    my_checkpointer( checkpointer ) {}
+  virtual void main();
+  virtual IloCplex::CallbackI * duplicateCallback() const;
+private:
+  IloNumVarArray my_var;
+  Checkpointer * my_checkpointer;
+};
+
+/// @return a callback for IloCplex::use() that feeds checkpointer
+IloCplex::Callback checkpointCallback( IloEnv env, const IloNumVarArray var,
+                                       Checkpointer * checkpointer );
+
+#endif
+
+//  [Last modified: 2026 10 17 at 20:31:40 GMT]
@@ -0,0 +1,78 @@
+/// @file WorkStealingPool.cpp
+/// @brief implementation of the work-stealing task pool
+
+#include"WorkStealingPool.h"
+#include<thread>
+
+WorkStealingPool::WorkStealingPool( unsigned number_of_workers ):
+  my_tasks_stolen( 0 )
+{
+  if ( number_of_workers == 0 ) number_of_workers = 1;
+  for ( unsigned w = 0; w < number_of_workers; ++w ) {
+    my_queues.push_back( std::unique_ptr<TaskQueue>( new TaskQueue ) );
+  }
+}
+
+void
+WorkStealingPool::addTask( unsigned worker, size_t task )
+{
+  TaskQueue & queue = *my_queues[ worker % my_queues.size() ];
+  std::lock_guard<std::mutex> guard( queue.lock );
+  // tasks are taken from the back by their owner, so the first task added
+  // goes to the back
+  queue.tasks.push_front( task );
+}
+
+bool
+WorkStealingPool::takeOwnTask( unsigned worker, size_t & task )
+{
+  TaskQueue & queue = *my_queues[worker];
+  std::lock_guard<std::mutex> guard( queue.lock );
+  if ( queue.tasks.empty() ) return false;
+  task = queue.tasks.back();
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool
+WorkStealingPool::stealTask( unsigned thief, size_t & task )
+{
+  const unsigned workers = my_queues.size();
+  for ( unsigned offset = 1; offset < workers; ++offset ) {
+    TaskQueue & queue = *my_queues[ (thief + offset) % workers ];
+    std::lock_guard<std::mutex> guard( queue.lock );
+    if ( ! queue.tasks.empty() ) {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      ++my_tasks_stolen;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+WorkStealingPool::work( unsigned worker, TaskFunction * task_function )
+{
+  size_t task;
+  // no tasks are added while running, so a worker that finds every queue
+  // empty is done
+  while ( takeOwnTask( worker, task ) || stealTask( worker, task ) ) {
+    (*task_function)( worker, task );
+  }
+}
+
+void
+WorkStealingPool::run( TaskFunction task_function )
+{
+  std::vector<std::thread> threads;
+  for ( unsigned w = 1; w < my_queues.size(); ++w ) {
+    threads.push_back( std::thread( &WorkStealingPool::work, this, w,
+                                    &task_function ) );
+  }
+  // the calling thread is worker 0
+  work( 0, &task_function );
+  for ( size_t t = 0; t < threads.size(); ++t ) threads[t].join();
+}
+
+//  [Last modified: 2026 10 17 at 17:22:03 GMT]
@@ -0,0 +1,60 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Runs a fixed set of numbered tasks on a set of worker threads,
+ * each with its own queue; a worker that runs out of tasks steals from
+ * the other end of another worker's queue
+ *
+ * Tasks that share data (e.g., runs on the same instance) should be given
+ * to the same worker in consecutive order: the owner works through its
+ * queue from the back and thieves take from the front, so related tasks
+ * stay together for as long as possible.
+ *
+ * @date 2026/10/17
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include<cstddef>
+#include<deque>
+#include<vector>
+#include<mutex>
+#include<atomic>
+#include<functional>
+#include<memory>
+
+/// Usage:
+///   WorkStealingPool pool(number_of_workers);
+///   for each task t: pool.addTask(worker_for(t), t);
+///   pool.run([&](unsigned worker, size_t task) { ... });
+/// All tasks must be added before run(), which returns when every task
+/// has been done.
+class WorkStealingPool {
+public:
+  typedef std::function<void (unsigned worker, size_t task)> TaskFunction;
+
+  explicit WorkStealingPool( unsigned number_of_workers );
+
+  unsigned numberOfWorkers() const { return my_queues.size(); }
+  void addTask( unsigned worker, size_t task );
+  void run( TaskFunction task_function );
+  /// number of tasks done by a worker other than the one they were given to
+  size_t tasksStolen() const { return my_tasks_stolen; }
+
+private:
+  struct TaskQueue {
+    std::mutex lock;
+    std::deque<size_t> tasks;
+  };
+
+  bool takeOwnTask( unsigned worker, size_t & task );
+  bool stealTask( unsigned thief, size_t & task );
+  void work( unsigned worker, TaskFunction * task_function );
+
+  std::vector< std::unique_ptr<TaskQueue> > my_queues;
+  std::atomic<size_t> my_tasks_stolen;
+};
+
+#endif
+
+//  [Last modified: 2026 10 17 at 17:22:03 GMT]
@@ -24,14 +24,91 @@
 #include <iomanip>
 #include <sstream>
 #include <ctime>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <sys/resource.h>
 #include <ilcplex/ilocplex.h>
 #include "CmdLine.h"
 #include "ClockTimer.h"
+#include "LpModel.h"
+#include "LpParser.h"
+#include "CnfParser.h"
+#include "ModelCache.h"
+#include "CplexLoader.h"
+#include "Batch.h"
+#include "Sweep.h"
+#include "Portfolio.h"
+#include "RunReport.h"
+#include "ProgressTrace.h"
+#include "ProgressCallback.h"
+#include "ProgressMetrics.h"
+#include "PhaseProfiler.h"
+#include "SolvePhases.h"
+#include "WarmStart.h"
+#include "CoverReduction.h"
+#include "CoverHeuristic.h"
+#include "SolutionChecker.h"
+#include "ModelFeatures.h"
+#include "ParameterSelector.h"
+#include "ModelDecomposition.h"
+#include "Decompose.h"
+#include "SymmetryDetector.h"
+#include "CoverSolver.h"
+#include "LagrangianBound.h"
+#include "LazyRowPool.h"
+#include "LazyRowsCallback.h"
+#include "TransitivitySeparator.h"
+#include "TransitivityCallback.h"
+#include "ConflictGraph.h"
+#include "PackingCutSeparator.h"
+#include "PackingCutCallback.h"
+#include "RootLpRace.h"
 // #include "callback_test.h"
 
 ILOSTLBEGIN
 
 static void usage( const char *progname );
+static void emitReport( const CmdLine & command_line, const RunReport & report,
+                        const string input_file_string, ostream & out );
+static void printMetric( ostream & out, RunReport & report, const string tag,
+                         const string key, double value );
+static void printPhases( ostream & out, RunReport & report,
+                         const PhaseProfiler & profiler );
+static void emitError( ostream & out, RunReport & report,
+                       const CmdLine & command_line,
+                       const string input_file_string,
+                       PhaseProfiler & profiler, const string & message );
+static double checkTolerance( const CmdLine & command_line );
+static int badFlagValue( const CmdLine & command_line );
+static double peakMemoryMB();
+static void rootLpFeatures( IloEnv env, const LpModel & lp_model,
+                            ModelFeatures & features );
+static void printResult( ostream & out, RunReport & report,
+                         const string & status,
+                         const ClockTimer & runtime_timer, bool cpu_time,
+                         bool timed_out, bool solution_found,
+                         bool proved_optimal, double value );
+static void printCounts( ostream & out, RunReport & report, double cplex_time,
+                         long branches, long iterations, long frac_cuts,
+                         long clique_cuts, long cover_cuts );
+static void printRootLpRace( ostream & out, RunReport & report,
+                             const RootLpRace & race );
+static SolutionFile symmetricStarts( const SymmetryDetector & symmetry,
+                                     const LpModel & model,
+                                     const SolutionFile & starts );
+static void emitSolution( ostream & out, RunReport & report,
+                          const CmdLine & command_line, const LpModel & model,
+                          const vector<double> & values, double value,
+                          const string & input_file_string );
+static void printCheck( ostream & out, RunReport & report,
+                        const LpModel & model, const SolutionChecker & checker,
+                        bool has_reported_value, double reported_value );
+static int solveInstance( IloEnv env, const CmdLine & command_line,
+                          const string input_file_string,
+                          const LpModel * shared_model,
+                          PortfolioRacer * racer, ostream & out );
 
 #if 0 // couldn't figure out how to make callbacks work
 class CountFractionalCuts: public FractionalCutCallbackI {
@@ -62,6 +139,8 @@ const string getBasename(const string file_name) {
 int
 main (int argc, char **argv)
 {
+   ClockTimer args_timer = ClockTimer();
+   args_timer.start();
    IloEnv env;
 
    env.out() << "+++ cplex_ilp, release " << VERSION << ", " << RELEASE_DATE << " +++" << endl;
@@ -71,8 +150,11 @@ main (int argc, char **argv)
    // process the command line
    CmdLine command_line( argc, argv );
 
-   // correct number of file arguments?
-   if( command_line.numberOfFiles() != 1 ) {
+   // correct number of file arguments? (batch and sweep modes take any
+   // number)
+   if( ! command_line.flagPresent( "batch" )
+       && ! command_line.flagPresent( "sweep" )
+       && command_line.numberOfFiles() != 1 ) {
      cerr << "Should have exactly one file name on the command line." << endl;
      usage( argv[ 0 ] );
      exit( 101 );
@@ -102,11 +184,748 @@ main (int argc, char **argv)
    expected_flags.insert( "frac_cuts" );
    expected_flags.insert( "covers" );
    expected_flags.insert( "probing" );
+   expected_flags.insert( "parse_only" );
+   expected_flags.insert( "cplex_reader" );
+   expected_flags.insert( "cache" );
+   expected_flags.insert( "threads" );
+   expected_flags.insert( "batch" );
+   expected_flags.insert( "workers" );
+   expected_flags.insert( "sweep" );
+   expected_flags.insert( "sweep_log" );
+   expected_flags.insert( "portfolio" );
+   expected_flags.insert( "report" );
+   expected_flags.insert( "report_dir" );
+   expected_flags.insert( "progress" );
+   expected_flags.insert( "progress_interval" );
+   expected_flags.insert( "progress_size" );
+   expected_flags.insert( "metrics" );
+   expected_flags.insert( "mipstart" );
+   expected_flags.insert( "write_sol" );
+   expected_flags.insert( "checkpoint" );
+   expected_flags.insert( "checkpoint_every" );
+   expected_flags.insert( "resume" );
+   expected_flags.insert( "prereduce" );
+   expected_flags.insert( "cover_heur" );
+   expected_flags.insert( "check" );
+   expected_flags.insert( "check_tol" );
+   expected_flags.insert( "features" );
+   expected_flags.insert( "auto_params" );
+   expected_flags.insert( "decompose" );
+   expected_flags.insert( "symmetry" );
+   expected_flags.insert( "engine" );
+   expected_flags.insert( "lagrangian" );
+   expected_flags.insert( "lagrangian_stop" );
+   expected_flags.insert( "lazy_rows" );
+   expected_flags.insert( "lazy_transitivity" );
+   expected_flags.insert( "packing_cuts" );
+   expected_flags.insert( "root_lp" );
+   expected_flags.insert( "crossover" );
    if( ! command_line.flagsAreLegal( expected_flags ) ) {
      usage( argv[ 0 ] );
      exit( 102 );
    }
+
+   // flag values in range? (checked here, once, so that no instance run
+   // by a batch, sweep or portfolio worker has to end the process)
+   int bad_value = badFlagValue( command_line );
+   if( bad_value ) {
+     exit( bad_value );
+   }
+   args_timer.stop();
+   env.out() << "phase_args\t" << args_timer.getTotalTime() << endl;
+   env.out() << "phase_args_cpu\t" << args_timer.getCpuTime() << endl;
    
+   if( command_line.flagPresent( "sweep" ) ) {
+     int status = runSweep( command_line, solveInstance, cout );
+     env.end();
+     return status;
+   }
+
+   if( command_line.flagPresent( "batch" ) ) {
+     int status = runBatch( command_line, solveInstance, cout );
+     env.end();
+     return status;
+   }
+
+   if( command_line.flagPresent( "portfolio" ) ) {
+     int status = runPortfolio( command_line, solveInstance, cout );
+     env.end();
+     return status;
+   }
+
+   int status = solveInstance( env, command_line, command_line.getFile( 1 ),
+                               0, 0, cout );
+   env.end();
+   return status;
+}  // END main
+
+/// Reads and solves one instance, writing all tag/value output to out.
+/// Everything created in env is ended before returning, so that batch
+/// workers can reuse their environment for the next instance.
+/// @return the exit status for a run on this instance alone
+static int
+solveInstance( IloEnv env, const CmdLine & given_command_line,
+               const string input_file_string,
+               const LpModel * shared_model,
+               PortfolioRacer * racer, ostream & out )
+{
+   // -auto_params may add flags once the model has been read
+   CmdLine command_line = given_command_line;
+
+   // needed to allow easy join operations after conversion to csv
+   // using scripts/runstats2csv.sh
+   out << "00-Instance\t" << getBasename(input_file_string) << endl;
+   out << "InputFile\t" << input_file_string << endl;
+
+   // wall and processor time of each phase of the run, printed at the end
+   // as phase_* tags; the processor time is that of the process, so it is
+   // left out when other instances run alongside this one
+   bool process_to_itself = ! command_line.flagPresent( "batch" )
+     && ! command_line.flagPresent( "sweep" )
+     && ! command_line.flagPresent( "portfolio" );
+   PhaseProfiler profiler( process_to_itself );
+   profiler.begin( "open" );
+
+   // -report=json: the same information (and more) as one JSON object,
+   // emitted once the run is over
+   RunReport report;
+   report.set( "run", "instance", getBasename(input_file_string) );
+   report.set( "run", "file", input_file_string );
+   if( racer ) {
+     report.set( "run", "portfolio_racer", static_cast<long>( racer->index ) );
+   }
+   string_table flags = command_line.getFlags();
+   for( string_table::const_iterator flag = flags.begin();
+        flag != flags.end(); ++flag ) {
+     report.set( "parameters", flag->first, flag->second );
+   }
+
+   // values that a sweep or portfolio configuration set after main checked
+   // the command line
+   if( badFlagValue( command_line ) ) {
+     emitError( out, report, command_line, input_file_string, profiler,
+                "bad flag value" );
+     return EXIT_FAILURE;
+   }
+   
+   // conversion to string is needed for the file stream and importModel() method
+   istringstream input_file_stream( input_file_string );
+   char * input_file_name = new char[ input_file_string.length() + 1 ];
+   input_file_stream >> input_file_name;
+
+   // make sure file can be opened for input
+   ifstream input_stream(input_file_name, ios::in);
+   if( ! input_stream ) {
+     emitError( out, report, command_line, input_file_string, profiler,
+                "Unable to open file " + input_file_string + " for input." );
+     delete [] input_file_name;
+     return EXIT_FAILURE;
+   }
+
+   profiler.begin( "import" );
+
+   // files in LP format are read by the native parser, which is faster than
+   // importModel() and is needed for -parse_only; if the parser doesn't
+   // handle something in the file, importModel() gets a chance to read it
+   // (a parameter sweep passes in a model it has already read; it is shared
+   // by all runs on the instance); DIMACS CNF files are always read by
+   // the native reader, which builds their covering model
+   LpModel own_lp_model;
+   const LpModel * lp_model = shared_model ? shared_model : &own_lp_model;
+   bool have_lp_model = shared_model != 0;
+   bool cnf_input = CnfParser::isCnfFile( input_file_string );
+   bool native_reader = cnf_input
+     || ( ! command_line.flagPresent( "cplex_reader" )
+          && LpParser::isLpFile( input_file_string ) );
+   ClockTimer parse_timer = ClockTimer();
+
+   // with -cache, a binary snapshot of the parsed model is kept next to the
+   // input file (or in directory DIR with -cache=DIR) and used instead of
+   // the text whenever it is up to date
+   bool use_cache = native_reader && ! have_lp_model
+     && command_line.flagPresent( "cache" );
+   string cache_file_name;
+   bool cache_hit = false;
+   ClockTimer cache_timer = ClockTimer();
+   if( use_cache ) {
+     string cache_directory = command_line.stringFlag( "cache" );
+     if( cache_directory == "0" ) { // -cache without a directory
+       cache_directory = "";
+     }
+     cache_file_name
+       = ModelCache::cacheFileName( input_file_string, cache_directory );
+     ModelCache cache;
+     cache_timer.start();
+     cache_hit = cache.load( cache_file_name, input_file_string, own_lp_model );
+     cache_timer.stop();
+     if( ! cache_hit ) {
+       cerr << "Model cache " << cache_file_name << " not used: "
+            << cache.errorMessage() << endl;
+     }
+     have_lp_model = cache_hit;
+   }
+
+   if( cnf_input && ! have_lp_model ) {
+     CnfParser parser;
+     parse_timer.start();
+     have_lp_model = parser.parse( input_file_string, own_lp_model );
+     parse_timer.stop();
+     if( ! have_lp_model ) {
+       // CPLEX can't read the file either
+       emitError( out, report, command_line, input_file_string, profiler,
+                  "CNF reader: " + parser.errorMessage() );
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+     out << "InputBytes\t" << parser.bytesRead() << endl;
+     out << "CnfClauses\t" << parser.clauses() << endl;
+     out << "CnfTautologies\t" << parser.tautologies() << endl;
+     report.set( "dimensions", "cnf_clauses", parser.clauses() );
+     report.set( "dimensions", "cnf_tautologies", parser.tautologies() );
+     if( use_cache ) {
+       ModelCache cache;
+       if( ! cache.write( cache_file_name, input_file_string, own_lp_model ) ) {
+         cerr << "Warning: unable to write model cache: "
+              << cache.errorMessage() << endl;
+       }
+     }
+   }
+   else if( native_reader && ! have_lp_model ) {
+     LpParser parser;
+     parse_timer.start();
+     have_lp_model = parser.parse( input_file_string, own_lp_model );
+     parse_timer.stop();
+     if( ! have_lp_model ) {
+       cerr << "Native LP reader: " << parser.errorMessage() << endl;
+     }
+     else {
+       out << "InputBytes\t" << parser.bytesRead() << endl;
+       if( use_cache ) {
+         ModelCache cache;
+         if( ! cache.write( cache_file_name, input_file_string, own_lp_model ) ) {
+           cerr << "Warning: unable to write model cache: "
+                << cache.errorMessage() << endl;
+         }
+       }
+     }
+   }
+   // printed without -cache too (as 0), so that the columns of
+   // runstats2csv.sh stay aligned
+   out << "CacheHit\t" << cache_hit << endl;
+   out << "CacheLoadTime\t" << cache_timer.getTotalTime() << endl;
+   report.set( "run", "cache_hit", cache_hit );
+   report.set( "timings", "cache_load", cache_timer.getTotalTime() );
+
+   if( command_line.flagPresent( "parse_only" ) ) {
+     if( ! have_lp_model ) {
+       emitError( out, report, command_line, input_file_string, profiler,
+                  "-parse_only requires a file the native LP reader can"
+                  " handle." );
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+     out << "Variables\t" << lp_model->numberOfColumns() << endl;
+     out << "Constraints\t" << lp_model->numberOfRows() << endl;
+     out << "NonZeros\t" << lp_model->numberOfNonZeros() << endl;
+     out << "ParseTime\t" << parse_timer.getTotalTime() << endl;
+     report.set( "dimensions", "variables", lp_model->numberOfColumns() );
+     report.set( "dimensions", "constraints", lp_model->numberOfRows() );
+     report.set( "dimensions", "nonzeros", lp_model->numberOfNonZeros() );
+     report.set( "timings", "parse", parse_timer.getTotalTime() );
+     profiler.end();
+     printPhases( out, report, profiler );
+     emitReport( command_line, report, input_file_string, out );
+     delete [] input_file_name;
+     return 0;
+   }
+
+   // -features: statistics of the model for algorithm selection, instead
+   // of solving; -features=lp adds those of the root LP relaxation
+   if( command_line.flagPresent( "features" ) ) {
+     delete [] input_file_name;
+     if( ! have_lp_model ) {
+       emitError( out, report, command_line, input_file_string, profiler,
+                  "-features requires a file the native LP reader can"
+                  " handle." );
+       return EXIT_FAILURE;
+     }
+     profiler.begin( "features" );
+     ModelFeatures features;
+     features.compute( *lp_model );
+     string feature_set = command_line.stringFlag( "features" );
+     if( feature_set == "lp" ) {
+       profiler.begin( "root_lp" );
+       rootLpFeatures( env, *lp_model, features );
+     }
+     else if( feature_set != "0" ) {
+       cerr << "Warning: unknown feature set " << feature_set
+            << " -- structural features only" << endl;
+     }
+     for( size_t i = 0; i < features.size(); ++i ) {
+       out << "feature_" << features.name( i ) << "\t" << features.value( i )
+           << endl;
+       report.set( "features", features.name( i ), features.value( i ) );
+     }
+     out << "FeaturesTime\t" << features.time() << endl;
+     report.set( "timings", "features", features.time() );
+     profiler.end();
+     printPhases( out, report, profiler );
+     emitReport( command_line, report, input_file_string, out );
+     return 0;
+   }
+
+   // -check=FILE: check the solutions in FILE (e.g., the output of an
+   // earlier run with -solution) against the model instead of solving
+   string check_file = command_line.flagPresent( "check" )
+     ? command_line.stringFlag( "check" ) : "0";
+   if( check_file != "0" ) {
+     delete [] input_file_name;
+     if( ! have_lp_model ) {
+       emitError( out, report, command_line, input_file_string, profiler,
+                  "-check=FILE requires a file the native LP reader can"
+                  " handle." );
+       return EXIT_FAILURE;
+     }
+     profiler.begin( "check" );
+     check_file = SolutionFile::instanceFileName( check_file,
+                                                  getBasename( input_file_string ) );
+     SolutionFile solutions;
+     if( ! solutions.read( check_file ) ) {
+       emitError( out, report, command_line, input_file_string, profiler,
+                  "Unable to check: " + solutions.errorMessage() );
+       return EXIT_FAILURE;
+     }
+     // details are for the first solution, the best one in a file written
+     // by -write_sol; the count covers all of them
+     SolutionChecker checker( *lp_model );
+     double tolerance = checkTolerance( command_line );
+     int infeasible = 0;
+     for( size_t i = solutions.numberOfSolutions(); i-- > 0; ) {
+       size_t unknown_names = 0;
+       size_t missing_names = 0;
+       vector<double> values
+         = SolutionChecker::columnValues( *lp_model, solutions.solution( i ),
+                                          unknown_names, missing_names );
+       checker.check( values, tolerance );
+       if( ! checker.feasible() ) {
+         ++infeasible;
+       }
+       if( i == 0 ) {
+         out << "CheckUnknownNames\t" << unknown_names << endl;
+         out << "CheckMissingNames\t" << missing_names << endl;
+         report.set( "check", "unknown_names",
+                     static_cast<long>( unknown_names ) );
+         report.set( "check", "missing_names",
+                     static_cast<long>( missing_names ) );
+       }
+     }
+     out << "CheckFile\t" << check_file << endl;
+     out << "CheckSolutions\t" << solutions.numberOfSolutions() << endl;
+     out << "CheckInfeasibleSolutions\t" << infeasible << endl;
+     report.set( "check", "file", check_file );
+     report.set( "check", "solutions",
+                 static_cast<long>( solutions.numberOfSolutions() ) );
+     report.set( "check", "infeasible_solutions", infeasible );
+     printCheck( out, report, *lp_model, checker,
+                 solutions.solution( 0 ).has_value,
+                 solutions.solution( 0 ).value );
+     profiler.end();
+     printPhases( out, report, profiler );
+     emitReport( command_line, report, input_file_string, out );
+     return 0;
+   }
+
+   // -auto_params=MODEL_FILE: flags chosen from the features of the
+   // instance by a predictor trained on past runs (see train_params.cpp);
+   // flags given on the command line take precedence
+   if( command_line.flagPresent( "auto_params" ) ) {
+     profiler.begin( "auto_params" );
+     string selector_file = command_line.stringFlag( "auto_params" );
+     ParameterSelector selector;
+     if( ! have_lp_model ) {
+       cerr << "Warning: -auto_params needs a file the native LP reader can"
+            << " handle -- using the given flags" << endl;
+     }
+     else if( ! selector.read( selector_file ) ) {
+       cerr << "Warning: -auto_params: " << selector.errorMessage()
+            << " -- using the given flags" << endl;
+     }
+     else {
+       ModelFeatures features;
+       features.compute( *lp_model );
+       string setting = selector.setting( selector.select( features ) );
+       FlagList flags = ParameterSelector::settingFlags( setting );
+       for( size_t i = 0; i < flags.size(); ++i ) {
+         if( command_line.flagPresent( flags[ i ].first ) ) {
+           continue;
+         }
+         command_line.setFlag( flags[ i ].first, flags[ i ].second );
+         report.set( "parameters", flags[ i ].first, flags[ i ].second );
+       }
+       out << "AutoParams\t" << setting << endl;
+       report.set( "auto_params", "model_file", selector_file );
+       report.set( "auto_params", "setting", setting );
+       for( size_t i = 0; i < features.size(); ++i ) {
+         report.set( "features", features.name( i ), features.value( i ) );
+       }
+     }
+     profiler.begin( "import" );
+   }
+
+   // -prereduce: covering/packing reductions on the parsed model; values
+   // are mapped back to the original variables for -solution and -verify
+   CoverReduction reduction;
+   LpModel reduced_lp_model;
+   bool reduced = false;
+   if( command_line.flagPresent( "prereduce" ) ) {
+     profiler.begin( "prereduce" );
+     if( ! have_lp_model ) {
+       cerr << "Warning: -prereduce needs a file the native LP reader can"
+            << " handle -- not reducing" << endl;
+     }
+     else if( ! reduction.reduce( *lp_model, reduced_lp_model ) ) {
+       cerr << "Warning: not reducing: " << reduction.errorMessage() << endl;
+     }
+     else {
+       reduced = true;
+       out << "PrereduceKind\t"
+           << (reduction.kind() == CoverReduction::COVERING ? "covering"
+               : "packing") << endl;
+       out << "PrereduceRowsRemoved\t" << reduction.rowsRemoved() << endl;
+       out << "PrereduceColumnsRemoved\t" << reduction.columnsRemoved() << endl;
+       out << "PrereduceNonZerosRemoved\t" << reduction.nonZerosRemoved()
+           << endl;
+       out << "PrereduceFixedToOne\t" << reduction.columnsFixedToOne() << endl;
+       out << "PrereduceSingletonRows\t" << reduction.singletonRows() << endl;
+       out << "PrereduceDuplicateRows\t" << reduction.duplicateRows() << endl;
+       out << "PrereduceDominatedRows\t" << reduction.dominatedRows() << endl;
+       out << "PrereduceDuplicateColumns\t" << reduction.duplicateColumns()
+           << endl;
+       out << "PrereduceDominatedColumns\t" << reduction.dominatedColumns()
+           << endl;
+       out << "PrereducePasses\t" << reduction.passes() << endl;
+       out << "PrereduceTime\t" << reduction.reductionTime() << endl;
+       report.set( "prereduce", "rows_removed", reduction.rowsRemoved() );
+       report.set( "prereduce", "columns_removed", reduction.columnsRemoved() );
+       report.set( "prereduce", "nonzeros_removed",
+                   reduction.nonZerosRemoved() );
+       report.set( "prereduce", "fixed_to_one", reduction.columnsFixedToOne() );
+       report.set( "prereduce", "budget_exhausted",
+                   reduction.budgetExhausted() );
+       report.set( "prereduce", "time", reduction.reductionTime() );
+     }
+     if( reduction.infeasible() ) {
+       out << "PrereduceInfeasible\t1" << endl;
+     }
+     profiler.begin( "import" );
+   }
+   const LpModel * original_lp_model = lp_model;
+   if( reduced ) {
+     lp_model = &reduced_lp_model;
+   }
+
+   // -lagrangian[=SEC]: a bound on the objective value by subgradient
+   // optimization of the Lagrangian relaxation of all rows, for at most SEC
+   // seconds (default 10), instead of solving; with -lagrangian_stop the
+   // bound is handed to CPLEX instead, so that the run stops as soon as a
+   // solution reaches it
+   bool lagrangian_stop = command_line.flagPresent( "lagrangian_stop" );
+   bool have_lagrangian_bound = false;
+   double lagrangian_cutoff = 0;
+   if( ( command_line.flagPresent( "lagrangian" ) || lagrangian_stop )
+       && ! have_lp_model ) {
+     cerr << "-lagrangian requires a file the native LP reader can handle."
+          << endl;
+     if( ! lagrangian_stop ) {
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+   }
+   else if( command_line.flagPresent( "lagrangian" ) || lagrangian_stop ) {
+     profiler.begin( "lagrangian" );
+     double budget = 10;
+     if( command_line.flagPresent( "lagrangian" )
+         && command_line.stringFlag( "lagrangian" ) != "0" ) {
+       budget = command_line.doubleFlag( "lagrangian" );
+     }
+     unsigned threads = 0;
+     if( command_line.flagPresent( "threads" ) ) {
+       threads = max( command_line.intFlag( "threads" ), 0 );
+     }
+     LagrangianBound lagrangian( *lp_model );
+     lagrangian.setThreads( threads );
+     // the value of a known solution is the target of the steps: -UB, or
+     // that of a greedy cover
+     if( command_line.flagPresent( "UB" ) && lp_model->minimize() ) {
+       lagrangian.setUpperBound( command_line.intFlag( "UB" ) );
+     }
+     else if( lp_model->minimize()
+              && CoverReduction::classify( *lp_model )
+              == CoverReduction::COVERING ) {
+       CoverHeuristic heuristic( *lp_model );
+       heuristic.run( 0, 1 );
+       if( heuristic.solutionFound() ) {
+         lagrangian.setUpperBound( heuristic.value() );
+       }
+     }
+     lagrangian.run( budget );
+     out << "LagrangianBound\t";
+     if( lagrangian.boundFound() ) {
+       out << lagrangian.bound();
+     }
+     out << endl;
+     if( lagrangian.boundFound() && lagrangian.integralObjective() ) {
+       out << "LagrangianRoundedBound\t" << lagrangian.roundedBound() << endl;
+     }
+     out << "LagrangianIterations\t" << lagrangian.iterations() << endl;
+     out << "LagrangianReachedUB\t" << lagrangian.reachedUpperBound() << endl;
+     out << "LagrangianThreads\t" << lagrangian.threadsUsed() << endl;
+     out << "LagrangianTime\t" << lagrangian.time() << endl;
+     if( lagrangian.boundFound() ) {
+       report.set( "lagrangian", "bound", lagrangian.bound() );
+       report.set( "lagrangian", "rounded_bound", lagrangian.roundedBound() );
+     }
+     report.set( "lagrangian", "iterations", lagrangian.iterations() );
+     report.set( "lagrangian", "reached_ub", lagrangian.reachedUpperBound() );
+     report.set( "lagrangian", "threads",
+                 static_cast<long>( lagrangian.threadsUsed() ) );
+     report.set( "timings", "lagrangian", lagrangian.time() );
+     if( ! lagrangian_stop ) {
+       if( command_line.flagPresent( "solution" ) ) {
+         out << "BeginMultipliers" << endl;
+         for( int i = 0; i < lp_model->numberOfRows(); ++i ) {
+           out << lp_model->rowName( i ) << "\t"
+               << lagrangian.multipliers()[ i ] << endl;
+         }
+         out << "EndMultipliers" << endl;
+       }
+       profiler.end();
+       printPhases( out, report, profiler );
+       emitReport( command_line, report, input_file_string, out );
+       delete [] input_file_name;
+       return 0;
+     }
+     have_lagrangian_bound = lagrangian.boundFound();
+     lagrangian_cutoff = lagrangian.roundedBound();
+     profiler.begin( "import" );
+   }
+
+   // -decompose: if the (reduced) model falls apart into independent
+   // components, solve them concurrently, each as a problem of its own, and
+   // put the results together
+   if( command_line.flagPresent( "decompose" ) && ! have_lp_model ) {
+     cerr << "Warning: -decompose needs a file the native LP reader can"
+          << " handle -- not decomposing" << endl;
+   }
+   else if( command_line.flagPresent( "decompose" ) ) {
+     profiler.begin( "decompose" );
+     ModelDecomposition decomposition;
+     decomposition.decompose( *lp_model );
+     size_t components = decomposition.numberOfComponents();
+     out << "Components\t" << components << endl;
+     out << "DecomposeTime\t" << decomposition.time() << endl;
+     report.set( "components", "count", static_cast<long>( components ) );
+     report.set( "components", "time", decomposition.time() );
+     if( components > 1 ) {
+       profiler.begin( "solve" );
+       ClockTimer runtime_timer = ClockTimer();
+       runtime_timer.start();
+       vector<ComponentResult> results;
+       unsigned workers = 1;
+       unsigned threads_per_component = 1;
+       solveComponents( command_line, solveInstance, input_file_string,
+                        decomposition, results, workers,
+                        threads_per_component );
+       runtime_timer.stop();
+       profiler.begin( "output" );
+       ComponentResult combined = combineResults( decomposition, results );
+
+       // the sum over components is the work done; the largest one bounds
+       // the wall time
+       double time_sum = 0;
+       double time_max = 0;
+       for( size_t c = 0; c < components; ++c ) {
+         time_sum += results[ c ].runtime;
+         time_max = max( time_max, results[ c ].runtime );
+         if( results[ c ].exit_status != 0 ) {
+           cerr << "Component " << c + 1 << " failed:" << endl
+                << results[ c ].output;
+         }
+       }
+       printResult( out, report, combined.status, runtime_timer,
+                    profiler.cpuTimes(),
+                    combined.timed_out, combined.solution_found,
+                    combined.proved_optimal, combined.value );
+       // the other tags of a CPLEX run, for the whole model
+       printCounts( out, report, combined.cplex_time, combined.branches,
+                    combined.iterations, combined.frac_cuts,
+                    combined.clique_cuts, combined.cover_cuts );
+       out << "Variables\t" << lp_model->numberOfColumns() << endl;
+       out << "Constraints\t" << lp_model->numberOfRows() << endl;
+       out << "NonZeros\t" << lp_model->numberOfNonZeros() << endl;
+       out << "ParseTime\t" << parse_timer.getTotalTime() << endl;
+       report.set( "dimensions", "variables", lp_model->numberOfColumns() );
+       report.set( "dimensions", "constraints", lp_model->numberOfRows() );
+       report.set( "dimensions", "nonzeros", lp_model->numberOfNonZeros() );
+       report.set( "timings", "parse", parse_timer.getTotalTime() );
+       out << "ComponentWorkers\t" << workers << endl;
+       out << "ComponentThreads\t" << threads_per_component << endl;
+       out << "ComponentTimeSum\t" << time_sum << endl;
+       out << "ComponentTimeMax\t" << time_max << endl;
+       report.set( "components", "workers", static_cast<long>( workers ) );
+       report.set( "components", "threads",
+                   static_cast<long>( threads_per_component ) );
+       report.set( "components", "time_sum", time_sum );
+       report.set( "components", "time_max", time_max );
+
+       // per component, largest first; there may be thousands of tiny ones
+       const size_t COMPONENTS_LISTED = 20;
+       for( size_t c = 0; c < components && c < COMPONENTS_LISTED; ++c ) {
+         const LpModel & component = decomposition.component( c );
+         ostringstream suffix;
+         suffix << "_" << c + 1;
+         out << "ComponentSize" << suffix.str() << "\t"
+             << component.numberOfColumns() << "\t"
+             << component.numberOfRows() << endl;
+         out << "ComponentStatus" << suffix.str() << "\t"
+             << results[ c ].status << endl;
+         out << "ComponentValue" << suffix.str() << "\t";
+         if( results[ c ].solution_found ) {
+           out << results[ c ].value;
+         }
+         out << endl;
+         out << "ComponentTime" << suffix.str() << "\t"
+             << results[ c ].runtime << endl;
+         report.set( "components", "columns" + suffix.str(),
+                     component.numberOfColumns() );
+         report.set( "components", "rows" + suffix.str(),
+                     component.numberOfRows() );
+         report.set( "components", "status" + suffix.str(),
+                     results[ c ].status );
+         report.set( "components", "time" + suffix.str(),
+                     results[ c ].runtime );
+       }
+
+       if( combined.solution_found ) {
+         // values of the variables of the model as read
+         vector<double> values = combined.values;
+         if( reduced ) {
+           values = reduction.postsolve( combined.values );
+         }
+         emitSolution( out, report, command_line, *original_lp_model, values,
+                       combined.value, input_file_string );
+       }
+       profiler.end();
+       printPhases( out, report, profiler );
+       emitReport( command_line, report, input_file_string, out );
+       delete [] input_file_name;
+       return combined.exit_status == 0 ? 0 : EXIT_FAILURE;
+     }
+     profiler.begin( "import" );
+   }
+
+   // -engine=native: branch and bound of our own for set covering models,
+   // which needs neither CPLEX nor a license (no IloCplex is created)
+   string engine = command_line.flagPresent( "engine" )
+     ? command_line.stringFlag( "engine" ) : "cplex";
+   if( engine == "native" ) {
+     if( ! have_lp_model ) {
+       cerr << "-engine=native requires a file the native LP reader can"
+            << " handle." << endl;
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+     profiler.begin( "setup" );
+     CoverSolver solver( *lp_model );
+     if( ! solver.errorMessage().empty() ) {
+       cerr << "-engine=native: " << solver.errorMessage() << endl;
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+     double time_limit = 3600;
+     if( command_line.flagPresent( "time" ) ) {
+       time_limit = command_line.intFlag( "time" );
+     }
+     solver.setTimeLimit( time_limit );
+     if( command_line.flagPresent( "nodes" ) ) {
+       int nodelimit = command_line.intFlag( "nodes" );
+       solver.setNodeLimit( nodelimit );
+     }
+     unsigned threads = 0;
+     if( command_line.flagPresent( "threads" ) ) {
+       threads = max( command_line.intFlag( "threads" ), 0 );
+     }
+     solver.setThreads( threads );
+     out << "Engine\tnative" << endl;
+     out << "Variables\t" << lp_model->numberOfColumns() << endl;
+     out << "Constraints\t" << lp_model->numberOfRows() << endl;
+     out << "NonZeros\t" << lp_model->numberOfNonZeros() << endl;
+     out << "ParseTime\t" << parse_timer.getTotalTime() << endl;
+     report.set( "run", "engine", "native" );
+     report.set( "dimensions", "variables", lp_model->numberOfColumns() );
+     report.set( "dimensions", "constraints", lp_model->numberOfRows() );
+     report.set( "dimensions", "nonzeros", lp_model->numberOfNonZeros() );
+     report.set( "timings", "parse", parse_timer.getTotalTime() );
+
+     // the search starts from a greedy cover, improved by local search
+     // for -cover_heur seconds if given
+     if( lp_model->minimize() ) {
+       profiler.begin( "heuristic" );
+       double budget = 0;
+       if( command_line.flagPresent( "cover_heur" ) ) {
+         budget = command_line.stringFlag( "cover_heur" ) == "0" ? 1
+           : command_line.doubleFlag( "cover_heur" );
+       }
+       CoverHeuristic heuristic( *lp_model );
+       heuristic.run( budget, max( threads, 1u ) );
+       if( heuristic.solutionFound() ) {
+         solver.setIncumbent( vector<double>( heuristic.solution().begin(),
+                                              heuristic.solution().end() ) );
+         out << "heur_value\t" << heuristic.value() << endl;
+       }
+       out << "heur_time\t" << heuristic.time() << endl;
+       report.set( "heuristic", "time", heuristic.time() );
+     }
+
+     profiler.begin( "solve" );
+     ClockTimer runtime_timer = ClockTimer();
+     runtime_timer.start();
+     if( ! solver.solve() ) {
+       cerr << "-engine=native: " << solver.errorMessage() << endl;
+       delete [] input_file_name;
+       return EXIT_FAILURE;
+     }
+     runtime_timer.stop();
+     profiler.begin( "output" );
+     bool timed_out = solver.status() == CoverSolver::TIME_LIMIT;
+     printResult( out, report, CoverSolver::statusName( solver.status() ),
+                  runtime_timer, profiler.cpuTimes(), timed_out, solver.solutionFound(),
+                  solver.provedOptimal(), solver.value() );
+     // the tags of a CPLEX run, so that the columns of runstats2csv.sh stay
+     // aligned; there are no simplex iterations or cuts here
+     printCounts( out, report, solver.time(), solver.nodes(), 0, 0, 0, 0 );
+     out << "NativeThreads\t" << solver.threadsUsed() << endl;
+     out << "NativeRootBound\t" << solver.rootBound() << endl;
+     out << "NativeBestBound\t" << solver.bestBound() << endl;
+     out << "NativeNodesStolen\t" << solver.nodesStolen() << endl;
+     report.set( "counts", "nodes_stolen", solver.nodesStolen() );
+     report.set( "bounds", "root_bound", solver.rootBound() );
+     report.set( "bounds", "best_bound", solver.bestBound() );
+     if( solver.solutionFound() ) {
+       vector<double> values = solver.values();
+       if( reduced ) {
+         values = reduction.postsolve( solver.values() );
+       }
+       emitSolution( out, report, command_line, *original_lp_model, values,
+                     solver.value(), input_file_string );
+     }
+     profiler.end();
+     printPhases( out, report, profiler );
+     emitReport( command_line, report, input_file_string, out );
+     delete [] input_file_name;
+     return 0;
+   }
+
    IloModel model(env);
    IloCplex cplex(env);
 #if 0 // No callbacks for now 
@@ -121,52 +940,128 @@ main (int argc, char **argv)
    IloNumVarArray var(env);
    IloRangeArray  rng(env);
    bool solve_as_lp = false; // true if only the LP solution is desired
-   string input_file_string( command_line.getFile( 1 ) );
-   // needed to allow easy join operations after conversion to csv
-   // using scripts/runstats2csv.sh
-   cout << "00-Instance\t" << getBasename(input_file_string) << endl;
-   cout << "InputFile\t" << input_file_string << endl;
-   
-   // conversion to string is needed for the file stream and importModel() method
-   istringstream input_file_stream( input_file_string );
-   char * input_file_name = new char[ input_file_string.length() + 1 ];
-   input_file_stream >> input_file_name;
 
-   // make sure file can be opened for input
-   ifstream input_stream(input_file_name, ios::in);
-   if( ! input_stream ) {
-     cerr << "Unable to open file " << input_file_string
-          << " for input." << endl;
-     return EXIT_FAILURE;
+   // -lazy_rows: only some of the rows are loaded at first, a greedy cover
+   // of the columns; the others are added by a lazy constraint callback
+   // when a candidate solution violates them
+   unique_ptr<LazyRowPool> lazy_rows;
+   if( command_line.flagPresent( "lazy_rows" ) ) {
+     if( ! have_lp_model ) {
+       cerr << "Warning: -lazy_rows needs a file the native LP reader can"
+            << " handle -- loading all rows" << endl;
+     }
+     else if( command_line.flagPresent( "lp_only" ) ) {
+       cerr << "Warning: -lazy_rows has no effect with -lp_only" << endl;
+     }
+     else {
+       lazy_rows.reset( new LazyRowPool( *lp_model ) );
+       lazy_rows->selectInitialRows();
+     }
+   }
+
+   // -lazy_transitivity: the 3-cycle rows of an ordering model are left
+   // out and added back when violated, by a lazy constraint callback for
+   // integer solutions and a user cut callback for fractional ones
+   unique_ptr<TransitivitySeparator> transitivity;
+   vector<char> transitivity_loaded;
+   if( command_line.flagPresent( "lazy_transitivity" ) ) {
+     if( ! have_lp_model ) {
+       cerr << "Warning: -lazy_transitivity needs a file the native LP"
+            << " reader can handle -- loading all rows" << endl;
+     }
+     else if( command_line.flagPresent( "lp_only" ) ) {
+       cerr << "Warning: -lazy_transitivity has no effect with -lp_only"
+            << endl;
+     }
+     else if( lazy_rows ) {
+       cerr << "Warning: -lazy_transitivity is ignored with -lazy_rows"
+            << endl;
+     }
+     else {
+       transitivity.reset( new TransitivitySeparator( *lp_model ) );
+       if( ! transitivity->detect() ) {
+         cerr << "Warning: no 3-cycle rows on ordering variables x_i_j,"
+              << " x_j_i -- loading all rows" << endl;
+         transitivity.reset();
+       }
+       else {
+         const vector<char> & omitted = transitivity->transitivityRows();
+         transitivity_loaded.resize( omitted.size() );
+         for( size_t i = 0; i < omitted.size(); ++i ) {
+           transitivity_loaded[i] = ! omitted[i];
+         }
+       }
+     }
    }
+   const vector<char> * loaded_rows = 0;
+   if( lazy_rows ) loaded_rows = &lazy_rows->loadedRows();
+   else if( transitivity ) loaded_rows = &transitivity_loaded;
 
+   ClockTimer load_timer = ClockTimer();
    try {
+     if( have_lp_model ) {
+       load_timer.start();
+       loadModel( env, *lp_model, model, obj, var, rng, loaded_rows );
+       load_timer.stop();
+     }
+     else {
+       if( native_reader ) {
+         cerr << " -- using the CPLEX reader instead" << endl;
+       }
+       parse_timer.reset();
+       parse_timer.start();
        cplex.importModel(model, input_file_name, obj, var, rng);
+       parse_timer.stop();
+     }
    }
    catch ( IloException & e ) {
      cerr << "*** Error while reading file ***" << endl;
-     cerr << e.getMessage();
+     emitError( out, report, command_line, input_file_string, profiler,
+                e.getMessage() );
      e.end();
-     env.end();
      delete [] input_file_name;
      return EXIT_FAILURE;
    }
+   out << "Reader\t"
+       << (shared_model ? "shared" : have_lp_model ? "native" : "cplex") << endl;
+   out << "ParseTime\t" << parse_timer.getTotalTime() << endl;
+   out << "LoadTime\t" << load_timer.getTotalTime() << endl;
+   report.set( "run", "reader",
+               shared_model ? "shared" : have_lp_model ? "native" : "cplex" );
+   report.set( "timings", "parse", parse_timer.getTotalTime() );
+   report.set( "timings", "load", load_timer.getTotalTime() );
+   if( lazy_rows ) {
+     out << "LazyRowsInitial\t" << lazy_rows->initialRows() << endl;
+     out << "LazyRowsTotal\t" << lp_model->numberOfRows() << endl;
+     report.set( "lazy_rows", "initial", lazy_rows->initialRows() );
+     report.set( "lazy_rows", "total", lp_model->numberOfRows() );
+   }
+   if( transitivity ) {
+     out << "TransitivityLayers\t" << transitivity->numberOfLayers() << endl;
+     out << "TransitivityOrderingColumns\t"
+         << transitivity->orderingColumns() << endl;
+     out << "TransitivityTriples\t" << transitivity->triples() << endl;
+     out << "TransitivityRowsOmitted\t"
+         << transitivity->numberOfTransitivityRows() << endl;
+     report.set( "transitivity", "layers", transitivity->numberOfLayers() );
+     report.set( "transitivity", "ordering_columns",
+                 transitivity->orderingColumns() );
+     report.set( "transitivity", "triples", transitivity->triples() );
+     report.set( "transitivity", "rows_omitted",
+                 transitivity->numberOfTransitivityRows() );
+   }
    if( command_line.flagPresent( "lp_only" ) ) {
      solve_as_lp = true;
      model.add(IloConversion(env, var, ILOFLOAT));
    }
 
    delete [] input_file_name;
+
+   profiler.begin( "setup" );
       
    // set timeout or limit number of nodes, if desired
    if( command_line.flagPresent( "time" ) ) {
      int timeout = command_line.intFlag( "time" );
-     if( timeout <= 0 ) {
-       cerr << "Bad timeout value "
-            << command_line.stringFlag( "time" )
-            << " -- should be int > 0." << endl;
-       exit( 110 );
-     }
      cplex.setParam( IloCplex::TiLim, timeout );
    }
    else { // default time limit is one hour
@@ -175,12 +1070,6 @@ main (int argc, char **argv)
 
    if( command_line.flagPresent( "nodes" ) ) {
      int nodelimit = command_line.intFlag( "nodes" );
-     if( nodelimit <= 0 ) {
-       cerr << "Bad node limit value "
-            << command_line.stringFlag( "nodes" )
-            << " -- should be int > 0." << endl;
-       exit( 120 );
-     }
      cplex.setParam( IloCplex::NodeLim, nodelimit );
    }
 
@@ -192,6 +1081,17 @@ main (int argc, char **argv)
      model.add( obj >= target_cost );
    }
 
+   // -lagrangian_stop: no solution is better than the Lagrangian bound, so
+   // the search can end as soon as one reaches it
+   if( have_lagrangian_bound ) {
+     if( lp_model->minimize() ) {
+       model.add( obj >= lagrangian_cutoff );
+     }
+     else {
+       model.add( obj <= lagrangian_cutoff );
+     }
+   }
+
    // set an assumed initial upper bound
    int initial_upper_bound = INT_MAX;
    if( command_line.flagPresent( "UB" ) ) {
@@ -203,36 +1103,18 @@ main (int argc, char **argv)
    // stop after a certain number of solutions have been found
    if( command_line.flagPresent( "sols" ) ) {
      int solutionLimit = command_line.intFlag( "sols" );
-     if( solutionLimit <= 0 ) {
-       cerr << "Bad solution limit value "
-            << command_line.stringFlag( "sols" )
-            << " -- should be int > 0." << endl;
-       exit( 130 );
-     }
      cplex.setParam( IloCplex::IntSolLim, solutionLimit );
    }
 
    // set preference for dependency checking (of rows)
    if( command_line.flagPresent( "dep" ) ) {
      int dependence_indicator = command_line.intFlag( "dep" );
-     if( dependence_indicator < -1 || dependence_indicator > 3 ) {
-       cerr << "Bad dependence indicator "
-            << command_line.stringFlag( "dep" )
-            << " -- should be -1, 0, 1, 2, or 3." << endl;
-       exit( 133 );
-     }
      cplex.setParam( IloCplex::DepInd, dependence_indicator );
    }
 
    // set preference for feasibility versus optimality
    if( command_line.flagPresent( "feasible" ) ) {
      int emphasis = command_line.intFlag( "feasible" );
-     if( emphasis < 0 || emphasis > 4 ) {
-       cerr << "Bad feasibility indicator "
-            << command_line.stringFlag( "feasible" )
-            << " -- should be 0, 1, 2, 3, or 4." << endl;
-       exit( 135 );
-     }
      cplex.setParam( IloCplex::MIPEmphasis, emphasis );
    }
 
@@ -327,6 +1209,70 @@ main (int argc, char **argv)
      }
    }
 
+   // LP algorithm at the root (with -lp_only, for the LP itself); race is a
+   // race of primal, dual and barrier that reports the time of each
+   bool root_lp_race = false;
+   if( command_line.flagPresent( "root_lp" ) ) {
+     string root_lp = command_line.stringFlag( "root_lp" );
+     // the racers solve the parsed model, so rows added to the model after
+     // it was loaded (-symmetry, -cost, -lagrangian_stop) would make the
+     // race about another LP
+     bool rows_added = command_line.flagPresent( "symmetry" )
+       || command_line.flagPresent( "cost" ) || have_lagrangian_bound;
+     if( root_lp == "race" ) {
+       if( solve_as_lp && have_lp_model && rows_added ) {
+         cerr << "Warning: -root_lp=race can't be used with rows added to"
+              << " the model (-symmetry, -cost, -lagrangian_stop) -- using"
+              << " the concurrent optimizer." << endl;
+         cplex.setParam( IloCplex::RootAlg, 6 );
+       }
+       else if( solve_as_lp && have_lp_model ) {
+         root_lp_race = true;
+       }
+       else {
+         cerr << "Warning: -root_lp=race needs -lp_only and a file the"
+              << " native LP reader can handle -- using the concurrent"
+              << " optimizer." << endl;
+         cplex.setParam( IloCplex::RootAlg, 6 );
+       }
+     }
+     else {
+       switch( root_lp[ 0 ] ) {
+       case 'a': case 'A': // automatic (default)
+         cplex.setParam( IloCplex::RootAlg, 0 ); break;
+       case 'p': case 'P': // primal simplex
+         cplex.setParam( IloCplex::RootAlg, 1 ); break;
+       case 'd': case 'D': // dual simplex
+         cplex.setParam( IloCplex::RootAlg, 2 ); break;
+       case 'b': case 'B': // barrier
+         cplex.setParam( IloCplex::RootAlg, 4 ); break;
+       case 'f': case 'F': // sifting
+         cplex.setParam( IloCplex::RootAlg, 5 ); break;
+       case 'c': case 'C': // concurrent: primal, dual and barrier at once
+         cplex.setParam( IloCplex::RootAlg, 6 ); break;
+       default:
+         cerr << "Warning: Bad root LP algorithm indicator " << root_lp
+              << " -- using default." << endl;
+       }
+     }
+   }
+
+   // crossover after barrier: none gives an interior solution, no basis
+   int crossover = 0;
+   if( command_line.flagPresent( "crossover" ) ) {
+     string crossover_type = command_line.stringFlag( "crossover" );
+     switch( crossover_type[ 0 ] ) {
+     case 'n': case 'N': crossover = -1; break; // none
+     case 'a': case 'A': crossover = 0; break;  // automatic (default)
+     case 'p': case 'P': crossover = 1; break;  // primal
+     case 'd': case 'D': crossover = 2; break;  // dual
+     default:
+       cerr << "Warning: Bad crossover indicator " << crossover_type
+            << " -- using default." << endl;
+     }
+     cplex.setParam( IloCplex::BarCrossAlg, crossover );
+   }
+
    // pursue Gomory cuts aggressively.
    if( command_line.flagPresent( "frac_cuts" ) ) {
      cplex.setParam( IloCplex::FracCuts, 2 );
@@ -368,6 +1314,18 @@ main (int argc, char **argv)
      cplex.setParam( IloCplex::MIPDisplay, 0 );
    }
 
+   // number of threads CPLEX may use (0 = one per core, the default);
+   // set by runBatch() to share the cores among concurrent instances
+   if( command_line.flagPresent( "threads" ) ) {
+     int threads = command_line.intFlag( "threads" );
+     if( threads < 0 ) {
+       cerr << "Warning: Bad number of threads " << threads
+            << " -- using default (all cores)." << endl;
+       threads = 0;
+     }
+     cplex.setParam( IloCplex::Threads, threads );
+   }
+
    // Trace frequency (only relevant for level 2 and higher)
    if( command_line.flagPresent( "t_freq" ) ) {
      int frequency = command_line.intFlag( "t_freq" );
@@ -386,45 +1344,497 @@ main (int argc, char **argv)
    // cplex.setParam(IloCplex::Param::Emphasis::Numerical, true);
    // cplex.setParam(IloCplex::Param::MIP::Tolerances::MIPGap, 0);
    
-   cout << "Parameters for current run --" << endl;
-   cout << "Timeout\t" << cplex.getParam( IloCplex::TiLim ) << endl;
-   cout << "Node_limit\t" << cplex.getParam( IloCplex::NodeLim )
+   out << "Parameters for current run --" << endl;
+   out << "Timeout\t" << cplex.getParam( IloCplex::TiLim ) << endl;
+   out << "Node_limit\t" << cplex.getParam( IloCplex::NodeLim )
              << endl;
-   cout << "Target_cost\t" << target_cost << endl;
-   cout << "Initial_UB\t" << initial_upper_bound << endl;
-   cout << "Dependence_indicator:\t"
+   out << "Target_cost\t" << target_cost << endl;
+   out << "Initial_UB\t" << initial_upper_bound << endl;
+   out << "Dependence_indicator:\t"
              << cplex.getParam( IloCplex::DepInd ) << endl;
-   cout << "Feasibility_indicator:\t"
+   out << "Feasibility_indicator:\t"
              << cplex.getParam( IloCplex::MIPEmphasis ) << endl;
-   cout << "Node_selection\t"
+   out << "Node_selection\t"
              << cplex.getParam( IloCplex::NodeSel ) << endl;
-   cout << "Variable_selection\t"
+   out << "Variable_selection\t"
              << cplex.getParam( IloCplex::VarSel ) << endl;
-   cout << "Heuristic_Frequency\t"
+   out << "Heuristic_Frequency\t"
              << cplex.getParam( IloCplex::HeurFreq ) << endl;
-   cout << "RINS_Heur_Frequency\t"
+   out << "RINS_Heur_Frequency\t"
              << cplex.getParam( IloCplex::RINSHeur ) << endl;
-   cout << "LP_Algorithm\t"
+   out << "LP_Algorithm\t"
              << cplex.getParam( IloCplex::NodeAlg ) << endl;
-   cout << "FracCuts\t"
+   out << "Root_LP_Algorithm\t"
+             << cplex.getParam( IloCplex::RootAlg ) << endl;
+   out << "Crossover\t"
+             << cplex.getParam( IloCplex::BarCrossAlg ) << endl;
+   out << "FracCuts\t"
              << cplex.getParam( IloCplex::FracCuts ) << endl;
-   cout << "Covers\t"
+   out << "Covers\t"
              << cplex.getParam( IloCplex::Covers ) << endl;
-   cout << "----------------------------------" << endl;
+   out << "Threads\t"
+             << cplex.getParam( IloCplex::Threads ) << endl;
+   out << "----------------------------------" << endl;
+   report.set( "settings", "timeout", cplex.getParam( IloCplex::TiLim ) );
+   report.set( "settings", "node_limit",
+               static_cast<double>( cplex.getParam( IloCplex::NodeLim ) ) );
+   report.set( "settings", "target_cost", target_cost );
+   report.set( "settings", "initial_ub", initial_upper_bound );
+   report.set( "settings", "dependence_indicator",
+               static_cast<long>( cplex.getParam( IloCplex::DepInd ) ) );
+   report.set( "settings", "mip_emphasis",
+               static_cast<long>( cplex.getParam( IloCplex::MIPEmphasis ) ) );
+   report.set( "settings", "node_selection",
+               static_cast<long>( cplex.getParam( IloCplex::NodeSel ) ) );
+   report.set( "settings", "variable_selection",
+               static_cast<long>( cplex.getParam( IloCplex::VarSel ) ) );
+   report.set( "settings", "heuristic_frequency",
+               static_cast<long>( cplex.getParam( IloCplex::HeurFreq ) ) );
+   report.set( "settings", "rins_frequency",
+               static_cast<long>( cplex.getParam( IloCplex::RINSHeur ) ) );
+   report.set( "settings", "node_algorithm",
+               static_cast<long>( cplex.getParam( IloCplex::NodeAlg ) ) );
+   report.set( "settings", "root_algorithm",
+               static_cast<long>( cplex.getParam( IloCplex::RootAlg ) ) );
+   report.set( "settings", "crossover",
+               static_cast<long>( cplex.getParam( IloCplex::BarCrossAlg ) ) );
+   report.set( "settings", "frac_cuts",
+               static_cast<long>( cplex.getParam( IloCplex::FracCuts ) ) );
+   report.set( "settings", "covers",
+               static_cast<long>( cplex.getParam( IloCplex::Covers ) ) );
+   report.set( "settings", "threads",
+               static_cast<long>( cplex.getParam( IloCplex::Threads ) ) );
+
+   // -symmetry[=SEC]: find permutations of the columns that leave the model
+   // unchanged (for at most SEC seconds, default 10) and add inequalities
+   // x_i >= x_j that only remove solutions equivalent to others; MIP starts
+   // are mapped to the equivalent solutions that satisfy them
+   unique_ptr<SymmetryDetector> symmetry;
+   if( command_line.flagPresent( "symmetry" ) ) {
+     profiler.begin( "symmetry" );
+     double budget = 10;
+     if( command_line.stringFlag( "symmetry" ) != "0" ) {
+       budget = command_line.doubleFlag( "symmetry" );
+     }
+     if( ! have_lp_model ) {
+       cerr << "Warning: -symmetry needs a file the native LP reader can"
+            << " handle -- no symmetry detection" << endl;
+     }
+     else {
+       symmetry.reset( new SymmetryDetector( *lp_model ) );
+       bool complete = symmetry->detect( budget );
+       const vector< pair<int, int> > & inequalities = symmetry->inequalities();
+       for( size_t k = 0; k < inequalities.size(); ++k ) {
+         model.add( IloRange( env, 0, var[ inequalities[ k ].first ]
+                              - var[ inequalities[ k ].second ], IloInfinity ) );
+       }
+       out << "SymmetryGenerators\t" << symmetry->numberOfGenerators() << endl;
+       out << "SymmetryGroupSizeLog10\t" << symmetry->groupSizeLog10() << endl;
+       out << "SymmetryOrbits\t" << symmetry->numberOfOrbits() << endl;
+       out << "SymmetryOrbitColumns\t" << symmetry->columnsInOrbits() << endl;
+       out << "SymmetryConstraints\t" << inequalities.size() << endl;
+       out << "SymmetryComplete\t" << complete << endl;
+       out << "SymmetryNodes\t" << symmetry->nodes() << endl;
+       out << "SymmetryTime\t" << symmetry->time() << endl;
+       report.set( "symmetry", "generators",
+                   static_cast<long>( symmetry->numberOfGenerators() ) );
+       report.set( "symmetry", "group_size_log10", symmetry->groupSizeLog10() );
+       report.set( "symmetry", "orbits", symmetry->numberOfOrbits() );
+       report.set( "symmetry", "orbit_columns", symmetry->columnsInOrbits() );
+       report.set( "symmetry", "constraints",
+                   static_cast<long>( inequalities.size() ) );
+       report.set( "symmetry", "complete", complete );
+       report.set( "symmetry", "time", symmetry->time() );
+     }
+     profiler.begin( "setup" );
+   }
 
+   profiler.begin( "extract" );
    cplex.extract( model );
+   profiler.begin( "setup" );
 
    // print dimensions of the matrix
-   cout << "Variables\t" << cplex.getNcols() << endl;
-   cout << "Constraints\t" << cplex.getNrows() << endl;
-   cout << "NonZeros\t" << cplex.getNNZs() << endl;
+   out << "Variables\t" << cplex.getNcols() << endl;
+   out << "Constraints\t" << cplex.getNrows() << endl;
+   out << "NonZeros\t" << cplex.getNNZs() << endl;
+   report.set( "dimensions", "variables", static_cast<long>( cplex.getNcols() ) );
+   report.set( "dimensions", "constraints",
+               static_cast<long>( cplex.getNrows() ) );
+   report.set( "dimensions", "nonzeros", static_cast<long>( cplex.getNNZs() ) );
+
+   bool minimize = obj.getSense() == IloObjective::Minimize;
+
+   // -mipstart=FILE: start from the solutions in FILE, e.g., those written
+   // by -write_sol or printed by -solution in an earlier run (a % in FILE
+   // stands for the instance name)
+   if( command_line.flagPresent( "mipstart" ) ) {
+     string start_file
+       = SolutionFile::instanceFileName( command_line.stringFlag( "mipstart" ),
+                                         getBasename( input_file_string ) );
+     SolutionFile starts;
+     if( solve_as_lp ) {
+       cerr << "Warning: -mipstart has no effect with -lp_only" << endl;
+     }
+     else if( ! starts.read( start_file ) ) {
+       cerr << "Warning: no MIP start: " << starts.errorMessage() << endl;
+     }
+     else {
+       if( symmetry ) starts = symmetricStarts( *symmetry, *lp_model, starts );
+       size_t unknown_names = 0;
+       int added = addMipStarts( env, cplex, var, starts, unknown_names );
+       if( unknown_names > 0 ) {
+         cerr << "Warning: " << unknown_names << " variable names in "
+              << start_file << " are not in the model" << endl;
+       }
+       out << "MipStarts\t" << added << endl;
+       out << "MipStartUnknownNames\t" << unknown_names << endl;
+       report.set( "warm_start", "mipstart_file", start_file );
+       report.set( "warm_start", "mipstarts", added );
+       report.set( "warm_start", "unknown_names",
+                   static_cast<long>( unknown_names ) );
+     }
+   }
+
+   // -resume=PATH: continue from the checkpoint in PATH, if there is one
+   // (its solutions become MIP starts; the tree has to be rebuilt)
+   Checkpoint previous( getBasename( input_file_string ), minimize );
+   bool resumed = false;
+   if( command_line.flagPresent( "resume" ) && ! solve_as_lp ) {
+     string resume_file
+       = SolutionFile::instanceFileName( command_line.stringFlag( "resume" ),
+                                         getBasename( input_file_string ) );
+     Checkpoint checkpoint;
+     if( ! checkpoint.read( resume_file ) ) {
+       cerr << "Warning: not resuming: " << checkpoint.errorMessage() << endl;
+     }
+     else if( checkpoint.instance() != previous.instance() ) {
+       cerr << "Warning: not resuming: " << resume_file
+            << " is a checkpoint of " << checkpoint.instance() << endl;
+     }
+     else {
+       previous = checkpoint;
+       resumed = true;
+       SolutionFile starts = previous.solutions();
+       if( symmetry ) starts = symmetricStarts( *symmetry, *lp_model, starts );
+       size_t unknown_names = 0;
+       int added = addMipStarts( env, cplex, var, starts, unknown_names );
+       out << "ResumedJobs\t" << previous.jobs() << endl;
+       out << "ResumedElapsed\t" << previous.elapsed() << endl;
+       out << "ResumedNodes\t" << previous.nodes() << endl;
+       out << "ResumedBestBound\t";
+       if( previous.hasBound() ) {
+         out << previous.bestBound();
+       }
+       out << endl;
+       out << "ResumedMipStarts\t" << added << endl;
+       report.set( "checkpoint", "resume_file", resume_file );
+       report.set( "checkpoint", "resumed_jobs", previous.jobs() );
+       report.set( "checkpoint", "resumed_elapsed", previous.elapsed() );
+       report.set( "checkpoint", "resumed_nodes",
+                   static_cast<long>( previous.nodes() ) );
+       if( previous.hasBound() ) {
+         report.set( "checkpoint", "resumed_best_bound", previous.bestBound() );
+       }
+     }
+   }
+
+   // -cover_heur[=SEC]: greedy and local search on a set covering model
+   // (default budget 1 second); the cover becomes a MIP start and cutoff
+   if( command_line.flagPresent( "cover_heur" ) && ! solve_as_lp ) {
+     profiler.begin( "heuristic" );
+     double budget = 1;
+     if( command_line.stringFlag( "cover_heur" ) != "0" ) {
+       budget = command_line.doubleFlag( "cover_heur" );
+     }
+     if( ! have_lp_model ) {
+       cerr << "Warning: -cover_heur needs a file the native LP reader can"
+            << " handle -- no heuristic" << endl;
+     }
+     else if( CoverReduction::classify( *lp_model ) != CoverReduction::COVERING
+              || ! lp_model->minimize() ) {
+       cerr << "Warning: -cover_heur applies to set covering models only"
+            << " -- no heuristic" << endl;
+     }
+     else {
+       unsigned threads = 0;
+       if( command_line.flagPresent( "threads" ) ) {
+         threads = max( command_line.intFlag( "threads" ), 0 );
+       }
+       if( threads == 0 ) {
+         threads = max( thread::hardware_concurrency(), 1u );
+       }
+       CoverHeuristic heuristic( *lp_model );
+       heuristic.run( budget, threads );
+       out << "heur_time\t" << heuristic.time() << endl;
+       report.set( "heuristic", "budget", budget );
+       report.set( "heuristic", "time", heuristic.time() );
+       if( heuristic.solutionFound() ) {
+         StoredSolution cover;
+         cover.has_value = true;
+         cover.value = heuristic.value();
+         for( int j = 0; j < lp_model->numberOfColumns(); ++j ) {
+           cover.values.push_back( make_pair( lp_model->columnName( j ),
+                                              heuristic.solution()[j] ? 1.0
+                                              : 0.0 ) );
+         }
+         SolutionFile starts;
+         starts.add( cover );
+         if( symmetry ) starts = symmetricStarts( *symmetry, *lp_model, starts );
+         size_t unknown_names = 0;
+         addMipStarts( env, cplex, var, starts, unknown_names );
+         if( heuristic.value() < cplex.getParam( IloCplex::CutUp ) ) {
+           cplex.setParam( IloCplex::CutUp, heuristic.value() );
+         }
+         out << "heur_value\t" << heuristic.value() << endl;
+         out << "heur_greedy_value\t" << heuristic.greedyValue() << endl;
+         out << "heur_greedy_time\t" << heuristic.greedyTime() << endl;
+         out << "heur_swaps1\t" << heuristic.oneSwaps() << endl;
+         out << "heur_swaps2\t" << heuristic.twoSwaps() << endl;
+         out << "heur_rounds\t" << heuristic.rounds() << endl;
+         report.set( "heuristic", "value", heuristic.value() );
+         report.set( "heuristic", "greedy_value", heuristic.greedyValue() );
+         report.set( "heuristic", "greedy_time", heuristic.greedyTime() );
+         report.set( "heuristic", "one_swaps", heuristic.oneSwaps() );
+         report.set( "heuristic", "two_swaps", heuristic.twoSwaps() );
+         report.set( "heuristic", "rounds", heuristic.rounds() );
+       }
+       else {
+         out << "heur_value\t" << endl;
+       }
+     }
+     profiler.begin( "setup" );
+   }
+
+   // -checkpoint=PATH: save the state of the solve in PATH every
+   // -checkpoint_every seconds, when the job is about to be killed
+   // (SIGTERM, SIGUSR1) and at the end
+   unique_ptr<Checkpointer> checkpointer;
+   if( command_line.flagPresent( "checkpoint" ) && ! solve_as_lp ) {
+     double interval = 600;
+     if( command_line.flagPresent( "checkpoint_every" ) ) {
+       interval = command_line.doubleFlag( "checkpoint_every" );
+     }
+     string checkpoint_file
+       = SolutionFile::instanceFileName( command_line.stringFlag( "checkpoint" ),
+                                         getBasename( input_file_string ) );
+     checkpointer.reset( new Checkpointer( checkpoint_file, interval,
+                                           previous ) );
+     cplex.use( checkpointCallback( env, var, checkpointer.get() ) );
+     Checkpointer::catchSignals();
+     report.set( "checkpoint", "file", checkpoint_file );
+   }
+
+   // -write_sol=FILE: keep the best solutions in FILE; it is rewritten at
+   // each new incumbent, so that it survives a crash or a kill
+   string solution_file;
+   unique_ptr<IncumbentSaver> incumbent_saver;
+   if( command_line.flagPresent( "write_sol" ) ) {
+     solution_file
+       = SolutionFile::instanceFileName( command_line.stringFlag( "write_sol" ),
+                                         getBasename( input_file_string ) );
+     if( ! solve_as_lp ) {
+       incumbent_saver.reset( new IncumbentSaver( solution_file, var,
+                                                  minimize ) );
+       cplex.use( incumbentSaverCallback( env, var, incumbent_saver.get() ) );
+     }
+   }
+
+   // in a portfolio race, share incumbents with the other racers and stop
+   // when one of them has proved optimality
+   if( racer ) {
+     racer->race->attach( racer->index, cplex, var, obj );
+   }
+
+   // -progress=FILE: sample best bound, incumbent, gap and node counts
+   // every -progress_interval seconds (and at each new incumbent) during
+   // the solve; the trace is written to FILE when the solve is over
+   // -metrics: compute primal/dual integrals and time-to-X measures from
+   // the same samples (without keeping them unless -progress is given)
+   unique_ptr<ProgressTrace> progress_trace;
+   unique_ptr<ProgressMetrics> progress_metrics;
+   if( command_line.flagPresent( "progress" )
+       || command_line.flagPresent( "metrics" ) ) {
+     double interval = 0.1;
+     if( command_line.flagPresent( "progress_interval" ) ) {
+       interval = command_line.doubleFlag( "progress_interval" );
+     }
+     int capacity = command_line.flagPresent( "progress" ) ? 65536 : 1;
+     if( command_line.flagPresent( "progress_size" ) ) {
+       capacity = command_line.intFlag( "progress_size" );
+     }
+     if( solve_as_lp ) {
+       cerr << "Warning: -progress and -metrics have no effect with -lp_only"
+            << endl;
+     }
+     else {
+       progress_trace.reset( new ProgressTrace( capacity, interval ) );
+       cplex.use( progressCallback( env, progress_trace.get() ) );
+     }
+   }
+   if( progress_trace && command_line.flagPresent( "metrics" ) ) {
+     // the target is the -cost to stop at or else the known -UB
+     double target = NAN;
+     if( command_line.flagPresent( "cost" ) ) {
+       target = target_cost;
+     }
+     else if( command_line.flagPresent( "UB" ) ) {
+       target = initial_upper_bound;
+     }
+     vector<double> gap_thresholds;
+     gap_thresholds.push_back( 0.10 );
+     gap_thresholds.push_back( 0.01 );
+     progress_metrics.reset( new ProgressMetrics( minimize, target,
+                                                  gap_thresholds ) );
+     progress_trace->setMetrics( progress_metrics.get() );
+   }
+
+   // the rows left out by -lazy_rows; presolve must not make reductions
+   // that the rows added later could invalidate, i.e., dual reductions
+   if( lazy_rows ) {
+     cplex.use( lazyRowsCallback( env, *lp_model, var, lazy_rows.get() ) );
+     cplex.setParam( IloCplex::Reduce, 1 ); // CPX_PREREDUCE_PRIMALONLY
+   }
+   if( transitivity ) {
+     cplex.use( transitivityLazyCallback( env, *lp_model, var,
+                                          transitivity.get() ) );
+     cplex.use( transitivityCutCallback( env, *lp_model, var,
+                                         transitivity.get() ) );
+     cplex.setParam( IloCplex::Reduce, 1 ); // CPX_PREREDUCE_PRIMALONLY
+   }
+
+   // -packing_cuts[=MS]: clique and odd-hole cuts from the conflict graph
+   // of the binary columns, with a budget of MS milliseconds (default 10)
+   // per call of the callback
+   unique_ptr<ConflictGraph> conflict_graph;
+   unique_ptr<PackingCutSeparator> packing_cuts;
+   if( command_line.flagPresent( "packing_cuts" ) && ! solve_as_lp ) {
+     double budget = 10;
+     if( command_line.stringFlag( "packing_cuts" ) != "0" ) {
+       budget = command_line.doubleFlag( "packing_cuts" );
+     }
+     if( ! have_lp_model ) {
+       cerr << "Warning: -packing_cuts needs a file the native LP reader can"
+            << " handle -- no cuts" << endl;
+     }
+     else {
+       ClockTimer graph_timer = ClockTimer();
+       graph_timer.start();
+       conflict_graph.reset( new ConflictGraph( *lp_model ) );
+       bool conflicts = conflict_graph->build();
+       graph_timer.stop();
+       out << "ConflictGraphLiterals\t"
+           << conflict_graph->conflictingLiterals() << endl;
+       out << "ConflictGraphCliques\t" << conflict_graph->numberOfCliques()
+           << endl;
+       out << "ConflictGraphEdges\t" << conflict_graph->edges() << endl;
+       out << "ConflictGraphTime\t" << graph_timer.getTotalTime() << endl;
+       report.set( "packing_cuts", "literals",
+                   conflict_graph->conflictingLiterals() );
+       report.set( "packing_cuts", "cliques",
+                   conflict_graph->numberOfCliques() );
+       report.set( "packing_cuts", "edges", conflict_graph->edges() );
+       report.set( "packing_cuts", "graph_time", graph_timer.getTotalTime() );
+       if( ! conflicts ) {
+         cerr << "Warning: no conflicts between binary columns -- no"
+              << " packing cuts" << endl;
+       }
+       else {
+         packing_cuts.reset( new PackingCutSeparator( *conflict_graph ) );
+         packing_cuts->setTimeBudget( budget / 1000 );
+         cplex.use( packingCutCallback( env, var, packing_cuts.get() ) );
+         // with a control callback CPLEX runs one thread unless told more
+         if( ! command_line.flagPresent( "threads" ) ) {
+           cplex.setParam( IloCplex::Threads,
+                           (int) max( thread::hardware_concurrency(), 1u ) );
+         }
+       }
+     }
+   }
+
+   // presolve, root and branch and bound are told apart by callbacks
+   SolvePhases solve_phases;
+   solve_phases.use( env, cplex );
 
    // to ensure that this field always exists
-   cout << "StatusCode\t_" << flush;
+   out << "StatusCode\t_" << flush;
 
    IloBool solution_found = false;
    ClockTimer runtime_timer = ClockTimer();
+   profiler.end();
+   solve_phases.start();
    runtime_timer.start();
+   if( progress_trace ) {
+     progress_trace->start();
+   }
+   // -root_lp=race: the winner's basis starts the solve, with its algorithm
+   unique_ptr<RootLpRace> root_lp;
+   if( root_lp_race ) {
+     root_lp.reset( new RootLpRace( *lp_model ) );
+     if( command_line.flagPresent( "threads" ) ) {
+       root_lp->setThreadsPerRacer( max( command_line.intFlag( "threads" ),
+                                         0 ) );
+     }
+     double time_limit = cplex.getParam( IloCplex::TiLim );
+     root_lp->setTimeLimit( time_limit );
+     root_lp->setCrossover( crossover );
+     if( root_lp->run() ) {
+       const RootLpRace::Racer & winner
+         = root_lp->racers()[ root_lp->winner() ];
+       cplex.setParam( IloCplex::RootAlg, winner.root_algorithm );
+       if( root_lp->hasBasis() ) root_lp->setBasis( cplex, var, rng );
+       // the race counts against the time limit
+       cplex.setParam( IloCplex::TiLim,
+                       max( time_limit - root_lp->time(), 0.0 ) );
+     }
+     else {
+       // no racer solved the LP (time limit, infeasible, unbounded, error):
+       // that is the result, which solving it again would only repeat
+       runtime_timer.stop();
+       solve_phases.stop( profiler );
+       profiler.begin( "output" );
+       string status = "ERROR";
+       long iterations = 0;
+       for( size_t r = 0; r < root_lp->racers().size(); ++r ) {
+         const RootLpRace::Racer & racer = root_lp->racers()[ r ];
+         iterations += racer.iterations;
+         if( status == "ERROR" ) status = racer.status;
+       }
+       bool race_timed_out = status == "AbortTimeLim";
+       // the tag is already there
+       out << status << endl;
+       out << "runtime      \t" << runtime_timer.getTotalTime() << endl;
+       if( profiler.cpuTimes() ) {
+         out << "runtime_cpu  \t" << runtime_timer.getCpuTime() << endl;
+       }
+       out << "TimedOut\t" << race_timed_out << endl;
+       out << "SolutionFound\t" << 0 << endl;
+       out << "ProvedOptimal\t" << 0 << endl;
+       out << "value      \t" << endl;
+       report.set( "status", "code", status );
+       report.set( "status", "timed_out", race_timed_out );
+       report.set( "status", "solution_found", false );
+       report.set( "status", "proved_optimal", false );
+       report.set( "timings", "runtime", runtime_timer.getTotalTime() );
+       if( profiler.cpuTimes() ) {
+         report.set( "timings", "runtime_cpu", runtime_timer.getCpuTime() );
+       }
+       printCounts( out, report, root_lp->time(), 0, iterations, 0, 0, 0 );
+       printRootLpRace( out, report, *root_lp );
+       profiler.end();
+       printPhases( out, report, profiler );
+       emitReport( command_line, report, input_file_string, out );
+       if( racer ) {
+         racer->race->finish( racer->index, false, false, 0 );
+         racer->race->detach( racer->index );
+       }
+       cplex.end();
+       rng.endElements();
+       var.endElements();
+       obj.end();
+       model.end();
+       return status == "ERROR" ? EXIT_FAILURE : 0;
+     }
+   }
    try {
      solution_found = cplex.solve();
    }
@@ -432,14 +1842,21 @@ main (int argc, char **argv)
      cerr << "*** Error during solving ***" << endl;
      cerr << e.getMessage();
      runtime_timer.stop();
+     solve_phases.stop( profiler );
      cerr << "*** elapsed time = " << runtime_timer.getTotalTime() << endl;
-     cout << "ERROR" << endl;
-     cout << "runtime      \t" << runtime_timer.getTotalTime() << endl;
+     out << "ERROR" << endl;
+     out << "runtime      \t" << runtime_timer.getTotalTime() << endl;
+     report.set( "status", "code", "ERROR" );
+     report.set( "status", "message", e.getMessage() );
+     report.set( "timings", "runtime", runtime_timer.getTotalTime() );
+     printPhases( out, report, profiler );
+     emitReport( command_line, report, input_file_string, out );
      e.end();
-     env.end();
      return EXIT_FAILURE;
    }
    runtime_timer.stop();
+   solve_phases.stop( profiler );
+   profiler.begin( "output" );
 
    IloCplex::CplexStatus solution_status = cplex.getCplexStatus();
 
@@ -454,79 +1871,782 @@ main (int argc, char **argv)
 
    // tag for status code is printed before the run so that there's
    // always one there
-   cout << "" << solution_status << endl;
-   cout << "runtime      \t" << runtime_timer.getTotalTime() << endl;
-   cout << "CPXtime \t" << cplex.getTime() << endl;
-   cout << "TimedOut\t" << timed_out << endl;
-   cout << "SolutionFound\t" << solution_found << endl;
-   cout << "ProvedOptimal\t" << proved_optimal << endl;
-   cout << "num_branches \t" << cplex.getNnodes() << endl;
-   cout << "value      \t";
+   out << "" << solution_status << endl;
+   out << "runtime      \t" << runtime_timer.getTotalTime() << endl;
+   if( profiler.cpuTimes() ) {
+     out << "runtime_cpu  \t" << runtime_timer.getCpuTime() << endl;
+   }
+   out << "CPXtime \t" << cplex.getTime() << endl;
+   out << "TimedOut\t" << timed_out << endl;
+   out << "SolutionFound\t" << solution_found << endl;
+   out << "ProvedOptimal\t" << proved_optimal << endl;
+   out << "num_branches \t" << cplex.getNnodes() << endl;
+   out << "value      \t";
+   if( solution_found ) {
+      out << cplex.getObjValue();
+   }
+   out << endl;
+   out << "iterations   \t" << cplex.getNiterations() << endl;
+   out << "frac_cuts    \t" << cplex.getNcuts(IloCplex::CutFrac) << endl;
+   out << "clique_cuts  \t" << cplex.getNcuts(IloCplex::CutClique) << endl;
+   out << "cover_cuts   \t" << cplex.getNcuts(IloCplex::CutCover) << endl;
+   out << "PeakMemoryMB\t" << peakMemoryMB() << endl;
+   report.set( "resources", "peak_memory_mb", peakMemoryMB() );
+   if( solve_as_lp ) {
+     // the algorithm that solved the LP, the winner if concurrent
+     const char * algorithm = RootLpRace::algorithmName( cplex.getAlgorithm() );
+     out << "RootLpAlgorithm\t" << algorithm << endl;
+     report.set( "root_lp", "algorithm", algorithm );
+   }
+   if( root_lp ) printRootLpRace( out, report, *root_lp );
+   if( lazy_rows ) {
+     out << "LazyRowsLoaded\t" << lazy_rows->rowsLoaded() << endl;
+     out << "LazySeparations\t" << lazy_rows->separations() << endl;
+     out << "LazySeparationTime\t" << lazy_rows->separationTime() << endl;
+     report.set( "lazy_rows", "loaded", lazy_rows->rowsLoaded() );
+     report.set( "lazy_rows", "separations", lazy_rows->separations() );
+     report.set( "lazy_rows", "separation_time",
+                 lazy_rows->separationTime() );
+   }
+   if( transitivity ) {
+     out << "TransitivityLazyCuts\t" << transitivity->lazyRows() << endl;
+     out << "TransitivityUserCuts\t" << transitivity->userRows() << endl;
+     out << "TransitivitySeparations\t" << transitivity->separations()
+         << endl;
+     out << "TransitivitySeparationTime\t"
+         << transitivity->separationTime() << endl;
+     report.set( "transitivity", "lazy_cuts", transitivity->lazyRows() );
+     report.set( "transitivity", "user_cuts", transitivity->userRows() );
+     report.set( "transitivity", "separations",
+                 transitivity->separations() );
+     report.set( "transitivity", "separation_time",
+                 transitivity->separationTime() );
+   }
+   if( packing_cuts ) {
+     out << "PackingCutCalls\t" << packing_cuts->calls() << endl;
+     report.set( "packing_cuts", "calls", packing_cuts->calls() );
+     out << "PackingCliqueCuts\t"
+         << packing_cuts->cuts( PackingCutSeparator::CLIQUE ) << endl;
+     out << "PackingCliqueTime\t"
+         << packing_cuts->time( PackingCutSeparator::CLIQUE ) << endl;
+     out << "PackingOddHoleCuts\t"
+         << packing_cuts->cuts( PackingCutSeparator::ODD_HOLE ) << endl;
+     out << "PackingOddHoleTime\t"
+         << packing_cuts->time( PackingCutSeparator::ODD_HOLE ) << endl;
+     for( int f = 0; f < PackingCutSeparator::NUMBER_OF_FAMILIES; ++f ) {
+       PackingCutSeparator::Family family
+         = static_cast<PackingCutSeparator::Family>( f );
+       string name = PackingCutSeparator::familyName( family );
+       report.set( "packing_cuts", name + "_cuts",
+                   packing_cuts->cuts( family ) );
+       report.set( "packing_cuts", name + "_time",
+                   packing_cuts->time( family ) );
+     }
+   }
+
+   ostringstream status_name;
+   status_name << solution_status;
+   report.set( "status", "code", status_name.str() );
+   report.set( "status", "timed_out", timed_out == IloTrue );
+   report.set( "status", "solution_found", solution_found == IloTrue );
+   report.set( "status", "proved_optimal", proved_optimal == IloTrue );
+   report.set( "timings", "runtime", runtime_timer.getTotalTime() );
+   if( profiler.cpuTimes() ) {
+     report.set( "timings", "runtime_cpu", runtime_timer.getCpuTime() );
+   }
+   report.set( "timings", "cplex", cplex.getTime() );
+   report.set( "counts", "branches", static_cast<long>( cplex.getNnodes() ) );
+   report.set( "counts", "iterations",
+               static_cast<long>( cplex.getNiterations() ) );
+   report.set( "cuts", "frac",
+               static_cast<long>( cplex.getNcuts( IloCplex::CutFrac ) ) );
+   report.set( "cuts", "clique",
+               static_cast<long>( cplex.getNcuts( IloCplex::CutClique ) ) );
+   report.set( "cuts", "cover",
+               static_cast<long>( cplex.getNcuts( IloCplex::CutCover ) ) );
    if( solution_found ) {
-      cout << cplex.getObjValue();
+     report.set( "bounds", "value", cplex.getObjValue() );
+   }
+   if( ! solve_as_lp ) {
+     report.set( "bounds", "best_bound", cplex.getBestObjValue() );
+     if( solution_found ) {
+       report.set( "bounds", "gap", cplex.getMIPRelativeGap() );
+     }
+   }
+
+   // values of the variables of the original model, if it was reduced
+   vector<double> original_values;
+   if( reduced && solution_found ) {
+     IloNumArray vals( env );
+     cplex.getValues( vals, var );
+     vector<double> reduced_values( vals.getSize() );
+     for( int i = 0; i < vals.getSize(); ++i ) {
+       reduced_values[ i ] = vals[ i ];
+     }
+     vals.end();
+     original_values = reduction.postsolve( reduced_values );
+   }
+
+   // -check: evaluate the solution found against the parsed model, with
+   // none of CPLEX's tolerances
+   if( command_line.flagPresent( "check" ) && solution_found ) {
+     if( ! have_lp_model ) {
+       cerr << "Warning: -check needs a file the native LP reader can"
+            << " handle -- not checking" << endl;
+     }
+     else {
+       vector<double> values = original_values;
+       if( ! reduced ) {
+         IloNumArray vals( env );
+         cplex.getValues( vals, var );
+         for( int i = 0; i < vals.getSize(); ++i ) {
+           values.push_back( vals[ i ] );
+         }
+         vals.end();
+       }
+       SolutionChecker checker( *original_lp_model );
+       checker.check( values, checkTolerance( command_line ), solve_as_lp );
+       printCheck( out, report, *original_lp_model, checker, true,
+                   cplex.getObjValue() );
+     }
    }
-   cout << endl;
-   cout << "iterations   \t" << cplex.getNiterations() << endl;
-   cout << "frac_cuts    \t" << cplex.getNcuts(IloCplex::CutFrac) << endl;
-   cout << "clique_cuts  \t" << cplex.getNcuts(IloCplex::CutClique) << endl;
-   cout << "cover_cuts   \t" << cplex.getNcuts(IloCplex::CutCover) << endl;
 
    if( command_line.flagPresent( "verify" ) && solution_found ) {
+     vector<double> vals = original_values;
+     if( ! reduced ) {
+       IloNumArray reduced_vals( env );
+       cplex.getValues( reduced_vals, var );
+       for( int i = 0; i < reduced_vals.getSize(); ++i ) {
+         vals.push_back( reduced_vals[ i ] );
+       }
+       reduced_vals.end();
+     }
      if( solve_as_lp ) { // linear program
-       IloNumArray vals( env );
-       cplex.getValues( vals, var );
-       cout << "Solution" << endl;
-       for( int i = 0; i < vals.getSize(); ++i ) {
-         cout << "x" << setw( 5 ) << setfill( '0' ) << i
+       out << "Solution" << endl;
+       for( size_t i = 0; i < vals.size(); ++i ) {
+         out << "x" << setw( 5 ) << setfill( '0' ) << i
                    << setfill( ' ' ) << "\t" << vals[ i ] << endl;
        }
      }
      else { // integer program
-       IloNumArray vals( env );
-       cplex.getValues( vals, var );
-       cout << "Solution\t";
-       for( int i = 0; i < vals.getSize(); ++i ) {
-         cout << static_cast< int >( vals[ i ] + 0.5 );
+       out << "Solution\t";
+       for( size_t i = 0; i < vals.size(); ++i ) {
+         out << static_cast< int >( vals[ i ] + 0.5 );
        }
-       cout << endl;
+       out << endl;
      } // end, integer program
    } // end, verify
 
-   if( command_line.flagPresent( "solution" ) && solution_found ) {
-     cout << "BeginSolution" << endl;
+   if( command_line.flagPresent( "solution" ) && solution_found && reduced ) {
+     // all columns of a reducible model are binary
+     out << "BeginSolution" << endl;
+     for( int j = 0; j < original_lp_model->numberOfColumns(); ++j ) {
+       out << original_lp_model->columnName( j ) << "\t"
+           << static_cast<int>( original_values[ j ] + 0.5 ) << endl;
+     }
+     out << "EndSolution" << endl;
+   }
+   else if( command_line.flagPresent( "solution" ) && solution_found ) {
+     out << "BeginSolution" << endl;
      for (IloModel::Iterator it(model); it.ok(); ++it) {
        IloExtractable e = *it;
        if ( e.isVariable() ) {
          IloNumVar v = e.asVariable();
          if ( v.getName() ) {
-           env.out() << v.getName() << "\t";
+           out << v.getName() << "\t";
            // apparently, CPLEX will output non-integer values for integer
            // variables
            if ( v.getType() == ILOBOOL || v.getType() == ILOINT ) {
              int value = cplex.getValue(v);
              if ( value > 0 ) 
-               env.out() << static_cast<int>(cplex.getValue(v) + 0.5);
+               out << static_cast<int>(cplex.getValue(v) + 0.5);
              else // need to round down for negative values
-               env.out() << static_cast<int>(cplex.getValue(v) - 0.5);
+               out << static_cast<int>(cplex.getValue(v) - 0.5);
            }
            else {
-             env.out() << cplex.getValue(v);
+             out << cplex.getValue(v);
            }
-           env.out() << endl;
+           out << endl;
          }
        }
      }
-     cout << "EndSolution" << endl;
+     out << "EndSolution" << endl;
    }  
 
-   env.end();
+   if( ! solution_file.empty() ) {
+     // the pool holds the other solutions found; the best few are kept
+     const size_t SOLUTIONS_KEPT = 10;
+     SolutionFile solutions;
+     if( solution_found ) {
+       storeSolutions( env, cplex, var, minimize, SOLUTIONS_KEPT, solutions );
+       if( ! solutions.write( solution_file ) ) {
+         cerr << "Warning: unable to write solutions: "
+              << solutions.errorMessage() << endl;
+       }
+     }
+     if( incumbent_saver && ! incumbent_saver->errorMessage().empty() ) {
+       cerr << "Warning: unable to save incumbent: "
+            << incumbent_saver->errorMessage() << endl;
+     }
+     out << "SolutionsWritten\t" << solutions.numberOfSolutions() << endl;
+     report.set( "warm_start", "solution_file", solution_file );
+     report.set( "warm_start", "solutions_written",
+                 static_cast<long>( solutions.numberOfSolutions() ) );
+     if( incumbent_saver ) {
+       report.set( "warm_start", "incumbents_saved",
+                   incumbent_saver->numberSaved() );
+     }
+   }
+
+   if( checkpointer ) {
+     SolutionFile solutions;
+     if( solution_found ) {
+       storeSolutions( env, cplex, var, minimize, Checkpointer::SOLUTIONS_KEPT,
+                       solutions );
+     }
+     checkpointer->save( runtime_timer.getTotalTime(), cplex.getNnodes(), true,
+                         cplex.getBestObjValue(), proved_optimal, solutions );
+     if( ! checkpointer->errorMessage().empty() ) {
+       cerr << "Warning: unable to write checkpoint: "
+            << checkpointer->errorMessage() << endl;
+     }
+     out << "Interrupted\t" << Checkpointer::interrupted() << endl;
+     out << "CheckpointsWritten\t" << checkpointer->numberWritten() << endl;
+     report.set( "checkpoint", "interrupted", Checkpointer::interrupted() );
+     report.set( "checkpoint", "written", checkpointer->numberWritten() );
+   }
+   if( resumed || checkpointer ) {
+     // totals over all jobs on the instance, this one included
+     const Checkpoint & total = checkpointer ? checkpointer->last()
+       : previous.advance( runtime_timer.getTotalTime(), cplex.getNnodes(),
+                           true, cplex.getBestObjValue(), proved_optimal,
+                           SolutionFile(), 0 );
+     out << "TotalJobs\t" << total.jobs() << endl;
+     out << "TotalElapsed\t" << total.elapsed() << endl;
+     out << "TotalNodes\t" << total.nodes() << endl;
+     out << "CombinedBestBound\t" << total.bestBound() << endl;
+     report.set( "checkpoint", "total_jobs", total.jobs() );
+     report.set( "checkpoint", "total_elapsed", total.elapsed() );
+     report.set( "checkpoint", "total_nodes",
+                 static_cast<long>( total.nodes() ) );
+     report.set( "checkpoint", "combined_best_bound", total.bestBound() );
+   }
+
+   ProgressSample last_sample;
+   if( progress_trace ) {
+     // the final state, so that the trace covers the whole solve
+     last_sample.time = progress_trace->elapsed();
+     last_sample.best_bound = cplex.getBestObjValue();
+     last_sample.incumbent = solution_found ? cplex.getObjValue() : NAN;
+     last_sample.gap = solution_found ? cplex.getMIPRelativeGap() : NAN;
+     last_sample.nodes = cplex.getNnodes();
+     last_sample.open_nodes = cplex.getNnodesLeft();
+     last_sample.iterations = cplex.getNiterations();
+     progress_trace->record( last_sample );
+   }
+   if( progress_trace && command_line.flagPresent( "progress" ) ) {
+     string progress_file = command_line.stringFlag( "progress" );
+     if( ! progress_trace->write( progress_file ) ) {
+       cerr << "Warning: unable to write progress trace: "
+            << progress_trace->errorMessage() << endl;
+     }
+     out << "ProgressSamples\t" << progress_trace->size() << endl;
+     out << "ProgressDropped\t" << progress_trace->dropped() << endl;
+     report.set( "progress", "file", progress_file );
+     report.set( "progress", "samples",
+                 static_cast<long>( progress_trace->size() ) );
+     report.set( "progress", "dropped",
+                 static_cast<long>( progress_trace->dropped() ) );
+   }
+   if( progress_metrics ) {
+     // the best solution found serves as the reference for both integrals
+     progress_metrics->finish( last_sample.time, last_sample.incumbent );
+     printMetric( out, report, "PrimalIntegral", "primal_integral",
+                  progress_metrics->primalIntegral() );
+     printMetric( out, report, "DualIntegral", "dual_integral",
+                  progress_metrics->dualIntegral() );
+     printMetric( out, report, "TimeToFirstIncumbent", "first_incumbent",
+                  progress_metrics->timeToFirstIncumbent() );
+     printMetric( out, report, "TimeToTarget", "target",
+                  progress_metrics->timeToTarget() );
+     for( size_t i = 0; i < progress_metrics->gapThresholds().size(); ++i ) {
+       ostringstream percent;
+       percent << 100 * progress_metrics->gapThresholds()[ i ];
+       printMetric( out, report, "TimeToGap" + percent.str(),
+                    "gap_" + percent.str(), progress_metrics->timeToGap( i ) );
+     }
+   }
+
+   profiler.end();
+   printPhases( out, report, profiler );
+   emitReport( command_line, report, input_file_string, out );
+
+   if( racer ) {
+     racer->race->finish( racer->index, proved_optimal, solution_found,
+                          solution_found ? cplex.getObjValue() : 0 );
+     racer->race->detach( racer->index );
+   }
+
+   cplex.end();
+   rng.endElements();
+   var.endElements();
+   obj.end();
+   model.end();
    return 0;
-}  // END main
+}  // END solveInstance
+
+/// Prints a -metrics tag and adds it to the metrics section of the report;
+/// a time that was never reached (NaN) is printed as an empty value.
+static void printMetric( ostream & out, RunReport & report, const string tag,
+                         const string key, double value )
+{
+   out << tag << "\t";
+   if( ! std::isnan( value ) ) {
+     out << value;
+   }
+   out << endl;
+   report.set( "metrics", key, value );
+}
+
+/// Prints the phase_* tags and adds the times to the phases section of the
+/// report.
+static void printPhases( ostream & out, RunReport & report,
+                         const PhaseProfiler & profiler )
+{
+   profiler.print( out );
+   for( size_t i = 0; i < profiler.numberOfPhases(); ++i ) {
+     report.set( "phases", profiler.name( i ), profiler.wallTime( i ) );
+     if( profiler.cpuTimes() ) {
+       report.set( "phases", profiler.name( i ) + "_cpu",
+                   profiler.cpuTime( i ) );
+     }
+   }
+}
+
+/// Prints the result tags of a solve that was not done by CPLEX itself
+/// (-decompose, -engine=native), in the same form, and adds them to the
+/// report.
+static void printResult( ostream & out, RunReport & report,
+                         const string & status,
+                         const ClockTimer & runtime_timer, bool cpu_time,
+                         bool timed_out, bool solution_found,
+                         bool proved_optimal, double value )
+{
+   out << "StatusCode\t_" << status << endl;
+   out << "runtime      \t" << runtime_timer.getTotalTime() << endl;
+   if( cpu_time ) {
+     out << "runtime_cpu  \t" << runtime_timer.getCpuTime() << endl;
+   }
+   out << "TimedOut\t" << timed_out << endl;
+   out << "SolutionFound\t" << solution_found << endl;
+   out << "ProvedOptimal\t" << proved_optimal << endl;
+   out << "value      \t";
+   if( solution_found ) {
+     out << value;
+   }
+   out << endl;
+   report.set( "status", "code", status );
+   report.set( "status", "timed_out", timed_out );
+   report.set( "status", "solution_found", solution_found );
+   report.set( "status", "proved_optimal", proved_optimal );
+   report.set( "timings", "runtime", runtime_timer.getTotalTime() );
+   if( cpu_time ) {
+     report.set( "timings", "runtime_cpu", runtime_timer.getCpuTime() );
+   }
+   if( solution_found ) {
+     report.set( "bounds", "value", value );
+   }
+}
+
+/// Prints the counts of a CPLEX run, for a run that solved the model
+/// without a single CPLEX solve (native engine, components).
+static void printCounts( ostream & out, RunReport & report, double cplex_time,
+                         long branches, long iterations, long frac_cuts,
+                         long clique_cuts, long cover_cuts )
+{
+   out << "CPXtime \t" << cplex_time << endl;
+   out << "num_branches \t" << branches << endl;
+   out << "iterations   \t" << iterations << endl;
+   out << "frac_cuts    \t" << frac_cuts << endl;
+   out << "clique_cuts  \t" << clique_cuts << endl;
+   out << "cover_cuts   \t" << cover_cuts << endl;
+   report.set( "timings", "cplex", cplex_time );
+   report.set( "counts", "branches", branches );
+   report.set( "counts", "iterations", iterations );
+   report.set( "cuts", "frac", frac_cuts );
+   report.set( "cuts", "clique", clique_cuts );
+   report.set( "cuts", "cover", cover_cuts );
+}
+
+/// Prints the winner of a -root_lp=race and the time, iterations and
+/// status of each racer.
+static void printRootLpRace( ostream & out, RunReport & report,
+                             const RootLpRace & race )
+{
+   int winner = race.winner();
+   string winner_name
+     = winner >= 0 ? race.racers()[ winner ].algorithm : "none";
+   out << "RootLpRaceWinner\t" << winner_name << endl;
+   out << "RootLpRaceBasis\t" << race.hasBasis() << endl;
+   out << "RootLpRaceThreads\t" << race.threadsPerRacer() << endl;
+   out << "RootLpRaceTime\t" << race.time() << endl;
+   report.set( "root_lp", "winner", winner_name );
+   report.set( "root_lp", "basis", race.hasBasis() );
+   report.set( "root_lp", "race_time", race.time() );
+   for( size_t r = 0; r < race.racers().size(); ++r ) {
+     const RootLpRace::Racer & racer = race.racers()[ r ];
+     out << "RootLpRacer_" << racer.algorithm << "\t" << racer.time
+         << "\t" << racer.iterations << "\t" << racer.status << endl;
+     report.set( "root_lp", racer.algorithm + "_time", racer.time );
+     report.set( "root_lp", racer.algorithm + "_iterations",
+                 racer.iterations );
+     report.set( "root_lp", racer.algorithm + "_status", racer.status );
+   }
+}
+
+/// @return starts, each permuted by symmetry into the equivalent solution
+/// that satisfies the symmetry-breaking rows, which CPLEX would otherwise
+/// reject; a start that doesn't give all values of an orbit is left as
+/// it is (with a warning)
+static SolutionFile symmetricStarts( const SymmetryDetector & symmetry,
+                                     const LpModel & model,
+                                     const SolutionFile & starts )
+{
+   SolutionFile mapped;
+   size_t unmapped = 0;
+   for( size_t s = 0; s < starts.numberOfSolutions(); ++s ) {
+     const StoredSolution & start = starts.solution( s );
+     vector<double> x( model.numberOfColumns(),
+                       numeric_limits<double>::quiet_NaN() );
+     StoredSolution image;
+     image.has_value = start.has_value;
+     image.value = start.value;
+     for( size_t k = 0; k < start.values.size(); ++k ) {
+       int j = model.findColumn( start.values[ k ].first );
+       if( j >= 0 ) x[ j ] = start.values[ k ].second;
+       else image.values.push_back( start.values[ k ] );
+     }
+     if( ! symmetry.representative( x ) ) {
+       ++unmapped;
+       mapped.add( start );
+       continue;
+     }
+     for( int j = 0; j < model.numberOfColumns(); ++j ) {
+       if( ! std::isnan( x[ j ] ) ) {
+         image.values.push_back( make_pair( model.columnName( j ), x[ j ] ) );
+       }
+     }
+     mapped.add( image );
+   }
+   if( unmapped > 0 ) {
+     cerr << "Warning: " << unmapped << " MIP starts don't give every value"
+          << " of the symmetric columns -- they may violate the symmetry"
+          << " rows" << endl;
+   }
+   return mapped;
+}
+
+/// Handles -check, -solution and -write_sol for a solution found without
+/// CPLEX: values are those of the columns of model, the model as read.
+static void emitSolution( ostream & out, RunReport & report,
+                          const CmdLine & command_line, const LpModel & model,
+                          const vector<double> & values, double value,
+                          const string & input_file_string )
+{
+   if( command_line.flagPresent( "check" ) ) {
+     SolutionChecker checker( model );
+     checker.check( values, checkTolerance( command_line ),
+                    command_line.flagPresent( "lp_only" ) );
+     printCheck( out, report, model, checker, true, value );
+   }
+   if( command_line.flagPresent( "solution" ) ) {
+     out << "BeginSolution" << endl;
+     for( int j = 0; j < model.numberOfColumns(); ++j ) {
+       out << model.columnName( j ) << "\t" << values[ j ] << endl;
+     }
+     out << "EndSolution" << endl;
+   }
+   if( command_line.flagPresent( "write_sol" ) ) {
+     StoredSolution solution;
+     solution.has_value = true;
+     solution.value = value;
+     for( int j = 0; j < model.numberOfColumns(); ++j ) {
+       solution.values.push_back( make_pair( model.columnName( j ),
+                                             values[ j ] ) );
+     }
+     SolutionFile solutions;
+     solutions.add( solution );
+     string solution_file
+       = SolutionFile::instanceFileName( command_line.stringFlag( "write_sol" ),
+                                         getBasename( input_file_string ) );
+     if( ! solutions.write( solution_file ) ) {
+       cerr << "Warning: unable to write solutions: "
+            << solutions.errorMessage() << endl;
+     }
+   }
+}
+
+/// @return the largest resident set size of the process so far, in MB
+static double peakMemoryMB()
+{
+   struct rusage usage;
+   if( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+     return 0;
+   }
+#ifdef __APPLE__
+   return usage.ru_maxrss / ( 1024.0 * 1024.0 ); // bytes
+#else
+   return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+}
+
+/// @return the tolerance of -check: -check_tol=TOL, default 1e-6
+static double checkTolerance( const CmdLine & command_line )
+{
+   double tolerance = 1e-6;
+   if( command_line.flagPresent( "check_tol" ) ) {
+     tolerance = command_line.doubleFlag( "check_tol" );
+   }
+   return tolerance;
+}
+
+/// @return the exit status for the first flag whose value is out of range,
+/// after saying so on cerr; 0 if all values are fine
+static int badFlagValue( const CmdLine & command_line )
+{
+   if( command_line.flagPresent( "time" )
+       && command_line.intFlag( "time" ) <= 0 ) {
+     cerr << "Bad timeout value " << command_line.stringFlag( "time" )
+          << " -- should be int > 0." << endl;
+     return 110;
+   }
+   if( command_line.flagPresent( "nodes" )
+       && command_line.intFlag( "nodes" ) <= 0 ) {
+     cerr << "Bad node limit value " << command_line.stringFlag( "nodes" )
+          << " -- should be int > 0." << endl;
+     return 120;
+   }
+   if( command_line.flagPresent( "sols" )
+       && command_line.intFlag( "sols" ) <= 0 ) {
+     cerr << "Bad solution limit value " << command_line.stringFlag( "sols" )
+          << " -- should be int > 0." << endl;
+     return 130;
+   }
+   if( command_line.flagPresent( "dep" ) ) {
+     int dependence_indicator = command_line.intFlag( "dep" );
+     if( dependence_indicator < -1 || dependence_indicator > 3 ) {
+       cerr << "Bad dependence indicator " << command_line.stringFlag( "dep" )
+            << " -- should be -1, 0, 1, 2, or 3." << endl;
+       return 133;
+     }
+   }
+   if( command_line.flagPresent( "feasible" ) ) {
+     int emphasis = command_line.intFlag( "feasible" );
+     if( emphasis < 0 || emphasis > 4 ) {
+       cerr << "Bad feasibility indicator "
+            << command_line.stringFlag( "feasible" )
+            << " -- should be 0, 1, 2, 3, or 4." << endl;
+       return 135;
+     }
+   }
+   if( ( command_line.flagPresent( "progress" )
+         || command_line.flagPresent( "metrics" ) )
+       && ( ( command_line.flagPresent( "progress_interval" )
+              && command_line.doubleFlag( "progress_interval" ) < 0 )
+            || ( command_line.flagPresent( "progress_size" )
+                 && command_line.intFlag( "progress_size" ) <= 0 ) ) ) {
+     cerr << "Bad progress interval or size -- should be >= 0 and > 0."
+          << endl;
+     return 140;
+   }
+   if( command_line.flagPresent( "checkpoint" )
+       && command_line.flagPresent( "checkpoint_every" )
+       && command_line.doubleFlag( "checkpoint_every" ) <= 0 ) {
+     cerr << "Bad checkpoint interval "
+          << command_line.stringFlag( "checkpoint_every" )
+          << " -- should be > 0." << endl;
+     return 150;
+   }
+   if( command_line.flagPresent( "check_tol" )
+       && command_line.doubleFlag( "check_tol" ) < 0 ) {
+     cerr << "Bad check tolerance " << command_line.stringFlag( "check_tol" )
+          << " -- should be >= 0." << endl;
+     return 152;
+   }
+   if( command_line.flagPresent( "engine" )
+       && command_line.stringFlag( "engine" ) != "cplex"
+       && command_line.stringFlag( "engine" ) != "native" ) {
+     cerr << "Bad engine " << command_line.stringFlag( "engine" )
+          << " -- should be cplex or native." << endl;
+     return 154;
+   }
+
+   // budgets in seconds (milliseconds for -packing_cuts), where a bare
+   // flag means the default
+   const char * budgets[][2] = {
+     { "cover_heur", "Bad heuristic time " },
+     { "symmetry", "Bad symmetry detection time " },
+     { "lagrangian", "Bad Lagrangian time " },
+     { "packing_cuts", "Bad packing cut time " } };
+   const int budget_status[] = { 151, 153, 155, 156 };
+   for( int b = 0; b < 4; ++b ) {
+     if( command_line.flagPresent( budgets[b][0] )
+         && command_line.stringFlag( budgets[b][0] ) != "0"
+         && command_line.doubleFlag( budgets[b][0] ) <= 0 ) {
+       cerr << budgets[b][1] << command_line.stringFlag( budgets[b][0] )
+            << " -- should be > 0." << endl;
+       return budget_status[b];
+     }
+   }
+   return 0;
+}
+
+/// Adds the root_lp_* features: time, iterations and value of the LP
+/// relaxation and the fraction of integer columns that are fractional in
+/// its solution.
+static void rootLpFeatures( IloEnv env, const LpModel & lp_model,
+                            ModelFeatures & features )
+{
+   IloModel model( env );
+   IloObjective obj;
+   IloNumVarArray var( env );
+   IloRangeArray rng( env );
+   try {
+     loadModel( env, lp_model, model, obj, var, rng );
+     model.add( IloConversion( env, var, ILOFLOAT ) );
+     IloCplex cplex( model );
+     cplex.setOut( env.getNullStream() );
+     ClockTimer lp_timer = ClockTimer();
+     lp_timer.start();
+     bool solved = cplex.solve();
+     lp_timer.stop();
+     features.add( "root_lp_solved", solved );
+     features.add( "root_lp_time", lp_timer.getTotalTime() );
+     features.add( "root_lp_iterations", cplex.getNiterations() );
+     if( solved ) {
+       features.add( "root_lp_value", cplex.getObjValue() );
+       IloNumArray vals( env );
+       cplex.getValues( vals, var );
+       int integer_columns = 0;
+       int fractional = 0;
+       for( int j = 0; j < lp_model.numberOfColumns(); ++j ) {
+         if( ! lp_model.isInteger( j ) ) {
+           continue;
+         }
+         ++integer_columns;
+         if( fabs( vals[ j ] - floor( vals[ j ] + 0.5 ) ) > 1e-6 ) {
+           ++fractional;
+         }
+       }
+       features.add( "root_lp_fractional_fraction",
+                     integer_columns > 0
+                     ? static_cast<double>( fractional ) / integer_columns : 0 );
+       vals.end();
+     }
+     cplex.end();
+   }
+   catch ( IloException & e ) {
+     cerr << "Warning: no root LP features: " << e.getMessage() << endl;
+     e.end();
+   }
+   rng.endElements();
+   var.endElements();
+   model.end();
+}
+
+/// Prints the Check* tags for the last solution checked and adds them to
+/// the check section of the report; the reported value, if any, is the
+/// one the solver (or the solution file) gave.
+static void printCheck( ostream & out, RunReport & report,
+                        const LpModel & model, const SolutionChecker & checker,
+                        bool has_reported_value, double reported_value )
+{
+   out << "CheckFeasible\t" << checker.feasible() << endl;
+   out << "CheckMaxViolation\t" << checker.maxViolation() << endl;
+   out << "CheckViolatedRows\t" << checker.violatedRows() << endl;
+   out << "CheckWorstRow\t";
+   if( checker.worstRow() >= 0 ) {
+     out << model.rowName( checker.worstRow() );
+   }
+   out << endl;
+   out << "CheckBoundViolations\t" << checker.boundViolations() << endl;
+   out << "CheckIntegralityViolations\t" << checker.integralityViolations()
+       << endl;
+   out << "CheckObjective\t" << setprecision( 17 ) << checker.objective()
+       << setprecision( 6 ) << endl;
+   out << "CheckObjectiveError\t";
+   if( has_reported_value ) {
+     out << fabs( checker.objective() - reported_value );
+   }
+   out << endl;
+   out << "CheckExact\t" << checker.exact() << endl;
+   out << "CheckTime\t" << checker.checkTime() << endl;
+   report.set( "check", "feasible", checker.feasible() );
+   report.set( "check", "max_violation", checker.maxViolation() );
+   report.set( "check", "violated_rows", checker.violatedRows() );
+   report.set( "check", "bound_violations", checker.boundViolations() );
+   report.set( "check", "max_bound_violation", checker.maxBoundViolation() );
+   report.set( "check", "integrality_violations",
+               checker.integralityViolations() );
+   report.set( "check", "max_integrality_violation",
+               checker.maxIntegralityViolation() );
+   report.set( "check", "objective", checker.objective() );
+   if( has_reported_value ) {
+     report.set( "check", "objective_error",
+                 fabs( checker.objective() - reported_value ) );
+   }
+   report.set( "check", "exact", checker.exact() );
+   report.set( "check", "time", checker.checkTime() );
+}
+
+/// Ends a run that failed before solving (the input couldn't be read, a
+/// flag value is bad): says why on cerr and reports status ERROR, like a
+/// failed solve.
+static void emitError( ostream & out, RunReport & report,
+                       const CmdLine & command_line,
+                       const string input_file_string,
+                       PhaseProfiler & profiler, const string & message )
+{
+   cerr << message << endl;
+   profiler.end();
+   out << "StatusCode\t_ERROR" << endl;
+   report.set( "status", "code", "ERROR" );
+   report.set( "status", "message", message );
+   printPhases( out, report, profiler );
+   emitReport( command_line, report, input_file_string, out );
+}
+
+/// With -report=json, prints the report as one line of out; with
+/// -report_dir=DIR, writes it to a file of its own in DIR instead.
+static void emitReport( const CmdLine & command_line, const RunReport & report,
+                        const string input_file_string, ostream & out )
+{
+   if( command_line.flagPresent( "report_dir" ) ) {
+     RunReport file_report = report;
+     if( ! file_report.writeToDirectory( command_line.stringFlag( "report_dir" ),
+                                         getBasename( input_file_string ) ) ) {
+       cerr << "Warning: unable to write report: "
+            << file_report.errorMessage() << endl;
+     }
+   }
+   else if( command_line.flagPresent( "report" ) ) {
+     if( command_line.stringFlag( "report" ) != "json" ) {
+       cerr << "Warning: unknown report format "
+            << command_line.stringFlag( "report" ) << " -- using json"
+            << endl;
+     }
+     // a single write, so that the line is never interleaved with others
+     out << report.toJson() + "\n" << flush;
+   }
+}
 
 
 static void usage ( const char *progname )
 {
    cerr << "Usage: " << progname << " [flags] inputfile" << endl;
+   cerr << "   or:  " << progname << " -batch[=LISTFILE] [flags] [inputfile ...]" << endl;
+   cerr << "   or:  " << progname << " -sweep=GRIDFILE [-batch=LISTFILE] [flags] [inputfile ...]" << endl;
+   cerr << "   or:  " << progname << " -portfolio[=N|CONFIGFILE] [flags] inputfile" << endl;
    cerr << "   where inputfile is a file in mps or lp format." << endl;
    cerr << "   Flags are 0 or more of the following, in any order:" << endl;
    cerr << "     -cost=<int>        stop when solution has this cost" << endl;
@@ -602,8 +2722,55 @@ static void usage ( const char *progname )
         << endl;
    cerr << "         f = sifting"
         << endl;
+   cerr << "     -root_lp=[apdbfc]  algorithm for the root LP (or the LP of -lp_only):" << endl
+        << "                         auto, primal, dual, barrier, sifting or concurrent;" << endl
+        << "                         race (with -lp_only) races primal, dual and barrier" << endl
+        << "                         in threads and prints the time of each" << endl;
+   cerr << "     -crossover=[napd]  crossover after barrier: none, auto, primal, dual" << endl;
    cerr << "     -verify            print solution as a string of 0's and 1's (for verification)"
         << endl;
+   cerr << "     -mipstart=FILE     use the solutions in FILE (as printed by -solution or" << endl
+        << "                         written by -write_sol) as MIP starts" << endl;
+   cerr << "     -write_sol=FILE    write the best solutions to FILE (rewritten at each" << endl
+        << "                         new incumbent); % in FILE stands for the instance" << endl;
+   cerr << "     -checkpoint=PATH   save incumbents, best bound and totals in PATH every" << endl
+        << "                         -checkpoint_every=SEC seconds (default 600), on" << endl
+        << "                         SIGTERM/SIGUSR1 (which stop the run) and at the end" << endl;
+   cerr << "     -resume=PATH       continue from the checkpoint in PATH, if any" << endl;
+   cerr << "     -prereduce         remove dominated and duplicate rows and columns of set" << endl
+        << "                         covering/packing models before solving" << endl;
+   cerr << "     -cover_heur[=SEC]  run a greedy + local search heuristic for SEC seconds" << endl
+        << "                         (default 1) on a set covering model and start" << endl
+        << "                         from its solution" << endl;
+   cerr << "     -lazy_rows         load only a greedy cover of the columns by rows and" << endl
+        << "                         add the other rows when a solution violates them" << endl;
+   cerr << "     -lazy_transitivity leave out the 3-cycle rows of ordering models (x_i_j)" << endl
+        << "                         and add those violated as lazy constraints and cuts" << endl;
+   cerr << "     -packing_cuts[=MS] add clique and odd-hole cuts from the conflicts of" << endl
+        << "                         binary columns, spending about MS milliseconds" << endl
+        << "                         (default 10) per call" << endl;
+   cerr << "     -lagrangian[=SEC]  print a bound from the Lagrangian relaxation of all" << endl
+        << "                         rows (SEC seconds of subgradient steps, default 10)" << endl
+        << "                         instead of solving; -solution adds the multipliers" << endl;
+   cerr << "     -lagrangian_stop   give the Lagrangian bound to CPLEX, so that it stops" << endl
+        << "                         when a solution reaches it" << endl;
+   cerr << "     -engine=native     solve a set covering model with the built-in branch" << endl
+        << "                         and bound instead of CPLEX (no license needed)" << endl;
+   cerr << "     -symmetry[=SEC]    look for symmetries of the model for SEC seconds" << endl
+        << "                         (default 10) and add constraints x_i >= x_j that" << endl
+        << "                         break them (orbits of a stabilizer chain)" << endl;
+   cerr << "     -decompose         solve the connected components of the model as" << endl
+        << "                         separate problems, -workers at a time (with" << endl
+        << "                         -threads each); limits apply per component" << endl;
+   cerr << "     -features[=lp]     print statistics of the model (feature_* tags) instead" << endl
+        << "                         of solving; with lp, also those of the root LP" << endl;
+   cerr << "     -auto_params=FILE  choose the flags of the run (-nsel, -vsel, -lp, ...)" << endl
+        << "                         from the features of the instance with the model" << endl
+        << "                         in FILE (see train_params); given flags win" << endl;
+   cerr << "     -check[=FILE]      check the solution found against the model in exact or" << endl
+        << "                         high-precision arithmetic; with FILE, check the" << endl
+        << "                         solutions in FILE instead of solving" << endl;
+   cerr << "     -check_tol=TOL     violations above TOL count for -check (default 1e-6)" << endl;
    cerr << "     -solution          print solution with one variable/value pair per line" << endl
         << "                         between lines labeled BeginSolution and EndSolution"
         << endl;
@@ -630,6 +2797,73 @@ static void usage ( const char *progname )
         << endl;
    cerr << "     -t_freq=<int>       trace frequency (nodes between trace output)"
         << endl;
+   cerr << "     -parse_only        read the file with the native LP reader, report"
+        << endl
+        << "                         dimensions and ParseTime, and stop" << endl;
+   cerr << "     -cplex_reader      read the file with CPLEX importModel() instead"
+        << endl
+        << "                         of the native LP reader" << endl;
+   cerr << "     -threads=<int>     number of threads CPLEX may use (default = all cores)"
+        << endl;
+   cerr << "     -batch[=LISTFILE]  solve all files on the command line and/or listed"
+        << endl
+        << "                         in LISTFILE (one per line, optionally followed by"
+        << endl
+        << "                         a known upper bound, passed on as -UB), several"
+        << endl
+        << "                         at a time; output is in the order given" << endl;
+   cerr << "     -workers=<int>     number of instances solved at the same time in"
+        << endl
+        << "                         batch mode (default = cores / threads)" << endl;
+   cerr << "     -sweep=GRIDFILE    run every combination of the flag values in"
+        << endl
+        << "                         GRIDFILE (lines: flag value ...) on every"
+        << endl
+        << "                         instance, as in batch mode; prints one CSV line"
+        << endl
+        << "                         per run" << endl;
+   cerr << "     -sweep_log=FILE    write the full output of every sweep run to FILE"
+        << endl;
+   cerr << "     -report=json       also print a one-line JSON object with the"
+        << endl
+        << "                         parameters, dimensions, status, timings, counts"
+        << endl
+        << "                         and bounds of the run (see report2csv)" << endl;
+   cerr << "     -report_dir=DIR    write the JSON report to a new file in DIR instead"
+        << endl;
+   cerr << "     -progress=FILE     record best bound, incumbent, gap, nodes and open"
+        << endl
+        << "                         nodes during the solve and write them to FILE"
+        << endl
+        << "                         (CSV, or binary if FILE ends in .bin)" << endl;
+   cerr << "     -progress_interval=<double>  seconds between samples (default 0.1;"
+        << endl
+        << "                         a new incumbent is always sampled)" << endl;
+   cerr << "     -progress_size=<int>  samples kept; older ones are overwritten"
+        << endl
+        << "                         (default 65536)" << endl;
+   cerr << "     -metrics           report PrimalIntegral, DualIntegral,"
+        << endl
+        << "                         TimeToFirstIncumbent, TimeToTarget (-cost, or"
+        << endl
+        << "                         else -UB) and TimeToGap10/TimeToGap1 (relative"
+        << endl
+        << "                         gap 10% / 1%), sampled as for -progress" << endl;
+   cerr << "     -portfolio[=N|CONFIGFILE]  race N built-in configurations (default 4)"
+        << endl
+        << "                         or those in CONFIGFILE (one set of flags per"
+        << endl
+        << "                         line) on the cores, sharing incumbents; stops"
+        << endl
+        << "                         when one proves optimality and reports it as"
+        << endl
+        << "                         PortfolioWinner" << endl;
+   cerr << "     -cache[=DIR]       keep a binary copy of the parsed model (.lpxb)"
+        << endl
+        << "                         next to the input file or in DIR and read it"
+        << endl
+        << "                         instead of the input file when up to date"
+        << endl;
 } // END usage
 
-//  [Last modified: 2021 06 02 at 17:04:26 GMT]
+//  [Last modified: 2026 10 18 at 09:31:12 GMT]
@@ -0,0 +1,90 @@
+/// @file report2csv.cpp collects the JSON run reports of cplex_ilp
+///                      (-report=json or -report_dir=DIR) into one table
+///
+/// Usage: report2csv [-columns=DIR] [-delimiter=C] (REPORT_DIR | FILE) ...
+///
+/// Every .json file in each REPORT_DIR and every FILE is read once; each
+/// line that starts with { is one report, so the full output of cplex_ilp
+/// with -report=json, with tag/value lines in between, can be given as a
+/// FILE. Nested members become columns named section.key, in order of
+/// first appearance; true/false become 1/0, as in the tag/value output,
+/// and members missing from a report are left empty. The table goes to
+/// stdout as CSV or, with -columns=DIR, to DIR as one file per column
+/// (NAME.col, one value per line) plus a list of the columns (_columns).
+///
+/// @date 2026/10/17
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include<cstdlib>
+#include"CmdLine.h"
+#include"ReportTable.h"
+
+using namespace std;
+
+static void usage( const char * progname )
+{
+  cerr << "Usage: " << progname
+       << " [-columns=DIR] [-delimiter=C] (REPORT_DIR | FILE) ..." << endl;
+  cerr << "  reads the JSON reports of cplex_ilp -report=json / -report_dir"
+       << endl
+       << "  (all .json files in each REPORT_DIR, every line starting with {"
+       << endl
+       << "  in each FILE) and prints them as a CSV table, one row per report"
+       << endl;
+  cerr << "  -columns=DIR    write one file per column to DIR instead" << endl;
+  cerr << "  -delimiter=C    separate fields with C instead of ," << endl;
+}
+
+int main( int argc, char * argv[] )
+{
+  CmdLine command_line( argc, argv );
+  string_set expected_flags;
+  expected_flags.insert( "columns" );
+  expected_flags.insert( "delimiter" );
+  if ( ! command_line.flagsAreLegal( expected_flags )
+       || command_line.numberOfFiles() == 0 ) {
+    usage( argv[0] );
+    return EXIT_FAILURE;
+  }
+  char delimiter = ',';
+  if ( command_line.flagPresent( "delimiter" ) ) {
+    delimiter = command_line.stringFlag( "delimiter" )[0];
+  }
+
+  vector<string> file_names;
+  string_list arguments = command_line.getFiles();
+  for ( size_t i = 1; i < arguments.size(); ++i ) { // [0] is the command
+    if ( ! listReports( arguments[i], file_names ) ) {
+      file_names.push_back( arguments[i] );
+    }
+  }
+
+  ReportTable table;
+  ReportReader reader( table );
+  int bad_reports = 0;
+  int unreadable_files = 0;
+  for ( size_t f = 0; f < file_names.size(); ++f ) {
+    int bad = readReportFile( file_names[f], reader );
+    if ( bad < 0 ) ++unreadable_files;
+    else bad_reports += bad;
+  }
+
+  if ( command_line.flagPresent( "columns" ) ) {
+    string directory = command_line.stringFlag( "columns" );
+    if ( ! table.writeColumns( directory ) ) {
+      cerr << "Unable to write columns to " << directory << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  else table.writeCsv( cout, delimiter );
+  cerr << table.numberOfRows() << " reports from " << file_names.size()
+       << " files";
+  if ( bad_reports > 0 ) cerr << ", " << bad_reports << " malformed";
+  if ( unreadable_files > 0 ) cerr << ", " << unreadable_files << " unreadable";
+  cerr << endl;
+  return bad_reports == 0 && unreadable_files == 0 ? 0 : EXIT_FAILURE;
+}
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]
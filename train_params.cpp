@@ -0,0 +1,208 @@
+/// @file train_params.cpp builds the model file of cplex_ilp -auto_params
+///                        from the results of past runs
+///
+/// Usage: train_params [-k=K] [-penalty=P] MODEL_FILE (REPORT_DIR | FILE) ...
+///
+/// The runs are read as by report2csv: every .json file in each REPORT_DIR
+/// and every FILE, where a FILE ending in .csv is a table with a header
+/// line -- the output of report2csv, or of cplex_ilp -sweep -- and any
+/// other FILE holds JSON reports, one per line. A run counts if it has a
+/// runtime (timings.runtime, or runtime in a sweep table) and finished
+/// without error; its setting is made of the tuned flags it was run with
+/// (parameters.FLAG, or a column FLAG of a sweep table). The features of
+/// an instance come from any report that has a features section, e.g.
+/// one of cplex_ilp -features -report=json, and runs on instances without
+/// one are not used. Instances are identified by their base names.
+///
+/// See ParameterSelector.h for the model. K is the number of neighbors
+/// (default 5) and a run that timed out scores P times its runtime
+/// (default 10). A summary, with the mean score of the best single
+/// setting and of the selector (each instance left out in turn) on the
+/// instances run with every setting, goes to stdout.
+///
+/// @date 2026/10/17
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include<map>
+#include<cstdlib>
+#include<cmath>
+#include"CmdLine.h"
+#include"ReportTable.h"
+#include"ParameterSelector.h"
+
+using namespace std;
+
+static const string FEATURE_PREFIX = "features.";
+
+/// @return file_name without directory and extension
+static string base_name( const string & file_name )
+{
+  string::size_type start = file_name.find_last_of( '/' );
+  start = start == string::npos ? 0 : start + 1;
+  string::size_type end = file_name.find_last_of( '.' );
+  if ( end == string::npos || end < start ) end = file_name.size();
+  return file_name.substr( start, end - start );
+}
+
+static bool ends_with( const string & text, const string & suffix )
+{
+  return text.size() >= suffix.size()
+    && text.compare( text.size() - suffix.size(), suffix.size(), suffix ) == 0;
+}
+
+/// @return the value in row r of the first of the columns that is not
+/// empty (report columns first, then those of a sweep table)
+static string cell( const ReportTable & table, size_t r,
+                    const string & report_column, const string & sweep_column )
+{
+  string value = table.cell( r, table.column( report_column ) );
+  if ( value.empty() ) value = table.cell( r, table.column( sweep_column ) );
+  return value;
+}
+
+static void usage( const char * progname )
+{
+  cerr << "Usage: " << progname
+       << " [-k=K] [-penalty=P] MODEL_FILE (REPORT_DIR | FILE) ..." << endl;
+  cerr << "  builds the model file for cplex_ilp -auto_params=MODEL_FILE from"
+       << endl
+       << "  the JSON reports (all .json files in each REPORT_DIR, every line"
+       << endl
+       << "  starting with { in each FILE) and CSV tables (FILE ending in .csv)"
+       << endl
+       << "  of past runs, together with reports of cplex_ilp -features"
+       << endl;
+  cerr << "  -k=K          number of neighbors (default 5)" << endl;
+  cerr << "  -penalty=P    a run that timed out scores P times its runtime"
+       << " (default 10)" << endl;
+}
+
+int main( int argc, char * argv[] )
+{
+  CmdLine command_line( argc, argv );
+  string_set expected_flags;
+  expected_flags.insert( "k" );
+  expected_flags.insert( "penalty" );
+  if ( ! command_line.flagsAreLegal( expected_flags )
+       || command_line.numberOfFiles() < 2 ) {
+    usage( argv[0] );
+    return EXIT_FAILURE;
+  }
+  ParameterSelector selector;
+  if ( command_line.flagPresent( "k" ) ) {
+    int k = command_line.intFlag( "k" );
+    if ( k <= 0 ) {
+      cerr << "Bad number of neighbors " << command_line.stringFlag( "k" )
+           << " -- should be > 0." << endl;
+      return EXIT_FAILURE;
+    }
+    selector.setNeighbors( k );
+  }
+  if ( command_line.flagPresent( "penalty" ) ) {
+    selector.setTimeoutPenalty( command_line.doubleFlag( "penalty" ) );
+  }
+
+  string_list arguments = command_line.getFiles();
+  string model_file = arguments[1];  // [0] is the command
+  vector<string> file_names;
+  for ( size_t i = 2; i < arguments.size(); ++i ) {
+    if ( ! listReports( arguments[i], file_names ) ) {
+      file_names.push_back( arguments[i] );
+    }
+  }
+  ReportTable table;
+  ReportReader reader( table );
+  int bad_lines = 0;
+  int unreadable_files = 0;
+  for ( size_t f = 0; f < file_names.size(); ++f ) {
+    int bad = ends_with( file_names[f], ".csv" )
+      ? readCsvFile( file_names[f], table )
+      : readReportFile( file_names[f], reader );
+    if ( bad < 0 ) ++unreadable_files;
+    else bad_lines += bad;
+  }
+
+  map<string, ModelFeatures> features;
+  vector<TrainingRun> runs;
+  size_t failed_runs = 0;
+  for ( size_t r = 0; r < table.numberOfRows(); ++r ) {
+    string instance = table.cell( r, table.column( "run.instance" ) );
+    if ( instance.empty() ) {
+      instance = base_name( table.cell( r, table.column( "instance" ) ) );
+    }
+    if ( instance.empty() ) continue;
+    for ( size_t c = 0; c < table.numberOfColumns(); ++c ) {
+      const string & name = table.columnName( c );
+      const string & value = table.cell( r, c );
+      if ( value.empty() || name.compare( 0, FEATURE_PREFIX.size(),
+                                          FEATURE_PREFIX ) != 0 ) {
+        continue;
+      }
+      features[ instance ].add( name.substr( FEATURE_PREFIX.size() ),
+                                atof( value.c_str() ) );
+    }
+
+    string runtime = cell( table, r, "timings.runtime", "runtime" );
+    if ( runtime.empty() ) continue;
+    string exit_status = table.cell( r, table.column( "exit_status" ) );
+    if ( table.cell( r, table.column( "status.code" ) ) == "ERROR"
+         || (! exit_status.empty() && exit_status != "0") ) {
+      ++failed_runs;
+      continue;
+    }
+    FlagList flags;
+    for ( const char * const * tuned = ParameterSelector::TUNED_FLAGS;
+          *tuned; ++tuned ) {
+      string value = cell( table, r, string( "parameters." ) + *tuned, *tuned );
+      if ( ! value.empty() && value != "_" ) {
+        flags.push_back( make_pair( string( *tuned ), value ) );
+      }
+    }
+    TrainingRun run;
+    run.instance = instance;
+    run.setting = ParameterSelector::settingName( flags );
+    run.runtime = atof( runtime.c_str() );
+    run.timed_out = cell( table, r, "status.timed_out", "TimedOut" ) == "1";
+    runs.push_back( run );
+  }
+
+  cerr << table.numberOfRows() << " rows from " << file_names.size()
+       << " files";
+  if ( bad_lines > 0 ) cerr << ", " << bad_lines << " malformed";
+  if ( unreadable_files > 0 ) cerr << ", " << unreadable_files << " unreadable";
+  cerr << endl;
+  if ( ! selector.train( features, runs ) ) {
+    cerr << "Unable to train: " << selector.errorMessage() << endl;
+    return EXIT_FAILURE;
+  }
+  if ( ! selector.write( model_file ) ) {
+    cerr << "Unable to write model: " << selector.errorMessage() << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "ModelFile\t" << model_file << endl;
+  cout << "Runs\t" << runs.size() - selector.unusedRuns() << endl;
+  cout << "RunsWithoutFeatures\t" << selector.unusedRuns() << endl;
+  cout << "FailedRuns\t" << failed_runs << endl;
+  cout << "Instances\t" << selector.numberOfInstances() << endl;
+  cout << "Features\t" << selector.numberOfFeatures() << endl;
+  cout << "Settings\t" << selector.numberOfSettings() << endl;
+  cout << "Neighbors\t" << selector.neighbors() << endl;
+  cout << "FallbackSetting\t" << selector.setting( selector.fallback() ) << endl;
+  size_t best_single = 0;
+  double best_single_mean, virtual_best_mean, selected_mean;
+  size_t complete = selector.evaluate( best_single, best_single_mean,
+                                       virtual_best_mean, selected_mean );
+  cout << "CompleteInstances\t" << complete << endl;
+  if ( complete > 0 ) {
+    cout << "BestSingleSetting\t" << selector.setting( best_single ) << endl;
+    cout << "BestSingleMean\t" << best_single_mean << endl;
+    cout << "VirtualBestMean\t" << virtual_best_mean << endl;
+    cout << "SelectedMean\t" << selected_mean << endl;
+  }
+  return bad_lines == 0 && unreadable_files == 0 ? 0 : EXIT_FAILURE;
+}
+
+//  [Last modified: 2026 10 17 at 23:20:45 GMT]